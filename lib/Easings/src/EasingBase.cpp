@@ -15,13 +15,11 @@
 
 EasingBase::EasingBase()
 {
-	_change = 0;
 	_type = EASE_IN;
 }
 
 EasingBase::EasingBase(easingType_t type_)
 {
-	_change = 0;
 	_type = type_;
 }
 
@@ -35,18 +33,18 @@ void EasingBase::setType(easingType_t type_)
 	_type = type_;
 }
 
-NUMBER EasingBase::ease(NUMBER time_) const
+NUMBER EasingBase::ease(NUMBER time_, NUMBER change_) const
 {
 	switch (_type)
 	{
 	case EASE_IN:
-		return easeIn(time_);
+		return easeIn(time_, change_);
 		break;
 	case EASE_OUT:
-		return easeOut(time_);
+		return easeOut(time_, change_);
 		break;
 	case EASE_IN_OUT:
-		return easeInOut(time_);
+		return easeInOut(time_, change_);
 		break;
 	default:
 		return 0;
@@ -54,22 +52,3 @@ NUMBER EasingBase::ease(NUMBER time_) const
 	}
 }
 
-
-/*
- * Set the duration
- */
-
-void EasingBase::setDuration(NUMBER duration_)
-{
-	_duration=duration_;
-}
-
-
-/*
- * Set the total change in position
- */
-
-void EasingBase::setTotalChangeInPosition(NUMBER totalChangeInPosition_)
-{
-	_change=totalChangeInPosition_;
-}
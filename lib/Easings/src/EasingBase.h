@@ -14,12 +14,16 @@
 
 
 // base class for easing functions
+//
+// Easings are evaluated as a pure function of the normalized time
+// (0 at the start, 1 at the end of the easing) and the total change
+// in position. An easing object does not hold any per animation state,
+// so one instance can be shared by any number of concurrent animations
+// with different durations and lengths.
 
 class EasingBase
 {
 protected:
-	NUMBER _change;
-	NUMBER _duration;
 	easingType_t _type;
 
 public:
@@ -35,17 +39,14 @@ public:
 	// single method to set the type for all easings
 	void setType(easingType_t type_);
 
-	// single method for all easings to execute
-	NUMBER ease(NUMBER time_) const;
+	// single method for all easings to execute, dispatches on the type.
+	// Easings with a type fixed at compile time override it (see StaticEase.h)
+	virtual NUMBER ease(NUMBER time_, NUMBER change_) const;
 
-	// easing API methods
-	virtual NUMBER easeIn(NUMBER time_) const=0;
-	virtual NUMBER easeOut(NUMBER time_) const=0;
-	virtual NUMBER easeInOut(NUMBER time_) const=0;
-
-	// common properties
-	void setDuration(NUMBER duration_);
-	void setTotalChangeInPosition(NUMBER totalChangeInPosition_);
+	// easing API methods, time_ is normalized to the range 0..1
+	virtual NUMBER easeIn(NUMBER time_, NUMBER change_) const=0;
+	virtual NUMBER easeOut(NUMBER time_, NUMBER change_) const=0;
+	virtual NUMBER easeInOut(NUMBER time_, NUMBER change_) const=0;
 };
 
 
@@ -11,7 +11,10 @@
 #ifndef __206D47C8_01CD_46c6_AF3F_A26DD28C189A
 #define __206D47C8_01CD_46c6_AF3F_A26DD28C189A
 
-// the number type used in this library
+// the number type used in this library. On the ESP32 double has no
+// hardware support and is computed in software. The result of ease()
+// is not rounded, callers that need an integer state truncate it
+// (see AnimatableObject::getState)
 
 typedef double NUMBER;
 enum easingType_t {EASE_IN, EASE_OUT, EASE_IN_OUT};
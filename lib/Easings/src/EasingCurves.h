@@ -0,0 +1,303 @@
+/*
+ * Easing Functions: Copyright (c) 2010 Andy Brown
+ * http://www.andybrown.me.uk
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution-ShareAlike 3.0 Unported License.
+ * http://creativecommons.org/licenses/by-sa/3.0/
+ */
+
+#ifndef __EASING_CURVES_H_
+#define __EASING_CURVES_H_
+
+#include "EasingMath.h"
+
+
+/*
+ * constexpr definitions of all easing curves for a normalized time
+ * (0..1) and a total change in position of 1. They follow the
+ * EasingBase implementations in easetypes/ exactly, Back and Elastic
+ * with their default overshoot, period and amplitude.
+ *
+ * Every curve provides in(), out() and inOut(), which makes it usable
+ * as template parameter, e.g. for the lookup tables of LUTEase.
+ */
+
+namespace EasingCurves
+{
+	struct Back
+	{
+		static constexpr NUMBER overshoot = 1.70158;
+
+		static constexpr NUMBER in(NUMBER time_)
+		{
+			return time_*time_*((overshoot+1)*time_-overshoot);
+		}
+
+		static constexpr NUMBER out(NUMBER time_)
+		{
+			time_-=1;
+			return time_*time_*((overshoot+1)*time_+overshoot)+1;
+		}
+
+		static constexpr NUMBER inOut(NUMBER time_)
+		{
+			NUMBER s=overshoot*1.525;
+			time_*=2;
+			if(time_<1)
+				return 0.5*(time_*time_*((s+1)*time_-s));
+			time_-=2;
+			return 0.5*(time_*time_*((s+1)*time_+s)+2);
+		}
+	};
+
+	struct Bounce
+	{
+		static constexpr NUMBER out(NUMBER time_)
+		{
+			if(time_<(1/2.75))
+				return 7.5625*time_*time_;
+			if(time_<(2/2.75))
+			{
+				time_-=1.5/2.75;
+				return 7.5625*time_*time_+0.75;
+			}
+			if(time_<(2.5/2.75))
+			{
+				time_-=2.25/2.75;
+				return 7.5625*time_*time_+0.9375;
+			}
+			time_-=2.625/2.75;
+			return 7.5625*time_*time_+0.984375;
+		}
+
+		static constexpr NUMBER in(NUMBER time_)
+		{
+			return 1-out(1-time_);
+		}
+
+		static constexpr NUMBER inOut(NUMBER time_)
+		{
+			if(time_<0.5)
+				return in(time_*2)*0.5;
+			return out(time_*2-1)*0.5+0.5;
+		}
+	};
+
+	struct Circular
+	{
+		static constexpr NUMBER in(NUMBER time_)
+		{
+			return -(EasingMath::sqrt(1-time_*time_)-1);
+		}
+
+		static constexpr NUMBER out(NUMBER time_)
+		{
+			time_-=1;
+			return EasingMath::sqrt(1-time_*time_);
+		}
+
+		static constexpr NUMBER inOut(NUMBER time_)
+		{
+			time_*=2;
+			if(time_<1)
+				return -0.5*(EasingMath::sqrt(1-time_*time_)-1);
+			time_-=2;
+			return 0.5*(EasingMath::sqrt(1-time_*time_)+1);
+		}
+	};
+
+	struct Cubic
+	{
+		static constexpr NUMBER in(NUMBER time_)
+		{
+			return time_*time_*time_;
+		}
+
+		static constexpr NUMBER out(NUMBER time_)
+		{
+			time_-=1;
+			return time_*time_*time_+1;
+		}
+
+		static constexpr NUMBER inOut(NUMBER time_)
+		{
+			time_*=2;
+			if(time_<1)
+				return 0.5*time_*time_*time_;
+			time_-=2;
+			return 0.5*(time_*time_*time_+2);
+		}
+	};
+
+	struct Elastic
+	{
+		static constexpr NUMBER period = 0.3;
+
+		static constexpr NUMBER in(NUMBER time_)
+		{
+			if(time_==0)
+				return 0;
+			if(time_==1)
+				return 1;
+			time_-=1;
+			return -(EasingMath::exp2(10*time_)*EasingMath::sin((time_-period/4)*(2*EasingMath::PI)/period));
+		}
+
+		static constexpr NUMBER out(NUMBER time_)
+		{
+			if(time_==0)
+				return 0;
+			if(time_==1)
+				return 1;
+			return EasingMath::exp2(-10*time_)*EasingMath::sin((time_-period/4)*(2*EasingMath::PI)/period)+1;
+		}
+
+		static constexpr NUMBER inOut(NUMBER time_)
+		{
+			NUMBER p=period*1.5;
+			if(time_==0)
+				return 0;
+			time_*=2;
+			if(time_==2)
+				return 1;
+			time_-=1;
+			if(time_<0)
+				return -0.5*(EasingMath::exp2(10*time_)*EasingMath::sin((time_-p/4)*(2*EasingMath::PI)/p));
+			return EasingMath::exp2(-10*time_)*EasingMath::sin((time_-p/4)*(2*EasingMath::PI)/p)*0.5+1;
+		}
+	};
+
+	struct Exponential
+	{
+		static constexpr NUMBER in(NUMBER time_)
+		{
+			return time_==0 ? 0 : EasingMath::exp2(10*(time_-1));
+		}
+
+		static constexpr NUMBER out(NUMBER time_)
+		{
+			return time_==1 ? 1 : -EasingMath::exp2(-10*time_)+1;
+		}
+
+		static constexpr NUMBER inOut(NUMBER time_)
+		{
+			if(time_==0)
+				return 0;
+			if(time_==1)
+				return 1;
+			time_*=2;
+			if(time_<1)
+				return 0.5*EasingMath::exp2(10*(time_-1));
+			time_-=1;
+			return 0.5*(-EasingMath::exp2(-10*time_)+2);
+		}
+	};
+
+	struct Linear
+	{
+		static constexpr NUMBER in(NUMBER time_)
+		{
+			return time_;
+		}
+
+		static constexpr NUMBER out(NUMBER time_)
+		{
+			return time_;
+		}
+
+		static constexpr NUMBER inOut(NUMBER time_)
+		{
+			return time_;
+		}
+	};
+
+	struct Quadratic
+	{
+		static constexpr NUMBER in(NUMBER time_)
+		{
+			return time_*time_;
+		}
+
+		static constexpr NUMBER out(NUMBER time_)
+		{
+			return -time_*(time_-2);
+		}
+
+		static constexpr NUMBER inOut(NUMBER time_)
+		{
+			time_*=2;
+			if(time_<1)
+				return 0.5*time_*time_;
+			time_-=1;
+			return -0.5*(time_*(time_-2)-1);
+		}
+	};
+
+	struct Quartic
+	{
+		static constexpr NUMBER in(NUMBER time_)
+		{
+			return time_*time_*time_*time_;
+		}
+
+		static constexpr NUMBER out(NUMBER time_)
+		{
+			time_-=1;
+			return -(time_*time_*time_*time_-1);
+		}
+
+		static constexpr NUMBER inOut(NUMBER time_)
+		{
+			time_*=2;
+			if(time_<1)
+				return 0.5*time_*time_*time_*time_;
+			time_-=2;
+			return -0.5*(time_*time_*time_*time_-2);
+		}
+	};
+
+	struct Quintic
+	{
+		static constexpr NUMBER in(NUMBER time_)
+		{
+			return time_*time_*time_*time_*time_;
+		}
+
+		static constexpr NUMBER out(NUMBER time_)
+		{
+			time_-=1;
+			return time_*time_*time_*time_*time_+1;
+		}
+
+		static constexpr NUMBER inOut(NUMBER time_)
+		{
+			time_*=2;
+			if(time_<1)
+				return 0.5*time_*time_*time_*time_*time_;
+			time_-=2;
+			return 0.5*(time_*time_*time_*time_*time_+2);
+		}
+	};
+
+	struct Sine
+	{
+		static constexpr NUMBER in(NUMBER time_)
+		{
+			return -EasingMath::cos(time_*EasingMath::PI/2)+1;
+		}
+
+		static constexpr NUMBER out(NUMBER time_)
+		{
+			return EasingMath::sin(time_*EasingMath::PI/2);
+		}
+
+		static constexpr NUMBER inOut(NUMBER time_)
+		{
+			return -0.5*(EasingMath::cos(EasingMath::PI*time_)-1);
+		}
+	};
+}
+
+
+#endif
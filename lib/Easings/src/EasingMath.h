@@ -0,0 +1,112 @@
+/*
+ * Easing Functions: Copyright (c) 2010 Andy Brown
+ * http://www.andybrown.me.uk
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution-ShareAlike 3.0 Unported License.
+ * http://creativecommons.org/licenses/by-sa/3.0/
+ */
+
+#ifndef __EASING_MATH_H_
+#define __EASING_MATH_H_
+
+#include "EasingConstants.h"
+
+
+/*
+ * constexpr replacements for the few math.h functions used by the
+ * easing curves. They allow the curves to be evaluated by the compiler,
+ * e.g. to generate lookup tables.
+ *
+ * GCC evaluates its math builtins at compile time and calls math.h at
+ * runtime, so the curves cost the same as the analytic classes. Other
+ * compilers use series expansions which are accurate to a few ulp over
+ * the ranges used by the curves but are slower at runtime.
+ */
+
+namespace EasingMath
+{
+	constexpr NUMBER PI = 3.14159265358979323846;
+	constexpr NUMBER LN2 = 0.69314718055994530942;
+
+#if defined(__GNUC__) && !defined(__clang__)
+
+	constexpr NUMBER exp2(NUMBER x_)
+	{
+		return __builtin_exp2(x_);
+	}
+
+	constexpr NUMBER sin(NUMBER x_)
+	{
+		return __builtin_sin(x_);
+	}
+
+	constexpr NUMBER cos(NUMBER x_)
+	{
+		return __builtin_cos(x_);
+	}
+
+	constexpr NUMBER sqrt(NUMBER x_)
+	{
+		return __builtin_sqrt(x_);
+	}
+
+#else
+
+	constexpr NUMBER floor(NUMBER x_)
+	{
+		long long i = (long long)x_;
+		return (NUMBER)i > x_ ? (NUMBER)(i - 1) : (NUMBER)i;
+	}
+
+	// 2^x_, split into an integer power and exp() of the fractional part
+	constexpr NUMBER exp2(NUMBER x_)
+	{
+		NUMBER n = floor(x_);
+		NUMBER f = (x_ - n) * LN2;
+		NUMBER term = 1, sum = 1;
+		for (int i = 1; i < 24; i++)
+		{
+			term *= f / i;
+			sum += term;
+		}
+		for (; n > 0; n--)
+			sum *= 2;
+		for (; n < 0; n++)
+			sum /= 2;
+		return sum;
+	}
+
+	constexpr NUMBER sin(NUMBER x_)
+	{
+		// reduce to -pi..pi
+		x_ -= 2 * PI * floor((x_ + PI) / (2 * PI));
+		NUMBER term = x_, sum = x_;
+		for (int i = 1; i < 16; i++)
+		{
+			term *= -x_ * x_ / ((2 * i) * (2 * i + 1));
+			sum += term;
+		}
+		return sum;
+	}
+
+	constexpr NUMBER cos(NUMBER x_)
+	{
+		return sin(x_ + PI / 2);
+	}
+
+	constexpr NUMBER sqrt(NUMBER x_)
+	{
+		if (x_ <= 0)
+			return 0;
+		NUMBER r = x_ > 1 ? x_ : 1;
+		for (int i = 0; i < 64; i++)
+			r = (r + x_ / r) / 2;
+		return r;
+	}
+
+#endif
+}
+
+
+#endif
@@ -0,0 +1,131 @@
+/*
+ * Easing Functions: Copyright (c) 2010 Andy Brown
+ * http://www.andybrown.me.uk
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution-ShareAlike 3.0 Unported License.
+ * http://creativecommons.org/licenses/by-sa/3.0/
+ */
+
+#ifndef __LUT_EASE_H_
+#define __LUT_EASE_H_
+
+#include <stdint.h>
+#include <array>
+#include "EasingBase.h"
+#include "EasingCurves.h"
+
+
+// number of entries of each lookup table, the first entry is the
+// start (time 0) and the last entry the end (time 1) of the easing
+#define EASING_LUT_SIZE		256
+
+// fixed point scale of the table entries (Q1.14), leaves room for
+// the over- and undershoot of the Back and Elastic curves
+#define EASING_LUT_SCALE	16384
+
+
+/*
+ * Builds the lookup table of a curve at compile time
+ */
+
+template<NUMBER (*curve_)(NUMBER)>
+constexpr std::array<int16_t, EASING_LUT_SIZE> buildEasingTable()
+{
+	std::array<int16_t, EASING_LUT_SIZE> table{};
+	for (int i = 0; i < EASING_LUT_SIZE; i++)
+	{
+		NUMBER value = curve_((NUMBER)i / (EASING_LUT_SIZE - 1)) * EASING_LUT_SCALE;
+		table[i] = (int16_t)(value < 0 ? value - 0.5 : value + 0.5);
+	}
+	return table;
+}
+
+
+/*
+ * Lookup tables of the three modes of a curve from EasingCurves
+ */
+
+template<class curve_>
+struct EasingTables
+{
+	static constexpr std::array<int16_t, EASING_LUT_SIZE> in = buildEasingTable<curve_::in>();
+	static constexpr std::array<int16_t, EASING_LUT_SIZE> out = buildEasingTable<curve_::out>();
+	static constexpr std::array<int16_t, EASING_LUT_SIZE> inOut = buildEasingTable<curve_::inOut>();
+
+	// linear interpolation between the two table entries around time_,
+	// times outside of 0..1 are clamped to the first and last entry
+	static NUMBER lookup(const std::array<int16_t, EASING_LUT_SIZE>& table_, NUMBER time_)
+	{
+		if(time_<=0)
+			return table_[0]*(1.0/EASING_LUT_SCALE);
+		if(time_>=1)
+			return table_[EASING_LUT_SIZE-1]*(1.0/EASING_LUT_SCALE);
+
+		// position in the table with 8 fractional bits
+		uint32_t position = (uint32_t)(time_*((EASING_LUT_SIZE-1)<<8));
+		uint32_t index = position>>8;
+		int32_t fraction = position&0xFF;
+		int32_t value = table_[index]*256+(table_[index+1]-table_[index])*fraction;
+		return value*(1.0/(EASING_LUT_SCALE*256.0));
+	}
+};
+
+
+/*
+ * Curves LUTEase is available for. The tables only pay off for the
+ * transcendental curves, the polynomial curves are as fast or faster
+ * analytic and Bounce and Circular lose up to 1.2 states of a digit
+ * transition at their kinks and tangents. See README.md for the
+ * measurements.
+ */
+
+template<class curve_>
+struct LUTEaseSupported
+{
+	static constexpr bool value = false;
+};
+
+template<> struct LUTEaseSupported<EasingCurves::Elastic> { static constexpr bool value = true; };
+template<> struct LUTEaseSupported<EasingCurves::Exponential> { static constexpr bool value = true; };
+template<> struct LUTEaseSupported<EasingCurves::Sine> { static constexpr bool value = true; };
+
+
+/*
+ * Table driven easing. Evaluates the curve from a 256 entry fixed point
+ * table with linear interpolation instead of the analytic function,
+ * which avoids the transcendental math on every frame.
+ * The tables are generated at compile time and live in flash.
+ *
+ * Usage: LUTEase<EasingCurves::Sine> sine(EASE_OUT);
+ *
+ * Elastic tables use the default period and amplitude. Only available
+ * for the curves of LUTEaseSupported, use STATIC_EASING() for the others.
+ */
+
+template<class curve_>
+class LUTEase : public EasingBase
+{
+	static_assert(LUTEaseSupported<curve_>::value, "the analytic curve is faster or more accurate, use STATIC_EASING()");
+
+public:
+	using EasingBase::EasingBase; // inherit base class constructors
+
+	virtual NUMBER easeIn(NUMBER time_, NUMBER change_) const
+	{
+		return change_*EasingTables<curve_>::lookup(EasingTables<curve_>::in, time_);
+	}
+
+	virtual NUMBER easeOut(NUMBER time_, NUMBER change_) const
+	{
+		return change_*EasingTables<curve_>::lookup(EasingTables<curve_>::out, time_);
+	}
+
+	virtual NUMBER easeInOut(NUMBER time_, NUMBER change_) const
+	{
+		return change_*EasingTables<curve_>::lookup(EasingTables<curve_>::inOut, time_);
+	}
+};
+
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * Easing Functions: Copyright (c) 2010 Andy Brown
+ * http://www.andybrown.me.uk
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution-ShareAlike 3.0 Unported License.
+ * http://creativecommons.org/licenses/by-sa/3.0/
+ */
+
+#ifndef __STATIC_EASE_H_
+#define __STATIC_EASE_H_
+
+#include "EasingBase.h"
+#include "EasingCurves.h"
+
+
+/*
+ * Compile time easing API. The curve (from EasingCurves) and the type
+ * are template parameters, so the compiler can inline the whole curve
+ * into the caller, e.g.
+ *
+ *   NUMBER state = Easing<EasingCurves::Cubic, EASE_IN_OUT>::ease(time, 54);
+ */
+
+template<class curve_, easingType_t type_>
+struct Easing
+{
+	static constexpr NUMBER ease(NUMBER time_, NUMBER change_)
+	{
+		return change_*(type_==EASE_IN ? curve_::in(time_) :
+		                type_==EASE_OUT ? curve_::out(time_) :
+		                                  curve_::inOut(time_));
+	}
+};
+
+
+/*
+ * EasingBase adapter for a curve with a type selected at runtime.
+ * The easing classes without parameters (CubicEase, BounceEase, ...)
+ * are implemented with it.
+ */
+
+template<class curve_>
+class CurveEase : public EasingBase
+{
+public:
+	using EasingBase::EasingBase; // inherit base class constructors
+
+	virtual NUMBER easeIn(NUMBER time_, NUMBER change_) const
+	{
+		return Easing<curve_, EASE_IN>::ease(time_, change_);
+	}
+
+	virtual NUMBER easeOut(NUMBER time_, NUMBER change_) const
+	{
+		return Easing<curve_, EASE_OUT>::ease(time_, change_);
+	}
+
+	virtual NUMBER easeInOut(NUMBER time_, NUMBER change_) const
+	{
+		return Easing<curve_, EASE_IN_OUT>::ease(time_, change_);
+	}
+};
+
+
+/*
+ * EasingBase adapter for a curve and a type that are both fixed at
+ * compile time. ease() skips the type switch and evaluates the inlined
+ * curve directly, which leaves a single virtual call per evaluation.
+ *
+ * There is one shared instance per curve and type, use the
+ * STATIC_EASING macro to name it, e.g. STATIC_EASING(Bounce, EASE_OUT).
+ * setType() has no effect on ease() of these instances.
+ */
+
+template<class curve_, easingType_t type_>
+class StaticEase : public CurveEase<curve_>
+{
+public:
+	static StaticEase instance;
+
+	StaticEase() : CurveEase<curve_>(type_) {}
+
+	virtual NUMBER ease(NUMBER time_, NUMBER change_) const
+	{
+		return Easing<curve_, type_>::ease(time_, change_);
+	}
+};
+
+template<class curve_, easingType_t type_>
+StaticEase<curve_, type_> StaticEase<curve_, type_>::instance;
+
+#define STATIC_EASING(CURVE, TYPE)	(&StaticEase<EasingCurves::CURVE, TYPE>::instance)
+
+
+#endif
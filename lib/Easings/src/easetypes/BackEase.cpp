@@ -40,10 +40,9 @@ void BackEase::setOvershoot(NUMBER overshoot_)
  * Ease in
  */
 
-NUMBER BackEase::easeIn(NUMBER time_) const
+NUMBER BackEase::easeIn(NUMBER time_, NUMBER change_) const
 {
-	time_/=_duration;
-	return _change*time_*time_*((_overshoot+1)*time_-_overshoot);
+	return change_*time_*time_*((_overshoot+1)*time_-_overshoot);
 }
 
 
@@ -51,10 +50,10 @@ NUMBER BackEase::easeIn(NUMBER time_) const
  * Ease out
  */
 
-NUMBER BackEase::easeOut(NUMBER time_) const
+NUMBER BackEase::easeOut(NUMBER time_, NUMBER change_) const
 {
-	time_=time_/_duration-1;
-	return _change*(time_*time_*((_overshoot+1)*time_+_overshoot)+1);
+	time_-=1;
+	return change_*(time_*time_*((_overshoot+1)*time_+_overshoot)+1);
 }
 
 
@@ -62,16 +61,16 @@ NUMBER BackEase::easeOut(NUMBER time_) const
  * Ease in and out
  */
 
-NUMBER BackEase::easeInOut(NUMBER time_) const
+NUMBER BackEase::easeInOut(NUMBER time_, NUMBER change_) const
 {
 	NUMBER overshoot;
 
 	overshoot=_overshoot*1.525;
-	time_/=_duration/2;
+	time_*=2;
 
 	if(time_<1)
-		return _change/2*(time_*time_*((overshoot+1)*time_-overshoot));
+		return change_/2*(time_*time_*((overshoot+1)*time_-overshoot));
 
 	time_-=2;
-	return _change/2*(time_*time_*((overshoot+1)*time_+overshoot)+2);
+	return change_/2*(time_*time_*((overshoot+1)*time_+overshoot)+2);
 }
@@ -30,17 +30,17 @@ public:
 
 	// Starts the motion by backtracking, then reversing
 	// direction and moving toward the target
-	virtual NUMBER easeIn(NUMBER time_) const;
+	virtual NUMBER easeIn(NUMBER time_, NUMBER change_) const;
 
 	// Starts the motion by moving towards the target, overshooting
 	// it slightly, and then reversing direction back toward the target
-	virtual NUMBER easeOut(NUMBER time_) const;
+	virtual NUMBER easeOut(NUMBER time_, NUMBER change_) const;
 
 	// Combines the motion of the easeIn and easeOut methods to
 	// start the motion by backtracking, then reversing direction
 	// and moving toward target, overshooting target slightly,
 	// reversing direction again, and then moving back toward the target
-	virtual NUMBER easeInOut(NUMBER time_) const;
+	virtual NUMBER easeInOut(NUMBER time_, NUMBER change_) const;
 
 	// set the overshoot value. The higher the value the
 	// greater the overshoot.
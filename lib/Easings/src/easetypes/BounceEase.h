@@ -10,29 +10,17 @@
 #ifndef __C39EDBEE_E658_41f3_B5A5_7ABE5F798138
 #define __C39EDBEE_E658_41f3_B5A5_7ABE5F798138
 
-#include "EasingBase.h"
+#include "StaticEase.h"
 
 
 /*
  * Bouncing easing function
  */
 
-class BounceEase : public EasingBase
+class BounceEase : public CurveEase<EasingCurves::Bounce>
 {
 public:
-	using EasingBase::EasingBase; // inherit base class constructors
-	// starts the bounce motion slowly,
-  // then accelerates motion as it executes
-	virtual NUMBER easeIn(NUMBER time_) const;
-
-	// starts the bounce motion fast,
-  // and then decelerates motion as it executes.
-	virtual NUMBER easeOut(NUMBER time_) const;
-
-	// combines the motion of the easeIn and easeOut
-	// methods to start the bounce motion slowly,
-	// accelerate motion, then decelerate.
-	virtual NUMBER easeInOut(NUMBER time_) const;
+	using CurveEase::CurveEase; // inherit base class constructors, the curve is defined in EasingCurves.h
 };
 
 
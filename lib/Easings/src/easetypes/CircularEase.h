@@ -10,29 +10,17 @@
 #ifndef __E3C2602E_AF87_4ca3_9E5B_2F822F390F32
 #define __E3C2602E_AF87_4ca3_9E5B_2F822F390F32
 
-#include "EasingBase.h"
+#include "StaticEase.h"
 
 
 /*
  * Circular easing
  */
 
-class CircularEase : public EasingBase
+class CircularEase : public CurveEase<EasingCurves::Circular>
 {
 public:
-	using EasingBase::EasingBase; // inherit base class constructors
-	// starts motion slowly, and then accelerates
-	// motion as it executes
-	virtual NUMBER easeIn(NUMBER time_) const;
-
-	// starts motion fast, and then decelerates
-	// motion as it executes.
-	virtual NUMBER easeOut(NUMBER time_) const;
-
-	// combines the motion of the easeIn and easeOut
-	// methods to start the motion slowly, accelerate
-	// motion, then decelerate.
-	virtual NUMBER easeInOut(NUMBER time_) const;
+	using CurveEase::CurveEase; // inherit base class constructors, the curve is defined in EasingCurves.h
 };
 
 
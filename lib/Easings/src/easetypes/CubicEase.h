@@ -10,7 +10,7 @@
 #ifndef __1DAE42F8_8F0C_4c42_8F9A_A316F82AB0FA
 #define __1DAE42F8_8F0C_4c42_8F9A_A316F82AB0FA
 
-#include "EasingBase.h"
+#include "StaticEase.h"
 
 
 /*
@@ -18,23 +18,10 @@
  *  equation is greater than for a Quad easing equation.
  */
 
-class CubicEase : public EasingBase
+class CubicEase : public CurveEase<EasingCurves::Cubic>
 {
 public:
-	using EasingBase::EasingBase; // inherit base class constructors
-	// Starts the motion by backtracking, then reversing
-	// direction and moving toward the target
-	virtual NUMBER easeIn(NUMBER time_) const;
-
-	// Starts the motion by moving towards the target, overshooting
-	// it slightly, and then reversing direction back toward the target
-	virtual NUMBER easeOut(NUMBER time_) const;
-
-	// Combines the motion of the easeIn and easeOut methods to
-	// start the motion by backtracking, then reversing direction
-	// and moving toward target, overshooting target slightly,
-	// reversing direction again, and then moving back toward the target
-	virtual NUMBER easeInOut(NUMBER time_) const;
+	using CurveEase::CurveEase; // inherit base class constructors, the curve is defined in EasingCurves.h
 };
 
 
@@ -35,34 +35,32 @@ ElasticEase::ElasticEase(easingType_t type_, NUMBER period_, NUMBER amplitude_)
  * Ease in
  */
 
-NUMBER ElasticEase::easeIn(NUMBER time_) const
+NUMBER ElasticEase::easeIn(NUMBER time_, NUMBER change_) const
 {
 	NUMBER p,a,s;
 
 	if(time_==0)
 		return 0;
 
-	time_/=_duration;
-
 	if(time_==1)
-		return _change;
+		return change_;
 
 	if(_period==0)
-		p=_duration*0.3;
+		p=0.3;
 	else
 		p=_period;
 
 	a=_amplitude;
-	if(a==0 || a<fabs(_change))
+	if(a==0 || a<fabs(change_))
 	{
-		a=_change;
+		a=change_;
 	  s=p/4;
 	}
 	else
-		s=p/(2*M_PI)*asin(_change/a);
+		s=p/(2*M_PI)*asin(change_/a);
 
 	time_-=1;
-	return -(a*pow(2,10*time_)*sin((time_*_duration-s)*(2*M_PI)/p));
+	return -(a*pow(2,10*time_)*sin((time_-s)*(2*M_PI)/p));
 }
 
 
@@ -70,32 +68,31 @@ NUMBER ElasticEase::easeIn(NUMBER time_) const
  * Ease out
  */
 
-NUMBER ElasticEase::easeOut(NUMBER time_) const
+NUMBER ElasticEase::easeOut(NUMBER time_, NUMBER change_) const
 {
 	NUMBER p,a,s;
 
 	if(time_==0)
 		return 0;
 
-	time_/=_duration;
 	if(time_==1)
-		return _change;
+		return change_;
 
 	if(_period==0)
-		p=_duration*0.3;
+		p=0.3;
 	else
 		p=_period;
 
 	a=_amplitude;
-	if(a==0 || a<fabs(_change))
+	if(a==0 || a<fabs(change_))
 	{
-		a=_change;
+		a=change_;
 		s=p/4;
 	}
 	else
-		s=p/(2*M_PI)*asin(_change/a);
+		s=p/(2*M_PI)*asin(change_/a);
 
-  return a*pow(2,-10*time_)*sin((time_*_duration-s)*(2*M_PI)/p)+_change;
+  return a*pow(2,-10*time_)*sin((time_-s)*(2*M_PI)/p)+change_;
 }
 
 
@@ -103,39 +100,39 @@ NUMBER ElasticEase::easeOut(NUMBER time_) const
  * Ease in/out
  */
 
-NUMBER ElasticEase::easeInOut(NUMBER time_) const
+NUMBER ElasticEase::easeInOut(NUMBER time_, NUMBER change_) const
 {
 	NUMBER p,a,s;
 
 	if(time_==0)
 		return 0;
 
-	time_/=_duration/2;
+	time_*=2;
 	if (time_==2)
-		return _change;
+		return change_;
 
 	if(_period==0)
-		p=_duration*(0.3*1.5);
+		p=0.3*1.5;
 	else
 		p=_period;
 
 	a=_amplitude;
-	if(a==0 || a<fabs(_change))
+	if(a==0 || a<fabs(change_))
 	{
-		a=_change;
+		a=change_;
 	  s=p/4;
 	}
 	else
-		s=p/(2*M_PI)*asin(_change/a);
+		s=p/(2*M_PI)*asin(change_/a);
 
   if(time_<1)
   {
   	time_-=1;
-	  return -0.5*(a*pow(2,10*time_)*sin((time_*_duration-s)*(2*M_PI)/p));
+	  return -0.5*(a*pow(2,10*time_)*sin((time_-s)*(2*M_PI)/p));
 	}
 
   time_-=1;
-	return a*pow(2,-10*time_)*sin((time_*_duration-s)*(2*M_PI)/p)*0.5+_change;
+	return a*pow(2,-10*time_)*sin((time_-s)*(2*M_PI)/p)*0.5+change_;
 }
 
 
@@ -30,16 +30,17 @@ public:
 	ElasticEase(easingType_t type_, NUMBER period_, NUMBER amplitude_);
 
 	// Starts motion slowly, and then accelerates motion as it executes.
-	virtual NUMBER easeIn(NUMBER time_) const;
+	virtual NUMBER easeIn(NUMBER time_, NUMBER change_) const;
 
 	// Starts motion fast, and then decelerates motion as it executes
-	virtual NUMBER easeOut(NUMBER time_) const;
+	virtual NUMBER easeOut(NUMBER time_, NUMBER change_) const;
 
 	// combines the motion of the easeIn and easeOut methods
 	// to start the motion slowly, accelerate motion, then decelerate
-	virtual NUMBER easeInOut(NUMBER time_) const;
+	virtual NUMBER easeInOut(NUMBER time_, NUMBER change_) const;
 
-	// set the period
+	// set the period as a fraction of the duration of the easing,
+	// zero selects the default of 0.3
 	void setPeriod(NUMBER period_);
 
 	// set the amplitude
@@ -10,26 +10,17 @@
 #ifndef __EB8DFB1F_5506_4a49_BD8E_B0A1E0C82891
 #define __EB8DFB1F_5506_4a49_BD8E_B0A1E0C82891
 
-#include "EasingBase.h"
+#include "StaticEase.h"
 
 
 /*
  *  the motion is defined by an exponentially decaying sine wave
  */
 
-class ExponentialEase : public EasingBase
+class ExponentialEase : public CurveEase<EasingCurves::Exponential>
 {
 public:
-	using EasingBase::EasingBase; // inherit base class constructors
-	//starts motion slowly, and then accelerates motion as it executes
-	virtual NUMBER easeIn(NUMBER time_) const;
-
-	// starts motion fast, and then decelerates motion as it executes
-	virtual NUMBER easeOut(NUMBER time_) const;
-
-	//combines the motion of the easeIn and easeOut methods to start the
-	// motion slowly, accelerate motion, then decelerate
-	virtual NUMBER easeInOut(NUMBER time_) const;
+	using CurveEase::CurveEase; // inherit base class constructors, the curve is defined in EasingCurves.h
 };
 
 
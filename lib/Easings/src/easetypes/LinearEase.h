@@ -10,25 +10,17 @@
 #ifndef __76A3B25E_C909_4183_B13C_72AACD322E69
 #define __76A3B25E_C909_4183_B13C_72AACD322E69
 
-#include "EasingBase.h"
+#include "StaticEase.h"
 
 
 /*
  * Linear ease
  */
 
-class LinearEase : public EasingBase
+class LinearEase : public CurveEase<EasingCurves::Linear>
 {
 public:
-	using EasingBase::EasingBase; // inherit base class constructors
-	// no acceleration
-	virtual NUMBER easeIn(NUMBER time_) const;
-
-	// no acceleration
-	virtual NUMBER easeOut(NUMBER time_) const;
-
-	// no acceleration
-	virtual NUMBER easeInOut(NUMBER time_) const;
+	using CurveEase::CurveEase; // inherit base class constructors, the curve is defined in EasingCurves.h
 };
 
 
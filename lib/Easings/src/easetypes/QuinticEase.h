@@ -10,7 +10,7 @@
 #ifndef __1FD00959_9CE3_4d54_B7B3_DE9B1FE8B816
 #define __1FD00959_9CE3_4d54_B7B3_DE9B1FE8B816
 
-#include "EasingBase.h"
+#include "StaticEase.h"
 
 
 /*
@@ -18,22 +18,10 @@
  * equation is greater than for a Quad, Cubic,
  * or Quart easing equation. */
 
-class QuinticEase : public EasingBase
+class QuinticEase : public CurveEase<EasingCurves::Quintic>
 {
 public:
-	using EasingBase::EasingBase; // inherit base class constructors
-	// starts motion from a zero velocity, and then accelerates
-	// motion as it executes.
-	virtual NUMBER easeIn(NUMBER time_) const;
-
-	// starts motion fast, and then decelerates motion to
-	// a zero velocity as it executes
-	virtual NUMBER easeOut(NUMBER time_) const;
-
-	// Combines the motion of the easeIn and easeOut methods to
-	// to start the motion from a zero velocity, accelerate motion,
-	// then decelerate to a zero velocity
-	virtual NUMBER easeInOut(NUMBER time_) const;
+	using CurveEase::CurveEase; // inherit base class constructors, the curve is defined in EasingCurves.h
 };
 
 
@@ -10,29 +10,17 @@
 #ifndef __710BAE70_D63D_48ab_98F4_8421836D9DE5
 #define __710BAE70_D63D_48ab_98F4_8421836D9DE5
 
-#include "EasingBase.h"
+#include "StaticEase.h"
 
 
 /*
  * the motion is defined by a sine wave.
  */
 
-class SineEase : public EasingBase
+class SineEase : public CurveEase<EasingCurves::Sine>
 {
 public:
-	using EasingBase::EasingBase; // inherit base class constructors
-	// starts motion from a zero velocity, and then accelerates
-	// motion as it executes.
-	virtual NUMBER easeIn(NUMBER time_) const;
-
-	// starts motion fast, and then decelerates motion to
-	// a zero velocity as it executes
-	virtual NUMBER easeOut(NUMBER time_) const;
-
-	// Combines the motion of the easeIn and easeOut methods to
-	// to start the motion from a zero velocity, accelerate motion,
-	// then decelerate to a zero velocity
-	virtual NUMBER easeInOut(NUMBER time_) const;
+	using CurveEase::CurveEase; // inherit base class constructors, the curve is defined in EasingCurves.h
 };
 
 
@@ -22,4 +22,10 @@
 #include "easetypes/QuinticEase.h"
 #include "easetypes/SineEase.h"
 
+// easings with the curve and type fixed at compile time
+#include "StaticEase.h"
+
+// table driven easings generated at compile time
+#include "LUTEase.h"
+
 #endif
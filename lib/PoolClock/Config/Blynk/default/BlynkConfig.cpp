@@ -196,8 +196,8 @@
      */
 	BLYNK_WRITE(BLYNK_CHANNEL_BRIGHTNESS_SLIDER)
 	{
-		ClockS->clockBrightness = param[0].asInt();
-		BlynkC->PoolClockDisplays->setGlobalBrightness(ClockS->clockBrightness);
+		ClockS->_clockBrightness = param[0].asInt();
+		ClockS->postEvent(EVENT_SETTINGS_CHANGED);
 	}
 
     /**
@@ -257,30 +257,34 @@
 		currentColor.r  = param[0].asInt();
 		currentColor.g  = param[1].asInt();
 		currentColor.b  = param[2].asInt();
+		//all selected light groups change together in one scheme
+		ColorScheme scheme = BlynkC->PoolClockDisplays->getColorScheme();
 		if(BlynkC->ColorSelection & BlynkConfig::CHANGE_HOURS_COLOR)
 		{
-			BlynkC->PoolClockDisplays->setHourSegmentColors(currentColor);
+			scheme.hour = currentColor;
 			Blynk.virtualWrite(BLYNK_CHANNEL_HOUR_COLOR_SAVE, currentColor.r, currentColor.g, currentColor.b);
 			BlynkC->HourColor = currentColor;
 		}
 		if(BlynkC->ColorSelection & BlynkConfig::CHANGE_MINUTES_COLOR)
 		{
-			BlynkC->PoolClockDisplays->setMinuteSegmentColors(currentColor);
+			scheme.minute = currentColor;
 			Blynk.virtualWrite(BLYNK_CHANNEL_MINUTE_COLOR_SAVE, currentColor.r, currentColor.g, currentColor.b);
 			BlynkC->MinuteColor = currentColor;
 		}
 		if(BlynkC->ColorSelection & BlynkConfig::CHANGE_INTERIOR_COLOR)
 		{
-			BlynkC->PoolClockDisplays->setInternalLEDColor(currentColor);
+			scheme.internal = currentColor;
 			Blynk.virtualWrite(BLYNK_CHANNEL_INTERNAL_COLOR_SAVE, currentColor.r, currentColor.g, currentColor.b);
 			BlynkC->InternalColor = currentColor;
 		}
 		if(BlynkC->ColorSelection & BlynkConfig::CHANGE_DOT_COLOR)
 		{
-			BlynkC->PoolClockDisplays->setDotLEDColor(currentColor);
+			scheme.dot = currentColor;
 			Blynk.virtualWrite(BLYNK_CHANNEL_DOT_COLOR_SAVE, currentColor.r, currentColor.g, currentColor.b);
 			BlynkC->DotColor = currentColor;
 		}
+		BlynkC->PoolClockDisplays->setColorScheme(scheme, COLOR_CHANGE_CROSSFADE);
+		ClockS->postEvent(EVENT_SETTINGS_CHANGED);
 	}
 
     /**
@@ -368,15 +372,14 @@
 		{
 			TimeM->startTimer();
 			Serial.println("Timer Started");
-            ClockS->switchMode(ClockState::TIMER_MODE);
+            ClockS->postEvent(EVENT_TIMER_STARTED);
 		}
 		else
 		{
 			TimeM->stopTimer();
 			Serial.println("Timer Stopped");
 			Blynk.syncVirtual(BLYNK_CHANNEL_TIMER_TIME_INPUT);
-			BlynkC->PoolClockDisplays->setGlobalBrightness(ClockS->clockBrightness);
-            ClockS->switchMode(ClockState::CLOCK_MODE);
+            ClockS->postEvent(EVENT_TIMER_STOPPED);
 		}
 	}
 
@@ -387,12 +390,13 @@
 	BLYNK_WRITE(BLYNK_CHANNEL_NIGHT_MODE_TIME_INPUT)
 	{
 		TimeInputParam t(param);
-		ClockS->NightModeStartTime.hours = t.getStartHour();
-		ClockS->NightModeStartTime.minutes = t.getStartMinute();
-		ClockS->NightModeStartTime.seconds = t.getStartSecond();
-		ClockS->NightModeStopTime.hours = t.getStopHour();
-		ClockS->NightModeStopTime.minutes = t.getStopMinute();
-		ClockS->NightModeStopTime.seconds = t.getStopSecond();
+		ClockS->_NightModeStartTime.hours = t.getStartHour();
+		ClockS->_NightModeStartTime.minutes = t.getStartMinute();
+		ClockS->_NightModeStartTime.seconds = t.getStartSecond();
+		ClockS->_NightModeStopTime.hours = t.getStopHour();
+		ClockS->_NightModeStopTime.minutes = t.getStopMinute();
+		ClockS->_NightModeStopTime.seconds = t.getStopSecond();
+		ClockS->postEvent(EVENT_SETTINGS_CHANGED);
 	}
 
     /**
@@ -401,11 +405,8 @@
      */
 	BLYNK_WRITE(BLYNK_CHANNEL_NIGHT_MODE_BRIGHTNESS)
 	{
-		ClockS->nightModeBrightness = param[0].asInt();
-		if(TimeM->isInBetween(ClockS->NightModeStartTime, ClockS->NightModeStopTime))
-		{
-			BlynkC->PoolClockDisplays->setGlobalBrightness(ClockS->nightModeBrightness);
-		}
+		ClockS->_nightModeBrightness = param[0].asInt();
+		ClockS->postEvent(EVENT_SETTINGS_CHANGED);
 	}
 
     /**
@@ -414,7 +415,8 @@
      */
 	BLYNK_WRITE(BLYNK_CHANNEL_NUM_SEPARATION_DOTS)
 	{
-		ClockS->numDots = param[0].asInt() - 1;
+		ClockS->_numDots = param[0].asInt() - 1;
+		ClockS->postEvent(EVENT_SETTINGS_CHANGED);
 	}
 
     /**
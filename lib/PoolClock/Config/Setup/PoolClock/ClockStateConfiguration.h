@@ -32,9 +32,94 @@
 #define NOTIFICATION_BRIGHTNESS 125
 
 /**
- * \brief How often the time is checked and the displays are updated
+ * \brief How often the clock blinks while an alarm or timer notification is shown
  */
-#define TIME_UPDATE_INTERVAL	250 // milliseconds
+#define NOTIFICATION_FLASH_INTERVAL	250 // milliseconds
+
+/**
+ * \brief Number of events (second ticks, sensor updates, buttons, app commands) the ClockState can queue
+ *        until the main loop processes them
+ */
+#define CLOCK_STATE_EVENT_QUEUE_SIZE 16
+
+/**
+ * \brief Number of button presses that can wait for the main loop, must be a power of two
+ */
+#define BUTTON_EVENT_RING_SIZE 16
+
+/**
+ * \brief Auto-repeat of the held PLUS and MINUS buttons while the timer is set. After the long press the button
+ *        repeats slowly, then fast. The steps grow with the repeats: the minutes jump to the next multiple of 5,
+ *        then of 10. The hours always move by one.
+ */
+#define AUTO_REPEAT_SLOW_INTERVAL 400 // milliseconds
+#define AUTO_REPEAT_SLOW_COUNT      4 // repeats at the slow interval
+#define AUTO_REPEAT_FAST_INTERVAL 150 // milliseconds
+#define AUTO_REPEAT_STEP5_AFTER    12 // repeats until the minutes move by 5
+#define AUTO_REPEAT_STEP10_AFTER   20 // repeats until the minutes move by 10
+
+/**
+ * \brief While the timer is set the changes are coalesced: the digits show the latest value once their previous
+ *        morph is over instead of queuing a morph per change, the LCD is written at most that often
+ */
+#define SET_TIMER_DIGITS_REFRESH_INTERVAL DIGIT_ANIMATION_SPEED // milliseconds
+#define SET_TIMER_LCD_REFRESH_INTERVAL    100 // milliseconds
+
+/**
+ * \brief How often the loop task on core 0 is woken up to check whether a new sensor measurement is due
+ */
+#define SENSOR_CHECK_INTERVAL 1000 // milliseconds
+
+/**
+ * \brief Resolution of the scheduler running the periodic work of the ClockState (night mode, dots, sensors)
+ */
+#define SCHEDULER_TICK 10 // milliseconds
+
+/**
+ * \brief Keep the state of the clock (mode, timer, alarm, brightness) in the RTC memory. After a software reset,
+ *        a watchdog, a brownout or an OTA update the clock resumes it within a fraction of a second and does the
+ *        slow part of the setup (WIFI, NTP, sensors) in the background, see #WarmRestart
+ */
+#define WARM_RESTART true
+
+#if WARM_RESTART == true
+
+	/**
+	 * \brief How often the state is saved in the RTC memory
+	 */
+	#define WARM_RESTART_SNAPSHOT_INTERVAL 1000 // milliseconds
+
+	/**
+	 * \brief An older snapshot is not resumed, the clock boots normally
+	 */
+	#define WARM_RESTART_MAX_AGE 60 // seconds
+
+	/**
+	 * \brief Number of warm restarts in a row after which the clock boots normally, in case the resumed state
+	 *        itself makes it crash. The count is reset once the clock ran for #WARM_RESTART_STABLE_TIME.
+	 */
+	#define WARM_RESTART_MAX_ATTEMPTS 3
+	#define WARM_RESTART_STABLE_TIME 60000 // milliseconds
+
+#endif
+
+/**
+ * \brief Keep the settings (colors, brightness, night mode window, separation dots, default timer) in the NVS flash
+ *        over a power cycle. They are read once at boot, the changes are written back once they stopped for
+ *        #SETTINGS_SAVE_DELAY, see #SettingsStore
+ */
+#define PERSISTENT_SETTINGS true
+
+#if PERSISTENT_SETTINGS == true
+
+	/**
+	 * \brief Quiet time after the last change before the settings are written, a slider moved in the app only
+	 *        causes one write. Changes which never stop are written after #SETTINGS_SAVE_MAX_DELAY at the latest.
+	 */
+	#define SETTINGS_SAVE_DELAY 5000 // milliseconds
+	#define SETTINGS_SAVE_MAX_DELAY 60000 // milliseconds
+
+#endif
 
 /**
  * \brief Default brightness of the display. If you are using blynk you may ignore this setting.
@@ -74,6 +159,12 @@
 	 */
 	#define DEFAULT_NIGHT_MODE_BRIGHTNESS 64
 
+	/**
+	 * \brief The night mode is checked at its start and end time, and at least that often in case the time was
+	 *        corrected by the NTP synchronization
+	 */
+	#define NIGHT_MODE_RECHECK_INTERVAL 3600000 // milliseconds
+
 #endif
 
 #endif
\ No newline at end of file
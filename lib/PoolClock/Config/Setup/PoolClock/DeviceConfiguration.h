@@ -22,7 +22,38 @@
 	 * \brief ADC pin to which the PIR sensor is connected to
 	 */
 	#define PIR_SENSOR_PIN			5
+	/**
+	 * \brief Time in ms a motion is considered present after the PIR sensor went low
+	 */
 	#define PIR_SENSOR_DELAY        5000ul //5*60*1000ul
+
+	/**
+	 * \brief Save power while nobody is at the pool: the LEDs fade out, the animator and the LCD backlight stop,
+	 *        the sensors are read less often and the CPU runs slower. The next motion wakes the clock up.
+	 */
+	#define PIR_IDLE_MODE           true
+
+	#if PIR_IDLE_MODE == true
+		/**
+		 * \brief Time in minutes without any motion or button press after which the clock enters the idle mode
+		 */
+		#define PIR_IDLE_DELAY              10
+		/**
+		 * \brief CPU frequency in MHz during the idle mode. 80 is the lowest frequency that keeps the WiFi and the
+		 *        APB clock of the LED driver (RMT) unchanged.
+		 */
+		#define IDLE_CPU_FREQUENCY          80
+		/**
+		 * \brief Interval in ms between two temperature measurements during the idle mode
+		 */
+		#define IDLE_SENSOR_INTERVAL        600000ul
+		/**
+		 * \brief Estimated power in mW saved by the lower CPU frequency and by the LCD backlight, only used for the
+		 *        energy statistic. The power of the LEDs is computed from the last frame shown.
+		 */
+		#define IDLE_CPU_POWER_SAVING       60
+		#define IDLE_LCD_BACKLIGHT_POWER    100
+	#endif
 #endif
 
 /***************************
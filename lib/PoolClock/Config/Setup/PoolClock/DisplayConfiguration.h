@@ -37,6 +37,11 @@
  */
 #define SEPARATION_DOT_COLOR				CRGB::Blue
 
+/**
+ * \brief Time in ms of the crossfade to the new colors when a color is changed in the blynk app, 0 to switch immediately
+ */
+#define COLOR_CHANGE_CROSSFADE				500
+
 /**
  * \brief Color of the LEDs for the OTA update progress bar
  */
@@ -74,6 +79,12 @@
  */
 #define LED_DATA_PIN				18
 
+/**
+ * \brief Number of independently wired LED strips the segments are split into. Every strip gets its own data pin
+ * 		  and all strips are transmitted in parallel. The strips are defined in \ref DisplayLayoutConfiguration.h
+ */
+#define NUM_LED_STRIPS				1
+
 /**
  * \brief Total number of segments that have LEDs in the shelf
  */
@@ -120,7 +131,7 @@
 
 /**
  * \brief These enum definitions are used in the code do address the different Seven segment displays.
- * 		  The numbers have to match with the place of the display in the #DisplayManager::SegmentDisplayModes array in the file \ref DisplayConfiguration.cpp
+ * 		  The numbers have to match with the place of the display in the #DisplayLayout::Displays array in the file \ref DisplayLayoutConfiguration.h
  */
 enum DisplayIDs {
 	HIGHER_DIGIT_TEMP1_DISPLAY 	= 0,
@@ -144,6 +155,17 @@ enum DisplayIDs {
  */
 #define DISPLAY_SWITCH_OFF_AT_0 	true
 
+/**
+ * \brief How far in degrees a temperature has to be beyond the rounding boundary before the shown temperature changes.
+ * 		  Avoids that a temperature hovering around x.5 flips between two values on every read
+ */
+#define TEMPERATURE_DEAD_BAND		0.2
+
+/**
+ * \brief Minimum time in ms a shown temperature is kept before it can change again
+ */
+#define TEMPERATURE_MIN_DWELL		10000
+
 /**
  * \brief If set to true 24 hour format will be used. For this one additional column is needed in the shelf to display it correctly
  */
@@ -160,7 +182,7 @@ enum DisplayIDs {
 #define LOADING_ANIMATION_DURATION		3000
 
 /**
- * \brief How fast the brightness interpolation shall react to brightness changes
+ * \brief Time in ms a brightness change takes, the ramp runs on the perceptual CIE L* scale (see BrightnessRamp.h)
  */
 #define BRIGHTNESS_INTERPOLATION	3000
 
@@ -196,6 +218,27 @@ enum DisplayIDs {
  */
 #define NUM_SEPARATION_DOTS	2
 
+/**
+ * \brief Records the LED frames of the last seconds so a glitch can be reviewed afterwards.
+ * 		  The recording is downloaded from http://<clock ip>:OTA_UPDATE_PORT/frames.bin
+ * 		  Off by default: it takes FRAME_RECORDER_BUFFER_SIZE bytes of RAM plus about 9 bytes per LED for the frames
+ * 		  it encodes against, around 19 KB with the default buffer.
+ */
+#define ENABLE_FRAME_RECORDER		false
+
+#if ENABLE_FRAME_RECORDER == true
+	/**
+	 * \brief Size in bytes of the ring buffer holding the recorded frames. A static clock costs nothing, a frame in which
+	 * 		  every LED changed costs 3 bytes per LED
+	 */
+	#define FRAME_RECORDER_BUFFER_SIZE	16384
+
+	/**
+	 * \brief Time in ms the frames are kept, if the buffer is not full before
+	 */
+	#define FRAME_RECORDER_DURATION		30000
+#endif
+
 /***************************
 *
 * Light sensor settings
@@ -213,6 +256,12 @@ enum DisplayIDs {
 	 */
 	#define LIGHT_SENSOR_PIN			34
 
+	/**
+	 * \brief true if the analog output (AO) of the light sensor is connected to #LIGHT_SENSOR_PIN, false if it is the
+	 * 		  digital output (DO) which only tells if the light is above the threshold set with the sensor potentiometer
+	 */
+	#define LIGHT_SENSOR_ANALOG			false
+
 	/**
 	 * \brief How many measurements shall be averaged. Higher number -> smoother but slower change
 	 */
@@ -230,14 +279,14 @@ enum DisplayIDs {
 	#define LIGHT_SENSOR_READ_DELAY		500
 
 	/**
-	 * \brief AnalogRead value if the light sensor reads complete darkness
+	 * \brief AnalogRead value if the light sensor reads complete darkness. The LDR module reads high values in the dark, see Sensor_LDR.h
 	 */
-	#define LIGHT_SENSOR_MIN			0
+	#define LIGHT_SENSOR_MIN			4095
 
 	/**
 	 * \brief AnalogRead value if the light sensor reads the brightest
 	 */
-	#define LIGHT_SENSOR_MAX			4095
+	#define LIGHT_SENSOR_MAX			0
 
 	/**
 	 * \brief Value between 0 and 255 that determines how much the light sensor values can influence the led brightness
@@ -0,0 +1,135 @@
+/**
+ * \file DisplayLayoutConfiguration.h
+ * \author Yves Gaignard
+ * \brief Configuration for the whole LED setup.
+ *		  This file is evaluated at compile time by \ref DisplayLayout.h, any inconsistency between the displays,
+ *		  the segments and the LED counts from \ref DisplayConfiguration.h fails the build.
+ *		  Do not include it directly, include DisplayLayout.h instead.
+ */
+
+#ifndef _DISPLAY_LAYOUT_CONFIGURATION_H_
+#define _DISPLAY_LAYOUT_CONFIGURATION_H_
+
+/**
+ * \addtogroup DisplayConfiguration
+ * \brief Configuration to tell the system how the LEDs are wired together and arranged.
+ *  \{
+ */
+
+namespace DisplayLayout {
+
+/**
+ * \brief Displays that are present. The index of a display in this array is its #DisplayIDs value.
+ */
+inline constexpr DisplayDescription Displays[NUM_DISPLAYS] = {
+	{SevenSegment::SEVEN_SEGMENTS,         SevenSegment::SHORT_SEGMENT},	// HIGHER_DIGIT_TEMP1_DISPLAY
+	{SevenSegment::SEVEN_SEGMENTS,         SevenSegment::SHORT_SEGMENT},	// LOWER_DIGIT_TEMP1_DISPLAY
+	{SevenSegment::SEVEN_SEGMENTS,         SevenSegment::LONG_SEGMENT},	// HIGHER_DIGIT_HOUR_DISPLAY
+	{SevenSegment::SEVEN_SEGMENTS,         SevenSegment::LONG_SEGMENT},	// LOWER_DIGIT_HOUR_DISPLAY
+	{SevenSegment::TWO_VERTICAL_SEGMENTS,  SevenSegment::DOT_SEGMENT},	// DIGIT_DOT_DISPLAY
+	{SevenSegment::SEVEN_SEGMENTS,         SevenSegment::LONG_SEGMENT},	// HIGHER_DIGIT_MINUTE_DISPLAY
+	{SevenSegment::SEVEN_SEGMENTS,         SevenSegment::LONG_SEGMENT},	// LOWER_DIGIT_MINUTE_DISPLAY
+	{SevenSegment::SEVEN_SEGMENTS,         SevenSegment::SHORT_SEGMENT},	// HIGHER_DIGIT_TEMP2_DISPLAY
+	{SevenSegment::SEVEN_SEGMENTS,         SevenSegment::SHORT_SEGMENT} 	// LOWER_DIGIT_TEMP2_DISPLAY
+};
+
+/**
+ * \brief Every segment in the order in which the LEDs are wired.
+ *		  Each entry defines the display the segment belongs to, its position within this display and the direction
+ *		  in which its LEDs are wired, which is important for animations.
+ *		  The first LED of every segment is computed from this order and the size of its display.
+ */
+inline constexpr SegmentDescription Segments[NUM_SEGMENTS] = {
+	{HIGHER_DIGIT_TEMP1_DISPLAY,  SevenSegment::LeftTopSegment,      Segment::BOTTOM_TO_TOP},
+	{HIGHER_DIGIT_TEMP1_DISPLAY,  SevenSegment::MiddleTopSegment,    Segment::LEFT_TO_RIGHT},
+	{HIGHER_DIGIT_TEMP1_DISPLAY,  SevenSegment::RightTopSegment,     Segment::TOP_TO_BOTTTOM},
+	{HIGHER_DIGIT_TEMP1_DISPLAY,  SevenSegment::CenterSegment,       Segment::RIGHT_TO_LEFT},
+	{HIGHER_DIGIT_TEMP1_DISPLAY,  SevenSegment::LeftBottomSegment,   Segment::TOP_TO_BOTTTOM},
+	{HIGHER_DIGIT_TEMP1_DISPLAY,  SevenSegment::MiddleBottomSegment, Segment::LEFT_TO_RIGHT},
+	{HIGHER_DIGIT_TEMP1_DISPLAY,  SevenSegment::RightBottomSegment,  Segment::BOTTOM_TO_TOP},
+
+	{LOWER_DIGIT_TEMP1_DISPLAY,   SevenSegment::LeftTopSegment,      Segment::BOTTOM_TO_TOP},
+	{LOWER_DIGIT_TEMP1_DISPLAY,   SevenSegment::MiddleTopSegment,    Segment::LEFT_TO_RIGHT},
+	{LOWER_DIGIT_TEMP1_DISPLAY,   SevenSegment::RightTopSegment,     Segment::TOP_TO_BOTTTOM},
+	{LOWER_DIGIT_TEMP1_DISPLAY,   SevenSegment::CenterSegment,       Segment::RIGHT_TO_LEFT},
+	{LOWER_DIGIT_TEMP1_DISPLAY,   SevenSegment::LeftBottomSegment,   Segment::TOP_TO_BOTTTOM},
+	{LOWER_DIGIT_TEMP1_DISPLAY,   SevenSegment::MiddleBottomSegment, Segment::LEFT_TO_RIGHT},
+	{LOWER_DIGIT_TEMP1_DISPLAY,   SevenSegment::RightBottomSegment,  Segment::BOTTOM_TO_TOP},
+
+	{HIGHER_DIGIT_HOUR_DISPLAY,   SevenSegment::LeftTopSegment,      Segment::BOTTOM_TO_TOP},
+	{HIGHER_DIGIT_HOUR_DISPLAY,   SevenSegment::MiddleTopSegment,    Segment::LEFT_TO_RIGHT},
+	{HIGHER_DIGIT_HOUR_DISPLAY,   SevenSegment::RightTopSegment,     Segment::TOP_TO_BOTTTOM},
+	{HIGHER_DIGIT_HOUR_DISPLAY,   SevenSegment::CenterSegment,       Segment::RIGHT_TO_LEFT},
+	{HIGHER_DIGIT_HOUR_DISPLAY,   SevenSegment::LeftBottomSegment,   Segment::TOP_TO_BOTTTOM},
+	{HIGHER_DIGIT_HOUR_DISPLAY,   SevenSegment::MiddleBottomSegment, Segment::LEFT_TO_RIGHT},
+	{HIGHER_DIGIT_HOUR_DISPLAY,   SevenSegment::RightBottomSegment,  Segment::BOTTOM_TO_TOP},
+
+	{LOWER_DIGIT_HOUR_DISPLAY,    SevenSegment::LeftTopSegment,      Segment::BOTTOM_TO_TOP},
+	{LOWER_DIGIT_HOUR_DISPLAY,    SevenSegment::MiddleTopSegment,    Segment::LEFT_TO_RIGHT},
+	{LOWER_DIGIT_HOUR_DISPLAY,    SevenSegment::RightTopSegment,     Segment::TOP_TO_BOTTTOM},
+	{LOWER_DIGIT_HOUR_DISPLAY,    SevenSegment::CenterSegment,       Segment::RIGHT_TO_LEFT},
+	{LOWER_DIGIT_HOUR_DISPLAY,    SevenSegment::LeftBottomSegment,   Segment::TOP_TO_BOTTTOM},
+	{LOWER_DIGIT_HOUR_DISPLAY,    SevenSegment::MiddleBottomSegment, Segment::LEFT_TO_RIGHT},
+	{LOWER_DIGIT_HOUR_DISPLAY,    SevenSegment::RightBottomSegment,  Segment::BOTTOM_TO_TOP},
+
+	{DIGIT_DOT_DISPLAY,           SevenSegment::RightTopSegment,     Segment::TOP_TO_BOTTTOM},
+	{DIGIT_DOT_DISPLAY,           SevenSegment::RightBottomSegment,  Segment::TOP_TO_BOTTTOM},
+
+	{HIGHER_DIGIT_MINUTE_DISPLAY, SevenSegment::LeftTopSegment,      Segment::BOTTOM_TO_TOP},
+	{HIGHER_DIGIT_MINUTE_DISPLAY, SevenSegment::MiddleTopSegment,    Segment::LEFT_TO_RIGHT},
+	{HIGHER_DIGIT_MINUTE_DISPLAY, SevenSegment::RightTopSegment,     Segment::TOP_TO_BOTTTOM},
+	{HIGHER_DIGIT_MINUTE_DISPLAY, SevenSegment::CenterSegment,       Segment::RIGHT_TO_LEFT},
+	{HIGHER_DIGIT_MINUTE_DISPLAY, SevenSegment::LeftBottomSegment,   Segment::TOP_TO_BOTTTOM},
+	{HIGHER_DIGIT_MINUTE_DISPLAY, SevenSegment::MiddleBottomSegment, Segment::LEFT_TO_RIGHT},
+	{HIGHER_DIGIT_MINUTE_DISPLAY, SevenSegment::RightBottomSegment,  Segment::BOTTOM_TO_TOP},
+
+	{LOWER_DIGIT_MINUTE_DISPLAY,  SevenSegment::LeftTopSegment,      Segment::BOTTOM_TO_TOP},
+	{LOWER_DIGIT_MINUTE_DISPLAY,  SevenSegment::MiddleTopSegment,    Segment::LEFT_TO_RIGHT},
+	{LOWER_DIGIT_MINUTE_DISPLAY,  SevenSegment::RightTopSegment,     Segment::TOP_TO_BOTTTOM},
+	{LOWER_DIGIT_MINUTE_DISPLAY,  SevenSegment::CenterSegment,       Segment::RIGHT_TO_LEFT},
+	{LOWER_DIGIT_MINUTE_DISPLAY,  SevenSegment::LeftBottomSegment,   Segment::TOP_TO_BOTTTOM},
+	{LOWER_DIGIT_MINUTE_DISPLAY,  SevenSegment::MiddleBottomSegment, Segment::LEFT_TO_RIGHT},
+	{LOWER_DIGIT_MINUTE_DISPLAY,  SevenSegment::RightBottomSegment,  Segment::BOTTOM_TO_TOP},
+
+	{HIGHER_DIGIT_TEMP2_DISPLAY,  SevenSegment::LeftTopSegment,      Segment::BOTTOM_TO_TOP},
+	{HIGHER_DIGIT_TEMP2_DISPLAY,  SevenSegment::MiddleTopSegment,    Segment::LEFT_TO_RIGHT},
+	{HIGHER_DIGIT_TEMP2_DISPLAY,  SevenSegment::RightTopSegment,     Segment::TOP_TO_BOTTTOM},
+	{HIGHER_DIGIT_TEMP2_DISPLAY,  SevenSegment::CenterSegment,       Segment::RIGHT_TO_LEFT},
+	{HIGHER_DIGIT_TEMP2_DISPLAY,  SevenSegment::LeftBottomSegment,   Segment::TOP_TO_BOTTTOM},
+	{HIGHER_DIGIT_TEMP2_DISPLAY,  SevenSegment::MiddleBottomSegment, Segment::LEFT_TO_RIGHT},
+	{HIGHER_DIGIT_TEMP2_DISPLAY,  SevenSegment::RightBottomSegment,  Segment::BOTTOM_TO_TOP},
+
+	{LOWER_DIGIT_TEMP2_DISPLAY,   SevenSegment::LeftTopSegment,      Segment::BOTTOM_TO_TOP},
+	{LOWER_DIGIT_TEMP2_DISPLAY,   SevenSegment::MiddleTopSegment,    Segment::LEFT_TO_RIGHT},
+	{LOWER_DIGIT_TEMP2_DISPLAY,   SevenSegment::RightTopSegment,     Segment::TOP_TO_BOTTTOM},
+	{LOWER_DIGIT_TEMP2_DISPLAY,   SevenSegment::CenterSegment,       Segment::RIGHT_TO_LEFT},
+	{LOWER_DIGIT_TEMP2_DISPLAY,   SevenSegment::LeftBottomSegment,   Segment::TOP_TO_BOTTTOM},
+	{LOWER_DIGIT_TEMP2_DISPLAY,   SevenSegment::MiddleBottomSegment, Segment::LEFT_TO_RIGHT},
+	{LOWER_DIGIT_TEMP2_DISPLAY,   SevenSegment::RightBottomSegment,  Segment::BOTTOM_TO_TOP}
+};
+
+/**
+ * \brief LED strips the segments are split into, in wiring order. Each strip starts with the first segment of the
+ *		  given display and ends where the next strip starts, the last strip also drives the appended down lighters.
+ *		  A display can not be split across two strips.
+ *
+ *		  The strips are transmitted in parallel, so the time FastLED.show() takes is set by the longest strip
+ *		  (see \ref DisplayLayout::estimatedShowTimeMicros). For example with separate strips for temperature 1,
+ *		  the time and temperature 2:
+ *
+ *		  #define NUM_LED_STRIPS 3
+ *		  inline constexpr StripDescription Strips[NUM_LED_STRIPS] = {
+ *		  	{LED_DATA_PIN,	HIGHER_DIGIT_TEMP1_DISPLAY},
+ *		  	{23,			HIGHER_DIGIT_HOUR_DISPLAY},
+ *		  	{25,			HIGHER_DIGIT_TEMP2_DISPLAY}
+ *		  };
+ */
+inline constexpr StripDescription Strips[NUM_LED_STRIPS] = {
+	{LED_DATA_PIN,	HIGHER_DIGIT_TEMP1_DISPLAY}
+};
+
+} // namespace DisplayLayout
+
+/** \}*/
+
+#endif
@@ -64,6 +64,12 @@
 		#define OTA_UPDATE_HOST_NAME	"PoolClock"
 		#define OTA_UPDATE_PORT         80  
 		#define IS_WEB_SERIAL_ACTIVATED true
+
+		/**
+		 * \brief Show the progress of an OTA update as a progress bar on the LEDs. The duration of every update is logged,
+		 *        switch this off to compare it with an update while the display is not running.
+		 */
+		#define OTA_SHOW_PROGRESS		true
 	#endif
 
 	/**
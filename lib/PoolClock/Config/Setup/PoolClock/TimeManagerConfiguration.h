@@ -29,4 +29,12 @@
 	 */
 	#define TIME_SYNC_INTERVAL 1800
 
+	/**
+	 * \brief Task advancing the time and calling the callbacks of the TimeManager once the interrupt counted a
+	 *        second. Its priority is above the loop tasks so the time never lags behind.
+	 */
+	#define TIME_TASK_PRIORITY   5
+	#define TIME_TASK_CORE       0
+	#define TIME_TASK_STACK_SIZE 4096
+
 #endif
\ No newline at end of file
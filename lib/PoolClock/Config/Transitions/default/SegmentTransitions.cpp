@@ -1,16 +1,17 @@
 #include "SegmentTransitions.h"
 
 /**
- * \brief Easings have to be setup before any of the initAnimate functions are called
- * 		  it's only possible to reuse an easing if the multiple anstances of
- * 		  it running at the same time have the exact same settings. This includes duration too.
+ * \brief Easings have to be setup before any of the initAnimate functions are called.
+ * 		  Easings do not hold any per animation state, so one instance can be shared by all transitions
+ * 		  regardless of their duration. The curve and type are fixed at compile time so the curve is inlined
+ * 		  into the evaluation.
  * \addtogroup AnimationEasings
  * \{
  */
-BounceEase* bounceEaseOut 	= new BounceEase(EASE_OUT);
-CubicEase* cubicEaseInOut 	= new CubicEase(EASE_IN_OUT);
-CubicEase* cubicEaseIn 		= new CubicEase(EASE_IN);
-CubicEase* cubicEaseOut 	= new CubicEase(EASE_OUT);
+EasingBase* bounceEaseOut 	= STATIC_EASING(Bounce, EASE_OUT);
+EasingBase* cubicEaseInOut 	= STATIC_EASING(Cubic, EASE_IN_OUT);
+EasingBase* cubicEaseIn 	= STATIC_EASING(Cubic, EASE_IN);
+EasingBase* cubicEaseOut 	= STATIC_EASING(Cubic, EASE_OUT);
 /** \} */
 
 /**
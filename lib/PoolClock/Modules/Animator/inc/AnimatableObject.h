@@ -62,7 +62,7 @@ private:
 	double tickLength;
 	uint16_t fps;
 	uint16_t numStates;
-	uint16_t oldState;
+	int32_t oldState;
 	bool animationStarted;
 	void* complexAnimationInst;
 
@@ -77,13 +77,6 @@ private:
 	 */
 	void done();
 
-	/**
-	 * \brief Gets the current state of the animation including all easings that might affect it.
-	 *
-	 * \return int32_t the current state of the animation. Can also be negative in case of an easing that undershoots
-	 */
-	int32_t getState();
-
 	/**
 	 * \brief setting the animation to the state passed as a parameter
 	 *
@@ -96,6 +89,16 @@ protected:
 	AnimatableObject(uint16_t OverallDuration, uint16_t steps);
 	~AnimatableObject();
 
+	/**
+	 * \brief Gets the current state of the animation including all easings that might affect it.
+	 *
+	 * The easing result is truncated towards zero, so a state is reached once the curve has fully passed it. The
+	 * first state is always 0 and the last one always #numStates, whatever the curve.
+	 *
+	 * \return int32_t the current state of the animation. Can also be negative in case of an easing that undershoots
+	 */
+	int32_t getState();
+
 	/**
 	 * \brief Set the overall duration of any animation called on this object
 	 *
@@ -91,6 +91,11 @@ public:
 	 */
 	~Animator();
 
+	/**
+	 * \brief Time in ms at which the LEDs were last shown, changes once per rendered frame
+	 */
+	static unsigned long getLastFrameTime();
+
 	/**
 	 * \brief Add an animatable object to the Animator. The object is then updated by it.
 	 *
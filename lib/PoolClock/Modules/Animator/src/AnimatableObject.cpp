@@ -20,7 +20,7 @@ AnimatableObject::AnimatableObject(uint16_t OverallDuration, uint16_t steps)
     effect = nullptr;
 	easing = nullptr;
 	currentAnimationTime = 0;
-	oldState = UINT16_MAX;
+	oldState = INT32_MIN;
 	complexAnimationInst = nullptr;
 }
 
@@ -33,7 +33,7 @@ void AnimatableObject::handle(uint32_t state)
 	unsigned long currentMillis = millis();
 	if(animationStarted == true)
 	{
-		if(state != -1)
+		if(state != (uint32_t)-1)
 		{
 			currentAnimationTime = constrain(state, 0, AnimationDuration);
 		}
@@ -42,7 +42,7 @@ void AnimatableObject::handle(uint32_t state)
 			currentAnimationTime = currentMillis - AnimationStartTimestamp;
 		}
 
-		uint16_t currentState = getState();
+		int32_t currentState = getState();
 		if(oldState != currentState)
 		{
 			tick(currentState);
@@ -90,11 +90,6 @@ void AnimatableObject::start()
 		reset();
 	}
 	animationStarted = true;
-	if(easing != nullptr)
-	{
-		easing->setTotalChangeInPosition(numStates);
-		easing->setDuration(AnimationDuration);
-	}
 	if(startCallback != nullptr)
 	{
 		startCallback();
@@ -114,7 +109,7 @@ void AnimatableObject::reset()
 {
 	stop();
 	currentAnimationTime = 0;
-	oldState = UINT16_MAX;
+	oldState = INT32_MIN;
 }
 
 void AnimatableObject::done()
@@ -132,9 +127,16 @@ void AnimatableObject::done()
 
 int32_t AnimatableObject::getState()
 {
+	// the last frame usually lands a few ms after the end of the animation, evaluating the easing there would
+	// extrapolate the curve. Ending exactly on numStates also hides the rounding error of curves like Sine and
+	// Back which end a few ulp below 1 and would be truncated to numStates - 1.
+	if(currentAnimationTime >= AnimationDuration)
+	{
+		return numStates;
+	}
 	if(easing != nullptr)
 	{
-		return easing->ease(currentAnimationTime);
+		return easing->ease((NUMBER)currentAnimationTime / AnimationDuration, numStates);
 	}
 	return map(currentAnimationTime, 0, AnimationDuration, 0, numStates);
 }
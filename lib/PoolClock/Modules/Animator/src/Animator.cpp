@@ -20,6 +20,11 @@ Animator* Animator::getInstance()
 	return currentInstance;
 }
 
+unsigned long Animator::getLastFrameTime()
+{
+	return lastLEDUpdate;
+}
+
 int16_t Animator::getIndexInList(AnimatableObject* object)
 {
 	for (int i = 0; i < AnimatableObjects.size(); i++)
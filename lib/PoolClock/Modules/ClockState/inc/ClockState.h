@@ -10,17 +10,24 @@
 #include "Configuration.h"
 #include <Arduino.h>
 #include <esp_task_wdt.h>
+#include "freertos/timers.h"
 #define FASTLED_INTERNAL
 #include "FastLED.h"
 #include "TimeManager.h"
 #include "DisplayManager.h"
-#include "EasyButton.h"
+#include "PushButton.h"
+#include "SpscRing.h"
+#include "TimerWheel.h"
+#include <atomic>
 #if AIR_TEMP_SENSOR == true
 	#include "Sensor_AM232X.h"
 #endif
 #if WATER_TEMP_SENSOR == true
 	#include "Sensor_DS18B20.h"
 #endif
+#if PIR_SENSOR == true
+	#include "Sensor_HCSR501.h"
+#endif
 
 /**
  * \brief Available clock modes each with a different behaviour
@@ -43,9 +50,31 @@ enum Timer_Digit_enum {HOUR_DIGIT, MINUTE_DIGIT};
 */
 enum Timer_State_enum {STOPPED, RUNNING, PAUSED, CANCELLED};
 /**
-* \brief Enumeration of states that a push button may have
+* \brief Events driving the ClockState. Each event only triggers the work it affects:
+*        - EVENT_SECOND_TICK: the TimeManager advanced the time by one second
+*        - EVENT_SENSOR_UPDATE: a temperature sensor delivered a new measurement
+*        - EVENT_MODE_CHANGED: the mode was changed by #ClockState::switchMode
+*        - EVENT_TIMER_DONE: the timer elapsed, shows the timer notification
+*        - EVENT_ALARM_TRIGGERED: the alarm went off, shows the alarm notification
+*        - EVENT_TIMER_STARTED: the timer was started in the app, shows the timer mode
+*        - EVENT_TIMER_STOPPED: the timer was stopped in the app, shows the clock mode
+*        - EVENT_SETTINGS_CHANGED: brightness, night mode window, separation dots or colors were changed in the app
+*        - EVENT_NOTIFICATION_FLASH: next blink of a timer or alarm notification
+*        - EVENT_MOTION: the PIR sensor detected a new motion or a button was pressed, ends the idle mode
+*        The periodic work (night mode boundaries, dot flashes, sensor reads) is run by the scheduler when it is due
+*        Button presses do not go through the queue but through their own ring, see #ButtonEvent
 */
-enum Button_State_enum {NOT_PRESSED, PRESSED, LONG_PRESSED, RELEASED};
+enum ClockStateEvents {EVENT_SECOND_TICK, EVENT_SENSOR_UPDATE, EVENT_MODE_CHANGED, EVENT_SETTINGS_CHANGED, EVENT_NOTIFICATION_FLASH, EVENT_MOTION,
+                       EVENT_TIMER_DONE, EVENT_ALARM_TRIGGERED, EVENT_TIMER_STARTED, EVENT_TIMER_STOPPED};
+/**
+* \brief Button press handed over from the button task on core 0 to the main loop on core 1
+*/
+struct ButtonEvent
+{
+	Transitions_enum transition;
+	uint32_t timestamp;				/** micros() of the edge or the moment which completed the press */
+	uint16_t repeat;				/** number of the auto-repeat of a held button, 0 for a press */
+};
 /**
 * \brief Time in ms during a push button needs to be pressed to consider it is a LONG press
 */
@@ -57,15 +86,6 @@ enum Button_State_enum {NOT_PRESSED, PRESSED, LONG_PRESSED, RELEASED};
  */
 void ClockStateLoopCode(void* pvParameters);
 
-/**
- * @brief Button state variables
- * 
- */
-static Button_State_enum _Mode_button_state;
-static Button_State_enum _Play_button_state;
-static Button_State_enum _Plus_button_state;
-static Button_State_enum _Minus_button_state;
-
 /**
  * \addtogroup BlynkChannels
  * \brief These are the channel definitions for Blynk
@@ -106,14 +126,115 @@ private:
 #if WATER_TEMP_SENSOR == true
     Sensor_DS18B20*    _DS18B20Sensors;
 #endif
-	unsigned long      _lastDotFlash;
+#if PIR_SENSOR == true
+    Sensor_HCSR501*    _PIRSensor;
+#endif
+    QueueHandle_t      _events;
+    SpscRing<ButtonEvent, BUTTON_EVENT_RING_SIZE> _buttonEvents;
+    TimerHandle_t      _notificationTimer;
+    /**
+     * \brief Periodic work of the main loop, each job only runs when it is due
+     */
+    TimerWheel         _scheduler;
+    TimerWheel::Job    _nightModeJob;
+    TimerWheel::Job    _dotFlashJob;
+    TimerWheel::Job    _sensorJob;
+    TimerWheel::Job    _snapshotJob;
+    TimerWheel::Job    _settingsJob;
+    /**
+     * \brief Coalescing of the settings changes, see #ClockState::saveSettingsLater
+     */
+	uint32_t           _settingsChanges;
+	bool               _settingsDirty;
+	unsigned long      _settingsDirtySince;	/** millis() of the first change not yet saved */
     //ClockStates        _MainState;
     uint16_t           _alarmToggleCount;
-    unsigned long      _lastUpdateMillis;
     bool               _currentAlarmSignalState;
     bool               _isinNightMode;
+    /**
+     * \brief Last measurements, written by the loop task on core 0 before it posts EVENT_SENSOR_UPDATE
+     */
+	float              _airTemperature;
+	float              _airHumidity;
+	float              _waterTemperature;
+    /**
+     * \brief CPU time statistics of #ClockState::handleStates
+     */
+	uint32_t           _busyMicros;
+	uint32_t           _busyMicrosLastMinute;
+	unsigned long      _busyWindowStart;
+	uint32_t           _processedEvents;
+	std::atomic<uint32_t> _droppedEvents;	/** counted by #ClockState::postEvent, from any task and from interrupts */
+    /**
+     * \brief Press to display latency: time from the button edge to the first frame shown after the press was handled
+     */
+	bool               _latencyPending;
+	uint32_t           _latencyEventTime;
+	unsigned long      _latencyFrame;
+	uint32_t           _lastButtonLatency;
+	uint32_t           _maxButtonLatency;
+	uint64_t           _buttonLatencySum;
+	uint32_t           _buttonLatencyCount;
+    /**
+     * \brief Idle mode while nobody is around, see #PIR_IDLE_MODE. _idle is also read by the loop task on core 0.
+     */
+	std::atomic<bool>  _idle;
+	unsigned long      _idleSince;
+	unsigned long      _lastMotion;			/** millis() of the last motion or button press, only used by the main loop */
+	uint64_t           _idleMillis;			/** time spent in the previous idle periods */
+	uint32_t           _idlePowerSaving;	/** estimated mW saved during the current idle period */
+	uint64_t           _energySaved;		/** mW * ms saved during the previous idle periods */
+	uint32_t           _activeCpuFrequency;
+    /**
+     * \brief Auto-repeat of the held buttons and coalescing of the changes they cause
+     */
+	uint16_t           _buttonRepeat;		/** repeat number of the button event being processed */
+	bool               _digitsDirty;
+	bool               _lcdDirty;
+	unsigned long      _lastDigitsRefresh;
+	unsigned long      _lastLCDRefresh;
 
 	ClockState();
+	void pushButtonEvent(Transitions_enum transition, uint32_t eventTime, uint16_t repeat = 0);
+	void refreshCoalesced();
+	uint8_t getAutoRepeatStep();
+	bool readSensors(bool force);
+	void updateNightMode(bool apply);
+	void displayCurrentState();
+	void refreshLCD();
+	void flashNotification();
+	void onSecondTick();
+	void onSensorUpdate();
+	void onModeChanged();
+	void onSettingsChanged();
+	void enterIdle();
+	void exitIdle();
+	void scheduleNightModeCheck();
+	static void nightModeJob(void* context);
+	static void dotFlashJob(void* context);
+	static void sensorJob(void* context);
+	static void snapshotJob(void* context);
+	static void settingsJob(void* context);
+	static void notificationTimerCallback(TimerHandle_t timer);
+	static void motionInterrupt();
+
+    /**
+     * \brief One cell of the state machine: the action routine to run and the state to go to
+     */
+	typedef void (ClockState::*Action)();
+	struct StateMachineEntry
+	{
+		Action      action;
+		ClockStates next;
+	};
+public:
+	static constexpr uint8_t STATE_COUNT      = ALARM_NOTIFICATION + 1;
+	static constexpr uint8_t TRANSITION_COUNT = LONG_MINUS + 1;
+private:
+    /**
+     * \brief The design of Doc/StateMachine.xlsx, generated into StateMachineTable.h by tools/generate_state_machine.py
+     */
+	static const StateMachineEntry _stateMachine[STATE_COUNT][TRANSITION_COUNT];
 public:
 	/**
 	 * \brief possible selection options of the segmented switch responsible for selecting which color should be
@@ -130,10 +251,10 @@ public:
 	bool            _isClearAction;
 
 #if PUSH_BUTTONS == true
-	EasyButton* _ModeButton;
-	EasyButton* _PlayButton;
-	EasyButton* _PlusButton;
-	EasyButton* _MinusButton;
+	PushButton* _ModeButton;
+	PushButton* _PlayButton;
+	PushButton* _PlusButton;
+	PushButton* _MinusButton;
 #endif
 	/**
 	 * @brief Machine state variables
@@ -142,8 +263,6 @@ public:
 	ClockStates _current_state;
 	ClockStates _previous_state;
 
-    Transitions_enum _last_transition;
-
 	/**
 	 * @brief Timer variables
 	 * 
@@ -192,7 +311,8 @@ public:
 	~ClockState();
 
     /**
-     * \brief Switch the current mode of the clock
+     * \brief Switch the current mode of the clock. The mode is only written by the main loop, the other tasks and
+     *        the callbacks post an event instead, e.g. EVENT_TIMER_DONE
      */
     void switchMode(ClockStates newState);
 
@@ -202,11 +322,75 @@ public:
     ClockStates getMode();
 
     /**
-     * \brief Has to be called periodically to update the screen and process state transitions within the state machine.
+     * \brief Posts an event to the ClockState. Can be called from any task and from interrupts.
+     *
+     * \param type event to post
+     * \return false if the queue was full and the event was dropped
+     */
+	bool postEvent(ClockStateEvents type);
+
+    /**
+     * \brief Processes the pending events: updates the screen and runs the state machine. Never blocks, has to be
+     *        called from the main loop.
      *
      */
 	void handleStates();
 
+    /**
+     * \brief CPU time in us spent by #ClockState::handleStates during the last full minute
+     */
+	uint32_t getBusyMicrosPerMinute() const;
+
+    /**
+     * \brief Number of events processed since boot
+     */
+	uint32_t getProcessedEvents() const;
+
+    /**
+     * \brief Number of events dropped since boot because the queue was full
+     */
+	uint32_t getDroppedEvents() const;
+
+    /**
+     * \brief Number of button presses detected since boot
+     */
+	uint32_t getButtonEvents() const;
+
+    /**
+     * \brief Number of button presses dropped since boot because the main loop did not keep up
+     */
+	uint32_t getDroppedButtonEvents() const;
+
+    /**
+     * \brief Press to display latency in us of the last button press
+     */
+	uint32_t getLastButtonLatency() const;
+
+    /**
+     * \brief Highest press to display latency in us since boot
+     */
+	uint32_t getMaxButtonLatency() const;
+
+    /**
+     * \brief Average press to display latency in us since boot
+     */
+	uint32_t getAverageButtonLatency() const;
+
+    /**
+     * \brief Returns true while the clock is in the idle mode because nobody is around
+     */
+	bool isIdle() const;
+
+    /**
+     * \brief Time in seconds spent in the idle mode since boot
+     */
+	uint32_t getIdleSeconds() const;
+
+    /**
+     * \brief Estimated energy in mWh saved by the idle mode since boot
+     */
+	uint32_t getEnergySaved() const;
+
     /**
 	 * \brief to be called as part of the setup function
 	 *
@@ -214,6 +398,79 @@ public:
 	 */
 	void setup();
 
+	/**
+	 * \brief Starts the loop task on core 0 which reads the sensors (and serves Blynk)
+	 *
+	 * \pre the sensors and Blynk are initialized
+	 */
+	void startLoopTask();
+
+	/**
+	 * \brief State of the clock kept over a warm restart, see #WarmRestart
+	 */
+	typedef struct
+	{
+		ClockStates             state;
+		TimeManager::TimeInfo   TimerDuration;
+		TimeManager::TimeInfo   InitialTimerDuration;
+		Timer_Digit_enum        CurrentTimerDigit;
+		Timer_State_enum        TimerState;
+		uint8_t                 clockBrightness;
+		uint8_t                 nightModeBrightness;
+		TimeManager::TimeInfo   NightModeStartTime;
+		TimeManager::TimeInfo   NightModeStopTime;
+		uint8_t                 numDots;
+		float                   airTemperature;
+		float                   airHumidity;
+		float                   waterTemperature;
+	}Snapshot;
+
+	/**
+	 * \brief Copy the state which has to survive a warm restart, only called from the main loop
+	 */
+	void takeSnapshot(Snapshot& snapshot);
+
+	/**
+	 * \brief Restore the state after a warm restart and show it right away
+	 *
+	 * \pre #ClockState::setup was called and the TimeManager resumed
+	 */
+	void resume(const Snapshot& snapshot);
+
+	/**
+	 * \brief Settings of the user kept over a power cycle, see #SettingsStore
+	 */
+	typedef struct
+	{
+		ColorScheme             colors;
+		uint8_t                 clockBrightness;
+		uint8_t                 nightModeBrightness;
+		TimeManager::TimeInfo   NightModeStartTime;
+		TimeManager::TimeInfo   NightModeStopTime;
+		uint8_t                 numDots;
+		TimeManager::TimeInfo   TimerDuration;		/** duration the timer is set to after a cancel */
+	}Settings;
+
+	/**
+	 * \brief Copy the current settings, only called from the main loop
+	 */
+	void takeSettings(Settings& settings);
+
+	/**
+	 * \brief Replace the defaults by the stored settings, called by #ClockState::setup
+	 */
+	void applySettings(const Settings& settings);
+
+	/**
+	 * \brief Saves the settings once they stopped changing for #SETTINGS_SAVE_DELAY, only called from the main loop
+	 */
+	void saveSettingsLater();
+
+	/**
+	 * \brief Number of settings changes since boot, coalesced into far fewer flash writes
+	 */
+	uint32_t getSettingsChanges() const;
+
 	/**
 	 * \brief Code for the second thread running on the second core of the ESP handling all the LCD code since
 	 *        all of it is coded in a blocking way and we don't want to influence the animation smoothness
@@ -240,21 +497,11 @@ public:
 	void changeSelection(ColorSelector selector, bool state);
 
 	/**
-	 * \brief Management of the state machine
+	 * \brief Management of the state machine: runs the action of the current state and transition from the table
+	 *        and switches to the next state
 	 */
 	void state_machine_run(Transitions_enum transition);
 
-	/**
-	 * \brief Print to the serial the state of a button (for debug purpose)
-	 */
-	static void print_button_state(const char* button_name, Button_State_enum button_state);
-
-	/**
-	 * @brief Buttons read detection and transform theim into transitions
-	 * 
-	 * @return Transitions_enum 
-	 */
-	Transitions_enum read_buttons();
 
 	/**
 	 * \brief Transition action routines
@@ -272,18 +519,21 @@ public:
 	void IncrementQuicklyDigit();
 	void DecrementDigit();
 	void DecrementQuicklyDigit();
+	void DismissNotification();
 
 	/**
 	 * \brief Callbacks to manage button actions
 	 */
-	static void Mode_onPressed();
-	static void Mode_onPressedForDuration();
-	static void Play_onPressed();
-	static void Play_onPressedForDuration();
-	static void Plus_onPressed();
-	static void Plus_onPressedForDuration();
-	static void Minus_onPressed();
-	static void Minus_onPressedForDuration();
+	static void Mode_onPressed(uint32_t eventTime);
+	static void Mode_onPressedForDuration(uint32_t eventTime);
+	static void Play_onPressed(uint32_t eventTime);
+	static void Play_onPressedForDuration(uint32_t eventTime);
+	static void Plus_onPressed(uint32_t eventTime);
+	static void Plus_onPressedForDuration(uint32_t eventTime);
+	static void Minus_onPressed(uint32_t eventTime);
+	static void Minus_onPressedForDuration(uint32_t eventTime);
+	static void Plus_onRepeat(uint32_t eventTime, uint16_t repeat);
+	static void Minus_onRepeat(uint32_t eventTime, uint16_t repeat);
 };
 
 #endif
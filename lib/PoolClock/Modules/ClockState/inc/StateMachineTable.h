@@ -0,0 +1,80 @@
+/**
+ * \file StateMachineTable.h
+ * \author Yves Gaignard
+ * \brief Transition table of the ClockState state machine
+ *
+ * GENERATED by tools/generate_state_machine.py from Doc/StateMachine.csv, do not edit.
+ * Only included by ClockState.cpp.
+ */
+
+#ifndef __STATE_MACHINE_TABLE_H_
+#define __STATE_MACHINE_TABLE_H_
+
+static_assert(ClockState::STATE_COUNT == 5, "StateMachineTable.h: regenerate the table, ClockStates changed");
+static_assert(ClockState::TRANSITION_COUNT == 9, "StateMachineTable.h: regenerate the table, Transitions_enum changed");
+
+constexpr ClockState::StateMachineEntry ClockState::_stateMachine[ClockState::STATE_COUNT][ClockState::TRANSITION_COUNT] =
+{
+	// CLOCK_MODE
+	{
+		{&ClockState::NOPE,                   CLOCK_MODE        }, // NONE
+		{&ClockState::ChgModeToTimer,         TIMER_MODE        }, // MODE       Change Mode to Timer
+		{&ClockState::ChgModeToSetTimer,      SET_TIMER         }, // LONG_MODE  Change Mode to Set Timer
+		{&ClockState::NOPE,                   CLOCK_MODE        }, // PLAY       Null Operation
+		{&ClockState::NOPE,                   CLOCK_MODE        }, // LONG_PLAY  Null Operation
+		{&ClockState::NOPE,                   CLOCK_MODE        }, // PLUS       Null Operation
+		{&ClockState::NOPE,                   CLOCK_MODE        }, // LONG_PLUS  Null Operation
+		{&ClockState::NOPE,                   CLOCK_MODE        }, // MINUS      Null Operation
+		{&ClockState::NOPE,                   CLOCK_MODE        }, // LONG_MINUS Null Operation
+	},
+	// TIMER_MODE
+	{
+		{&ClockState::NOPE,                   TIMER_MODE        }, // NONE
+		{&ClockState::ChgModeToClock,         CLOCK_MODE        }, // MODE       Change Mode to Clock
+		{&ClockState::ChgModeToSetTimer,      SET_TIMER         }, // LONG_MODE  Change Mode to Set Timer
+		{&ClockState::StartPauseResumeTimer,  TIMER_MODE        }, // PLAY       Start / Pause / Resume Timer
+		{&ClockState::CancelTimer,            TIMER_MODE        }, // LONG_PLAY  Cancel Timer
+		{&ClockState::NOPE,                   TIMER_MODE        }, // PLUS       Null Operation
+		{&ClockState::NOPE,                   TIMER_MODE        }, // LONG_PLUS  Null Operation
+		{&ClockState::NOPE,                   TIMER_MODE        }, // MINUS      Null Operation
+		{&ClockState::NOPE,                   TIMER_MODE        }, // LONG_MINUS Null Operation
+	},
+	// SET_TIMER
+	{
+		{&ClockState::NOPE,                   SET_TIMER         }, // NONE
+		{&ClockState::ValidateSetTimer,       TIMER_MODE        }, // MODE       Validate Set Timer
+		{&ClockState::CancelSetTimer,         CLOCK_MODE        }, // LONG_MODE  Cancel Set Timer
+		{&ClockState::MoveNextDigit,          SET_TIMER         }, // PLAY       Move Next Digit
+		{&ClockState::ValidateSetTimer,       TIMER_MODE        }, // LONG_PLAY  Validate Set Timer
+		{&ClockState::IncrementDigit,         SET_TIMER         }, // PLUS       Increment Digit
+		{&ClockState::IncrementQuicklyDigit,  SET_TIMER         }, // LONG_PLUS  Increment quickly digit
+		{&ClockState::DecrementDigit,         SET_TIMER         }, // MINUS      Decrement Digit
+		{&ClockState::DecrementQuicklyDigit,  SET_TIMER         }, // LONG_MINUS Decrement quickly digit
+	},
+	// TIMER_NOTIFICATION
+	{
+		{&ClockState::NOPE,                   TIMER_NOTIFICATION}, // NONE
+		{&ClockState::DismissNotification,    CLOCK_MODE        }, // MODE       Dismiss Notification
+		{&ClockState::DismissNotification,    CLOCK_MODE        }, // LONG_MODE  Dismiss Notification
+		{&ClockState::DismissNotification,    CLOCK_MODE        }, // PLAY       Dismiss Notification
+		{&ClockState::DismissNotification,    CLOCK_MODE        }, // LONG_PLAY  Dismiss Notification
+		{&ClockState::DismissNotification,    CLOCK_MODE        }, // PLUS       Dismiss Notification
+		{&ClockState::DismissNotification,    CLOCK_MODE        }, // LONG_PLUS  Dismiss Notification
+		{&ClockState::DismissNotification,    CLOCK_MODE        }, // MINUS      Dismiss Notification
+		{&ClockState::DismissNotification,    CLOCK_MODE        }, // LONG_MINUS Dismiss Notification
+	},
+	// ALARM_NOTIFICATION
+	{
+		{&ClockState::NOPE,                   ALARM_NOTIFICATION}, // NONE
+		{&ClockState::DismissNotification,    CLOCK_MODE        }, // MODE       Dismiss Notification
+		{&ClockState::DismissNotification,    CLOCK_MODE        }, // LONG_MODE  Dismiss Notification
+		{&ClockState::DismissNotification,    CLOCK_MODE        }, // PLAY       Dismiss Notification
+		{&ClockState::DismissNotification,    CLOCK_MODE        }, // LONG_PLAY  Dismiss Notification
+		{&ClockState::DismissNotification,    CLOCK_MODE        }, // PLUS       Dismiss Notification
+		{&ClockState::DismissNotification,    CLOCK_MODE        }, // LONG_PLUS  Dismiss Notification
+		{&ClockState::DismissNotification,    CLOCK_MODE        }, // MINUS      Dismiss Notification
+		{&ClockState::DismissNotification,    CLOCK_MODE        }, // LONG_MINUS Dismiss Notification
+	},
+};
+
+#endif
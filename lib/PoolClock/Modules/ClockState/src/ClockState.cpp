@@ -7,12 +7,18 @@
 #define TAG "ClockState"
 
 #include "ClockState.h"
+#include "StateMachineTable.h"
 #include "LogManager.h"
+#if WARM_RESTART == true
+	#include "WarmRestart.h"
+#endif
+#if PERSISTENT_SETTINGS == true
+	#include "SettingsStore.h"
+#endif
 /**
  * \note if you use a different controller make sure to change the include here
  */
 #include <BlynkSimpleEsp32.h>
-ClockState*   ClockS  = ClockState::getInstance();
 
 #if LCD_SCREEN == true
 	/**
@@ -21,11 +27,12 @@ ClockState*   ClockS  = ClockState::getInstance();
 	extern void LCDScreen_Clock_Mode(TimeManager* currentTime, float temperature1, float humidity1, float temperature2, float humidity2);
 	extern void LCDScreen_Timer_Mode(TimeManager* currentTimer, Timer_State_enum timerState);
 	extern void LCDScreen_Set_Timer (TimeManager* currentTimer, LCDScreen_BlinkingDigit digitCursor);
+	extern void LCDScreen_Backlight(bool on);
 #endif
 
 ClockState* ClockState::_instance = nullptr;
 
-ClockState::ClockState()
+ClockState::ClockState() : _scheduler(SCHEDULER_TICK, millis())
 {
 	_current_state = CLOCK_MODE;
 	_previous_state= CLOCK_MODE;
@@ -37,8 +44,15 @@ ClockState::ClockState()
 	_NightModeStartTime = TimeManager::TimeInfo {DEFAULT_NIGHT_MODE_START_HOUR, DEFAULT_NIGHT_MODE_START_MINUTE, 0};
 	_NightModeStopTime = TimeManager::TimeInfo {DEFAULT_NIGHT_MODE_END_HOUR, DEFAULT_NIGHT_MODE_END_MINUTE, 0};
 
-	_lastUpdateMillis = millis();
-	_lastDotFlash = millis();
+	_nightModeJob = TimerWheel::Job(nightModeJob, this);
+	_dotFlashJob  = TimerWheel::Job(dotFlashJob, this);
+	_sensorJob    = TimerWheel::Job(sensorJob, this);
+	_snapshotJob  = TimerWheel::Job(snapshotJob, this);
+	_settingsJob  = TimerWheel::Job(settingsJob, this);
+	_settingsChanges    = 0;
+	_settingsDirty      = false;
+	_settingsDirtySince = 0;
+	_ClockStateLoop = nullptr;
 	_currentAlarmSignalState = false;
 	_isinNightMode = false;
 	_timeM = TimeManager::getInstance();
@@ -48,20 +62,53 @@ ClockState::ClockState()
 #endif
 #if WATER_TEMP_SENSOR == true
 	_DS18B20Sensors = Sensor_DS18B20::getInstance();
+#endif
+#if PIR_SENSOR == true
+	_PIRSensor = Sensor_HCSR501::getInstance();
 #endif
 	_isClearAction     = false;
 	_ColorSelection    = CHANGE_HOURS_COLOR;
 	_UIUpdateRequired  = false;
 
-	_ModeButton = new EasyButton(BUTTON_MODE_PIN ,   30U, true, false);
-	_PlusButton = new EasyButton(BUTTON_PLUS_PIN ,   30U, true, false);
-	_PlayButton = new EasyButton(BUTTON_PLAY_PIN ,   30U, true, false);
-	_MinusButton= new EasyButton(BUTTON_MINUS_PIN,   30U, true, false);
-
-	_Mode_button_state  = NOT_PRESSED;
-	_Play_button_state  = NOT_PRESSED;
-	_Plus_button_state  = NOT_PRESSED;
-	_Minus_button_state = NOT_PRESSED;
+	_airTemperature   = 0.0;
+	_airHumidity      = 0.0;
+	_waterTemperature = 0.0;
+	_busyMicros           = 0;
+	_busyMicrosLastMinute = 0;
+	_busyWindowStart      = millis();
+	_processedEvents      = 0;
+	_droppedEvents        = 0;
+	_buttonRepeat         = 0;
+	_digitsDirty          = false;
+	_lcdDirty             = false;
+	_lastDigitsRefresh    = 0;
+	_lastLCDRefresh       = 0;
+
+	_events = xQueueCreate(CLOCK_STATE_EVENT_QUEUE_SIZE, sizeof(ClockStateEvents));
+	_notificationTimer = xTimerCreate("Notification", pdMS_TO_TICKS(NOTIFICATION_FLASH_INTERVAL), pdTRUE, nullptr, notificationTimerCallback);
+
+	_latencyPending     = false;
+	_latencyEventTime   = 0;
+	_latencyFrame       = 0;
+	_lastButtonLatency  = 0;
+	_maxButtonLatency   = 0;
+	_buttonLatencySum   = 0;
+	_buttonLatencyCount = 0;
+
+	_idle               = false;
+	_idleSince          = 0;
+	_idleMillis         = 0;
+	_lastMotion         = 0;
+	_idlePowerSaving    = 0;
+	_energySaved        = 0;
+	_activeCpuFrequency = 0;
+
+#if PUSH_BUTTONS == true
+	_ModeButton = new PushButton(BUTTON_MODE_PIN ,   30U, true, false);
+	_PlusButton = new PushButton(BUTTON_PLUS_PIN ,   30U, true, false);
+	_PlayButton = new PushButton(BUTTON_PLAY_PIN ,   30U, true, false);
+	_MinusButton= new PushButton(BUTTON_MINUS_PIN,   30U, true, false);
+#endif
 }
 
 ClockState::~ClockState()
@@ -80,15 +127,13 @@ ClockState* ClockState::getInstance()
 
 void ClockState::switchMode(ClockStates newState)
 {
-	// ========================================================================================
-	// !!! ATTENTION !!! DON'T ADD ANY LOG IN THIS FUNCTION AS IT CAN BE CALLED IN A CALLBACK 
-	// ========================================================================================
     if(newState == CLOCK_MODE)
     {
         _alarmToggleCount = 0;
     }
 	_previous_state= _current_state;
     _current_state = newState;
+	postEvent(EVENT_MODE_CHANGED);
 }
 
 ClockStates ClockState::getMode()
@@ -96,141 +141,598 @@ ClockStates ClockState::getMode()
     return _current_state;
 }
 
+bool ClockState::postEvent(ClockStateEvents type)
+{
+	// ========================================================================================
+	// !!! ATTENTION !!! DON'T ADD ANY LOG IN THIS FUNCTION AS IT CAN BE CALLED IN A CALLBACK 
+	// ========================================================================================
+	BaseType_t queued;
+	if(xPortInIsrContext())
+	{
+		BaseType_t higherPriorityTaskWoken = pdFALSE;
+		queued = xQueueSendFromISR(_events, &type, &higherPriorityTaskWoken);
+		if(higherPriorityTaskWoken == pdTRUE)
+		{
+			portYIELD_FROM_ISR();
+		}
+	}
+	else
+	{
+		queued = xQueueSend(_events, &type, 0);
+	}
+	if(queued != pdTRUE)
+	{
+		_droppedEvents.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	return true;
+}
+
 void ClockState::handleStates()
 {
-	LOG_V(TAG, "ClockState::handleStates() ... Start");
-	if(_lastUpdateMillis + TIME_UPDATE_INTERVAL <= millis()) // update the display only in a certain interval
+	//the first frame shown after a press was handled ends the press to display latency
+	if(_latencyPending && Animator::getLastFrameTime() != _latencyFrame)
 	{
-		// ========================
-		// Display of temperature
-		// ========================
-		float temperature1=0.0;
-		float humidity1=0.0;
-		float temperature2=0.0;
-		float humidity2=0.0;
-	
-		#if AIR_TEMP_SENSOR == true
-			_am232x->handle();
-			temperature1=_am232x->getTemperature();
-			humidity1=_am232x->getHumidity();
-		#endif
-		#if WATER_TEMP_SENSOR == true
-			temperature2=_DS18B20Sensors->getPreciseTempCByAddress(waterThermometerAddress);
-		#endif
-		_PoolClockDisplays->displayTemperature(temperature1, humidity1, temperature2, humidity2);
+		_latencyPending = false;
+		_lastButtonLatency = micros() - _latencyEventTime;
+		if(_lastButtonLatency > _maxButtonLatency)
+		{
+			_maxButtonLatency = _lastButtonLatency;
+		}
+		_buttonLatencySum += _lastButtonLatency;
+		_buttonLatencyCount++;
+		LOG_D(TAG, "Press to display latency: %u us", _lastButtonLatency);
+	}
+
+	ButtonEvent button;
+	while(_buttonEvents.pop(button))
+	{
+		unsigned long start = micros();
+		LOG_D(TAG, "Treat transition %d (repeat %d) detected %lu us ago", button.transition, button.repeat, start - button.timestamp);
+		_lastMotion = millis();
+		if(button.repeat > 0 && (_idle || _current_state != SET_TIMER))
+		{
+			//a held button only repeats while the timer is set, e.g. not after it dismissed a notification
+			continue;
+		}
+		if(_idle)
+		{
+			//the press only wakes the clock up, nobody could see what it would have changed
+			exitIdle();
+		}
+		else
+		{
+			_buttonRepeat = button.repeat;
+			state_machine_run(button.transition);
+			_digitsDirty = true;
+		}
+		_busyMicros += micros() - start;
+		_processedEvents++;
+		_latencyPending = true;
+		_latencyEventTime = button.timestamp;
+		_latencyFrame = Animator::getLastFrameTime();
+	}
+
+	refreshCoalesced();
+
+	ClockStateEvents event;
+	while(xQueueReceive(_events, &event, 0) == pdTRUE)
+	{
+		unsigned long start = micros();
+		switch (event)
+		{
+		case EVENT_SECOND_TICK:
+			onSecondTick();
+			break;
+		case EVENT_SENSOR_UPDATE:
+			onSensorUpdate();
+			break;
+		case EVENT_MODE_CHANGED:
+			onModeChanged();
+			break;
+		case EVENT_SETTINGS_CHANGED:
+			onSettingsChanged();
+			break;
+		case EVENT_NOTIFICATION_FLASH:
+			flashNotification();
+			break;
+		case EVENT_MOTION:
+			_lastMotion = millis();
+			if(_idle)
+			{
+				exitIdle();
+			}
+			break;
+		case EVENT_TIMER_DONE:
+			switchMode(TIMER_NOTIFICATION);
+			break;
+		case EVENT_ALARM_TRIGGERED:
+			switchMode(ALARM_NOTIFICATION);
+			break;
+		case EVENT_TIMER_STARTED:
+			switchMode(TIMER_MODE);
+			break;
+		case EVENT_TIMER_STOPPED:
+			switchMode(CLOCK_MODE);
+			break;
+		default:
+			break;
+		}
+		_busyMicros += micros() - start;
+		_processedEvents++;
+	}
+
+	unsigned long start = micros();
+	_scheduler.advance(millis());
+	_busyMicros += micros() - start;
+
+	if(millis() - _busyWindowStart >= 60000)
+	{
+		_busyMicrosLastMinute = _busyMicros;
+		_busyMicros = 0;
+		_busyWindowStart = millis();
+		LOG_D(TAG, "State machine CPU time: %u us during the last minute", _busyMicrosLastMinute);
+	}
+
+	if(_idle && _PoolClockDisplays->isDark())
+	{
+		//nothing is rendered, sleep until the next job is due instead of spinning the main loop. Motions, presses
+		//and the second ticks end the wait through the queue.
+		uint32_t deadline = _scheduler.getNextDeadline(millis());
+		xQueuePeek(_events, &event, deadline == TimerWheel::NoDeadline ? portMAX_DELAY : pdMS_TO_TICKS(deadline));
+	}
+}
+
+/**
+ * \brief Reads the temperature sensors if a new measurement is due
+ *
+ * \param force read the current values even if no new measurement was made
+ * \return true if a new measurement is available
+ */
+bool ClockState::readSensors(bool force)
+{
+	bool updated = force;
+	#if AIR_TEMP_SENSOR == true
+		if(_am232x->handle() || force)
+		{
+			_airTemperature = _am232x->getTemperature();
+			_airHumidity = _am232x->getHumidity();
+			updated = true;
+		}
+	#endif
+	#if WATER_TEMP_SENSOR == true
+		if(_DS18B20Sensors->requestTemperatures() || force)
+		{
+			_waterTemperature = _DS18B20Sensors->getPreciseTempCByAddress(waterThermometerAddress);
+			updated = true;
+		}
+	#endif
+	return updated;
+}
+
+/**
+ * \brief Switches between the day and the night brightness
+ *
+ * \param apply set the brightness even if the night mode did not change, e.g. after the brightness settings changed
+ */
+void ClockState::updateNightMode(bool apply)
+{
+	bool isNight = false;
+	#if USE_NIGHT_MODE == true
+		isNight = _timeM->isInBetween(_NightModeStartTime, _NightModeStopTime);
+	#endif
+	if(isNight != _isinNightMode || apply == true)
+	{
+		_isinNightMode = isNight;
+		_PoolClockDisplays->setGlobalBrightness(isNight ? _nightModeBrightness : _clockBrightness);
+	}
+}
 
-		// =================================
-		// Display of clock, timer or alarm
-		// =================================
-		_lastUpdateMillis = millis();
-		TimeManager::TimeInfo currentTime;
+/**
+ * \brief Shows the changes made by the buttons. While the timer is set, a held button changes it faster than the
+ *        digits can morph and the LCD can be written: only the latest value is shown once the previous one is done.
+ */
+void ClockState::refreshCoalesced()
+{
+	unsigned long digitsInterval = _current_state == SET_TIMER ? SET_TIMER_DIGITS_REFRESH_INTERVAL : 0;
+	if(_digitsDirty && millis() - _lastDigitsRefresh >= digitsInterval)
+	{
+		_digitsDirty = false;
+		_lastDigitsRefresh = millis();
+		displayCurrentState();
+	}
+	if(_lcdDirty && millis() - _lastLCDRefresh >= SET_TIMER_LCD_REFRESH_INTERVAL)
+	{
+		_lcdDirty = false;
+		_lastLCDRefresh = millis();
+		refreshLCD();
+	}
+}
+
+/**
+ * \brief Shows the time or the timer on the digits, depending on the current mode
+ */
+void ClockState::displayCurrentState()
+{
+	TimeManager::TimeInfo currentTime;
+	switch (_current_state)
+	{
+	case CLOCK_MODE:
+	case ALARM_NOTIFICATION:
 		currentTime = _timeM->getCurrentTime();
+		LOG_D(TAG, "PoolClockDisplays->setFrame... %02d:%02d:%02d",currentTime.hours, currentTime.minutes, currentTime.seconds);
+		//the time and the temperatures as one frame, only the digits which changed are sent to the displays
+		_PoolClockDisplays->setFrame(currentTime.hours, currentTime.minutes, _airTemperature, _waterTemperature);
+		break;
+	case TIMER_MODE:
+	case SET_TIMER:
+		currentTime = _timeM->getRemainingTimerTime();
+		LOG_D(TAG, "PoolClockDisplays->displayTimer... %02d:%02d:%02d",currentTime.hours, currentTime.minutes, currentTime.seconds);
+		_PoolClockDisplays->displayTimer(currentTime.hours, currentTime.minutes, currentTime.seconds);
+		break;
+	case TIMER_NOTIFICATION:
+		#if TIMER_FLASH_TIME == true
+			currentTime = _timeM->getCurrentTime();
+			_PoolClockDisplays->displayTime(currentTime.hours, currentTime.minutes);
+		#else
+			_PoolClockDisplays->displayTime(0, 0);
+		#endif
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * \brief Shows the screen of the current mode on the LCD
+ */
+void ClockState::refreshLCD()
+{
+	#if LCD_SCREEN == true
 		switch (_current_state)
 		{
 		case CLOCK_MODE:
-			#if USE_NIGHT_MODE == true
-				if(_timeM->isInBetween(_NightModeStartTime, _NightModeStopTime))
-				{
-					if(_isinNightMode == false)
-					{
-						_isinNightMode = true;
-						_PoolClockDisplays->setGlobalBrightness(_nightModeBrightness);
-					}
-				}
-				else
-				{
-					if(_isinNightMode == true)
-					{
-						_isinNightMode = false;
-						_PoolClockDisplays->setGlobalBrightness(_clockBrightness);
-					}
-				}
-			#endif
-			LOG_D(TAG, "PoolClockDisplays->displayTime... %02d:%02d:%02d",currentTime.hours, currentTime.minutes, currentTime.seconds);
-			_PoolClockDisplays->displayTime(currentTime.hours, currentTime.minutes);
-			#if DISPLAY_FOR_SEPARATION_DOT > -1
-				if(_numDots > 0)
-				{
-					if(_lastDotFlash + DOT_FLASH_INTERVAL <= millis())
-					{
-						_lastDotFlash = millis();
-						LOG_D(TAG, "PoolClockDisplays->flashSeparationDot... %d",_numDots);
-						_PoolClockDisplays->flashSeparationDot(_numDots);
-						LOG_D(TAG, "PoolClockDisplays->flashSeparationDot...End");
-					}
-				}
-			#endif
-			#if LCD_SCREEN == true
-				LCDScreen_Clock_Mode(_timeM, temperature1, humidity1, temperature2, humidity2);
-			#endif
-		break;
+			LCDScreen_Clock_Mode(_timeM, _airTemperature, _airHumidity, _waterTemperature, 0.0);
+			break;
 		case TIMER_MODE:
-			currentTime = _timeM->getRemainingTimerTime();
-			LOG_D(TAG, "PoolClockDisplays->displayTimer... %02d:%02d:%02d",currentTime.hours, currentTime.minutes, currentTime.seconds);
-			_PoolClockDisplays->displayTimer(currentTime.hours, currentTime.minutes, currentTime.seconds);
-			#if LCD_SCREEN == true
-				LCDScreen_Timer_Mode(_timeM, _TimerState);
-			#endif
-		break;
+			LCDScreen_Timer_Mode(_timeM, _TimerState);
+			break;
 		case SET_TIMER:
-			currentTime = _timeM->getRemainingTimerTime();
-			LOG_D(TAG, "PoolClockDisplays->displaySetTimer... %02d:%02d:%02d",currentTime.hours, currentTime.minutes, currentTime.seconds);
-			_PoolClockDisplays->displayTimer(currentTime.hours, currentTime.minutes, currentTime.seconds);
-			#if LCD_SCREEN == true
-				LOG_D(TAG, "ClockState from SET_TIMER - cursor on: %d", _lcd_blinking_digit);
-				LCDScreen_Set_Timer(_timeM, _lcd_blinking_digit);  
-			#endif
-		break;
-		case TIMER_NOTIFICATION:
-			if(_currentAlarmSignalState == true)
+			LOG_D(TAG, "ClockState from SET_TIMER - cursor on: %d", _lcd_blinking_digit);
+			LCDScreen_Set_Timer(_timeM, _lcd_blinking_digit);
+			break;
+		default:
+			break;
+		}
+	#endif
+}
+
+void ClockState::onSecondTick()
+{
+	switch (_current_state)
+	{
+	case CLOCK_MODE:
+		displayCurrentState();
+		#if PIR_IDLE_MODE == true
+			if(_idle)
 			{
-				_PoolClockDisplays->setGlobalBrightness(NOTIFICATION_BRIGHTNESS, false);
+				//the digits are kept up to date for the wake up, the dots and the LCD wait
+				break;
 			}
-			else
+			//the output of the sensor stays high as long as someone keeps moving, only its rising edge is an event
+			if(_PIRSensor->getPIRState() == HIGH)
 			{
-				_PoolClockDisplays->setGlobalBrightness(0, false);
+				_lastMotion = millis();
 			}
-			_currentAlarmSignalState = !_currentAlarmSignalState;
-			_alarmToggleCount++;
-			#if TIMER_FLASH_TIME == true
-				_PoolClockDisplays->displayTime(currentTime.hours, currentTime.minutes);
-			#else
-				_PoolClockDisplays->displayTime(0, 0);
-			#endif
-			if(_alarmToggleCount >= TIMER_FLASH_COUNT)
+			if(millis() - _lastMotion >= PIR_IDLE_DELAY * 60000ul)
 			{
-				_PoolClockDisplays->setGlobalBrightness(_clockBrightness);
-				_PoolClockDisplays->displayTime(currentTime.hours, currentTime.minutes);
-				_alarmToggleCount = 0;
-				_previous_state = _current_state;
-				_current_state = CLOCK_MODE;
+				enterIdle();
+				break;
 			}
+		#endif
+		refreshLCD();
 		break;
-		case ALARM_NOTIFICATION:
-			if(_currentAlarmSignalState == true)
-			{
-				_PoolClockDisplays->setGlobalBrightness(NOTIFICATION_BRIGHTNESS, false);
-			}
-			else
-			{
-				_PoolClockDisplays->setGlobalBrightness(0, false);
-			}
-			_currentAlarmSignalState = !_currentAlarmSignalState;
-			LOG_D(TAG, "PoolClockDisplays->displayAlarm... %d:%d:%d",currentTime.hours, currentTime.minutes, currentTime.seconds);
-			_PoolClockDisplays->displayTime(currentTime.hours, currentTime.minutes);
-			if(!_timeM->isAlarmActive())
-			{
-				_PoolClockDisplays->setGlobalBrightness(_clockBrightness);
-				_previous_state = _current_state;
-				_current_state = CLOCK_MODE;
-			}
+	case TIMER_MODE:
+		//the remaining time only changes while the timer runs
+		if(_TimerState == RUNNING)
+		{
+			displayCurrentState();
+			refreshLCD();
+		}
 		break;
-		default:
-			break;
+	default:
+		//nothing changes in SET_TIMER, the notifications are driven by their own timer
+		break;
+	}
+}
+
+void ClockState::onSensorUpdate()
+{
+	if(_current_state == CLOCK_MODE)
+	{
+		displayCurrentState();
+		refreshLCD();
+	}
+	else
+	{
+		_PoolClockDisplays->displayTemperature(_airTemperature, _airHumidity, _waterTemperature, 0.0);
+	}
+}
+
+void ClockState::onModeChanged()
+{
+	if(_idle)
+	{
+		//a timer or an alarm went off
+		exitIdle();
+	}
+	if(_current_state == TIMER_NOTIFICATION || _current_state == ALARM_NOTIFICATION)
+	{
+		if(xTimerIsTimerActive(_notificationTimer) == pdFALSE)
+		{
+			_currentAlarmSignalState = true;
+			xTimerStart(_notificationTimer, 0);
+		}
+		return;
+	}
+	xTimerStop(_notificationTimer, 0);
+	if(_current_state == CLOCK_MODE)
+	{
+		updateNightMode(true);
+	}
+	displayCurrentState();
+	refreshLCD();
+}
+
+void ClockState::onSettingsChanged()
+{
+	saveSettingsLater();
+	scheduleNightModeCheck();
+	if(_current_state == CLOCK_MODE)
+	{
+		updateNightMode(true);
+	}
+	else if(_current_state == TIMER_MODE || _current_state == SET_TIMER)
+	{
+		_PoolClockDisplays->setGlobalBrightness(_clockBrightness);
+	}
+}
+
+void ClockState::flashNotification()
+{
+	if(_current_state != TIMER_NOTIFICATION && _current_state != ALARM_NOTIFICATION)
+	{
+		return;
+	}
+	_PoolClockDisplays->setGlobalBrightness(_currentAlarmSignalState ? NOTIFICATION_BRIGHTNESS : 0, false);
+	_currentAlarmSignalState = !_currentAlarmSignalState;
+	displayCurrentState();
+	if(_current_state == TIMER_NOTIFICATION)
+	{
+		_alarmToggleCount++;
+		if(_alarmToggleCount >= TIMER_FLASH_COUNT)
+		{
+			switchMode(CLOCK_MODE);
+		}
+	}
+	else if(!_timeM->isAlarmActive())
+	{
+		switchMode(CLOCK_MODE);
+	}
+}
+
+void ClockState::enterIdle()
+{
+	#if PIR_IDLE_MODE == true
+		_idlePowerSaving = _PoolClockDisplays->getLEDPower() + IDLE_CPU_POWER_SAVING;
+		_PoolClockDisplays->setIdle(true);
+		#if LCD_SCREEN == true
+			_idlePowerSaving += IDLE_LCD_BACKLIGHT_POWER;
+			LCDScreen_Backlight(false);
+		#endif
+		_activeCpuFrequency = getCpuFrequencyMhz();
+		setCpuFrequencyMhz(IDLE_CPU_FREQUENCY);
+		_scheduler.schedule(_sensorJob, IDLE_SENSOR_INTERVAL, IDLE_SENSOR_INTERVAL);
+		_idleSince = millis();
+		_idle = true;
+		LOG_I(TAG, "Nobody around, idle mode entered, about %u mW saved", _idlePowerSaving);
+	#endif
+}
+
+void ClockState::exitIdle()
+{
+	#if PIR_IDLE_MODE == true
+		setCpuFrequencyMhz(_activeCpuFrequency);
+		unsigned long idleTime = millis() - _idleSince;
+		_idleMillis += idleTime;
+		_energySaved += (uint64_t)_idlePowerSaving * idleTime;
+		_idle = false;
+		//a wake up by the timer or the alarm also keeps the clock on for a full delay
+		_lastMotion = millis();
+		_scheduler.schedule(_sensorJob, SENSOR_CHECK_INTERVAL, SENSOR_CHECK_INTERVAL);
+		_PoolClockDisplays->setIdle(false);
+		#if LCD_SCREEN == true
+			LCDScreen_Backlight(true);
+		#endif
+		displayCurrentState();
+		refreshLCD();
+		LOG_I(TAG, "Idle mode left after %lu s", idleTime / 1000);
+	#endif
+}
+
+void ClockState::motionInterrupt()
+{
+	// ========================================================================================
+	// !!! ATTENTION !!! DON'T ADD ANY LOG IN THIS FUNCTION AS IT IS CALLED IN AN INTERRUPT 
+	// ========================================================================================
+	ClockState::getInstance()->postEvent(EVENT_MOTION);
+}
+
+/**
+ * \brief Schedules the next night mode check at the next start or end of the night
+ */
+void ClockState::scheduleNightModeCheck()
+{
+	#if USE_NIGHT_MODE == true
+		//the night includes its end time, it ends one second later
+		uint32_t seconds = _timeM->secondsUntil(_NightModeStartTime);
+		uint32_t secondsUntilStop = _timeM->secondsUntil(_timeM->addSeconds(_NightModeStopTime, 1));
+		if(secondsUntilStop < seconds)
+		{
+			seconds = secondsUntilStop;
+		}
+		uint32_t delay = seconds * 1000UL < NIGHT_MODE_RECHECK_INTERVAL ? seconds * 1000UL : NIGHT_MODE_RECHECK_INTERVAL;
+		LOG_D(TAG, "Next night mode check in %u s", delay / 1000);
+		_scheduler.schedule(_nightModeJob, delay);
+	#endif
+}
+
+void ClockState::nightModeJob(void* context)
+{
+	ClockState* clockState = (ClockState*)context;
+	//the other modes set their own brightness, the clock mode applies the night mode when it is entered again
+	if(clockState->_current_state == CLOCK_MODE)
+	{
+		clockState->updateNightMode(false);
+	}
+	clockState->scheduleNightModeCheck();
+}
+
+void ClockState::dotFlashJob(void* context)
+{
+	ClockState* clockState = (ClockState*)context;
+	if(clockState->_current_state == CLOCK_MODE && !clockState->_idle && clockState->_numDots > 0)
+	{
+		LOG_D(TAG, "PoolClockDisplays->flashSeparationDot... %d", clockState->_numDots);
+		clockState->_PoolClockDisplays->flashSeparationDot(clockState->_numDots);
+	}
+}
+
+void ClockState::sensorJob(void* context)
+{
+	ClockState* clockState = (ClockState*)context;
+	//after a warm restart the loop task is only started once the sensors are initialized in the background
+	if(clockState->_ClockStateLoop != nullptr)
+	{
+		xTaskNotifyGive(clockState->_ClockStateLoop);
+	}
+}
+
+void ClockState::snapshotJob(void* context)
+{
+	#if WARM_RESTART == true
+		WarmRestart::getInstance()->save();
+	#endif
+}
+
+void ClockState::settingsJob(void* context)
+{
+	#if PERSISTENT_SETTINGS == true
+		ClockState* clockState = (ClockState*)context;
+		Settings settings;
+		clockState->takeSettings(settings);
+		clockState->_settingsDirty = false;
+		if(!SettingsStore::getInstance()->save(settings))
+		{
+			clockState->_scheduler.schedule(clockState->_settingsJob, SETTINGS_SAVE_MAX_DELAY);
+		}
+	#endif
+}
+
+void ClockState::saveSettingsLater()
+{
+	#if PERSISTENT_SETTINGS == true
+		_settingsChanges++;
+		unsigned long now = millis();
+		if(!_settingsDirty)
+		{
+			_settingsDirty = true;
+			_settingsDirtySince = now;
+		}
+		//every change restarts the quiet time, but the first change waits for SETTINGS_SAVE_MAX_DELAY at most
+		unsigned long waited = now - _settingsDirtySince;
+		uint32_t delay = SETTINGS_SAVE_DELAY;
+		if(waited + delay > SETTINGS_SAVE_MAX_DELAY)
+		{
+			delay = waited < SETTINGS_SAVE_MAX_DELAY ? SETTINGS_SAVE_MAX_DELAY - waited : 0;
 		}
+		_scheduler.schedule(_settingsJob, delay);
+	#endif
+}
+
+uint32_t ClockState::getSettingsChanges() const
+{
+	return _settingsChanges;
+}
+
+void ClockState::notificationTimerCallback(TimerHandle_t timer)
+{
+	ClockState::getInstance()->postEvent(EVENT_NOTIFICATION_FLASH);
+}
+
+uint32_t ClockState::getBusyMicrosPerMinute() const
+{
+	return _busyMicrosLastMinute;
+}
+
+uint32_t ClockState::getProcessedEvents() const
+{
+	return _processedEvents;
+}
+
+uint32_t ClockState::getDroppedEvents() const
+{
+	return _droppedEvents;
+}
+
+uint32_t ClockState::getButtonEvents() const
+{
+	return _buttonEvents.getPushed();
+}
+
+uint32_t ClockState::getDroppedButtonEvents() const
+{
+	return _buttonEvents.getDropped();
+}
+
+uint32_t ClockState::getLastButtonLatency() const
+{
+	return _lastButtonLatency;
+}
+
+uint32_t ClockState::getMaxButtonLatency() const
+{
+	return _maxButtonLatency;
+}
+
+uint32_t ClockState::getAverageButtonLatency() const
+{
+	return _buttonLatencyCount > 0 ? _buttonLatencySum / _buttonLatencyCount : 0;
+}
+
+bool ClockState::isIdle() const
+{
+	return _idle;
+}
 
+uint32_t ClockState::getIdleSeconds() const
+{
+	uint64_t idleMillis = _idleMillis;
+	if(_idle)
+	{
+		idleMillis += millis() - _idleSince;
 	}
-	LOG_V(TAG, "ClockState::handleStates() ... End");
+	return idleMillis / 1000;
+}
+
+uint32_t ClockState::getEnergySaved() const
+{
+	uint64_t energySaved = _energySaved;
+	if(_idle)
+	{
+		energySaved += (uint64_t)_idlePowerSaving * (millis() - _idleSince);
+	}
+	return energySaved / 3600000;
 }
 
 /**
@@ -239,7 +741,11 @@ void ClockState::handleStates()
  */
 void ClockState::stop()
 {
-	vTaskDelete(_ClockStateLoop);
+	if(_ClockStateLoop != nullptr)
+	{
+		vTaskDelete(_ClockStateLoop);
+		_ClockStateLoop = nullptr;
+	}
 }
 
 /**
@@ -275,37 +781,42 @@ void ClockState::changeSelection(ColorSelector selector, bool state)
 }
 
 /**
- * \brief Code for the second thread running on the second core of the ESP handling all the blynk code since
- *        all of it is coded in a blocking way and we don't want to influence the animation smoothness
+ * \brief Code for the second thread running on the second core of the ESP handling the buttons, the sensors and the
+ *        blynk code since all of it is coded in a blocking way and we don't want to influence the animation smoothness.
+ *        Everything it detects is posted as an event to the main loop.
  *
  */
 void ClockState::ClockStateLoopCode(void* pvParameters)
 {
-	Transitions_enum transition;
 	LOG_D(TAG, "Loop task running on core %d", xPortGetCoreID());
 	ClockState* ClockS = ClockState::getInstance();
 	esp_task_wdt_init(30, false);
-	ClockS->read_buttons();
+	ClockS->readSensors(true);
+	ClockS->postEvent(EVENT_SENSOR_UPDATE);
 	for(;;)
 	{
 		LOG_V(TAG, "ClockStateLoopCode");
-		transition = ClockS->read_buttons();
-		if ( transition != NONE && ClockS->_last_transition == NONE) {
-			ClockS->_last_transition = transition;
-			LOG_D(TAG, "Set _last_transition to: %d", transition);
+		//the sensor job of the scheduler notifies this task when a measurement is due
+		#if IS_BLYNK_ACTIVE == true
+			bool sensorsDue = ulTaskNotifyTake(pdTRUE, 10 / portTICK_PERIOD_MS) > 0; //Blynk.run has to be served often
+		#else
+			bool sensorsDue = ulTaskNotifyTake(pdTRUE, portMAX_DELAY) > 0;
+		#endif
+		if(sensorsDue && ClockS->readSensors(false))
+		{
+			ClockS->postEvent(EVENT_SENSOR_UPDATE);
 		}
-	    //state_machine_run(transition);
  
 		#if IS_BLYNK_ACTIVE == true
 			Blynk.run();
-			if(UIUpdateRequired == true)
+			if(ClockS->_UIUpdateRequired == true)
 			{
-				UIUpdateRequired = false;
-				if(ClockS->getMode() == ClockState::CLOCK_MODE)
+				ClockS->_UIUpdateRequired = false;
+				if(ClockS->getMode() == CLOCK_MODE)
 				{
 					Blynk.virtualWrite(BLYNK_CHANNEL_TIMER_START_BUTTON, 0);
 				}
-				else if(ClockS->getMode() == ClockState::ALARM_NOTIFICATION)
+				else if(ClockS->getMode() == ALARM_NOTIFICATION)
 				{
 					Blynk.setProperty(BLYNK_CHANNEL_ALARM_START_BUTTON, "onLabel", "Clear");
 				}
@@ -318,8 +829,6 @@ void ClockState::ClockStateLoopCode(void* pvParameters)
 			}
 		#endif
 		esp_task_wdt_reset();
-		//delay(1); //needed to serve the wdg
-		vTaskDelay(10 / portTICK_PERIOD_MS);
 	}
 }
 
@@ -329,16 +838,21 @@ void ClockState::ClockStateLoopCode(void* pvParameters)
  */
 void ClockState::setup()
 {
-	// Setup for each button
-	_ModeButton-> begin();
-	_PlayButton-> begin();
-	_PlusButton-> begin();
-	_MinusButton->begin();
+	#if PUSH_BUTTONS == true
+		// Setup for each button
+		_ModeButton-> begin();
+		_PlayButton-> begin();
+		_PlusButton-> begin();
+		_MinusButton->begin();
+	#endif
+	#if PIR_IDLE_MODE == true
+		_PIRSensor->onMotion(motionInterrupt);
+		_lastMotion = millis();
+	#endif
 	
 	// Default current state
     _current_state  = CLOCK_MODE; 
     _previous_state = CLOCK_MODE;
-	_last_transition= NONE;
 
 	// Default Timer Duration
 	_TimerDuration.hours   = TIMER_DEFAULT_HOUR;
@@ -353,6 +867,14 @@ void ClockState::setup()
 	// Default Timer Digit
 	_CurrentTimerDigit = HOUR_DIGIT;
 
+	#if PERSISTENT_SETTINGS == true
+		Settings settings;
+		if(SettingsStore::getInstance()->load(settings))
+		{
+			applySettings(settings);
+		}
+	#endif
+
 	#if AIR_TEMP_SENSOR == true
 		_am232x = Sensor_AM232X::getInstance();
 	#endif
@@ -360,16 +882,32 @@ void ClockState::setup()
 		_DS18B20Sensors = Sensor_DS18B20::getInstance();
 	#endif
 
-    // callback declaration
-    _ModeButton-> onPressed(ClockState::Mode_onPressed);
-    _ModeButton-> onPressedFor(LONG_PRESS_TIME, ClockState::Mode_onPressedForDuration);
-    _PlayButton-> onPressed(ClockState::Play_onPressed);
-    _PlayButton-> onPressedFor(LONG_PRESS_TIME, ClockState::Play_onPressedForDuration);
-    _PlusButton-> onPressed(ClockState::Plus_onPressed);
-    _PlusButton-> onPressedFor(LONG_PRESS_TIME, ClockState::Plus_onPressedForDuration);
-    _MinusButton->onPressed(ClockState::Minus_onPressed);
-    _MinusButton->onPressedFor(LONG_PRESS_TIME, ClockState::Minus_onPressedForDuration);
+	#if PUSH_BUTTONS == true
+	    // callback declaration
+	    _ModeButton-> onPressed(ClockState::Mode_onPressed);
+	    _ModeButton-> onPressedFor(LONG_PRESS_TIME, ClockState::Mode_onPressedForDuration);
+	    _PlayButton-> onPressed(ClockState::Play_onPressed);
+	    _PlayButton-> onPressedFor(LONG_PRESS_TIME, ClockState::Play_onPressedForDuration);
+	    _PlusButton-> onPressed(ClockState::Plus_onPressed);
+	    _PlusButton-> onPressedFor(LONG_PRESS_TIME, ClockState::Plus_onPressedForDuration);
+	    _MinusButton->onPressed(ClockState::Minus_onPressed);
+	    _MinusButton->onPressedFor(LONG_PRESS_TIME, ClockState::Minus_onPressedForDuration);
+	    _PlusButton-> onRepeat(ClockState::Plus_onRepeat, AUTO_REPEAT_SLOW_INTERVAL, AUTO_REPEAT_SLOW_COUNT, AUTO_REPEAT_FAST_INTERVAL);
+	    _MinusButton->onRepeat(ClockState::Minus_onRepeat, AUTO_REPEAT_SLOW_INTERVAL, AUTO_REPEAT_SLOW_COUNT, AUTO_REPEAT_FAST_INTERVAL);
+	#endif
+
+	scheduleNightModeCheck();
+	#if DISPLAY_FOR_SEPARATION_DOT > -1
+		_scheduler.schedule(_dotFlashJob, DOT_FLASH_INTERVAL, DOT_FLASH_INTERVAL);
+	#endif
+	_scheduler.schedule(_sensorJob, SENSOR_CHECK_INTERVAL, SENSOR_CHECK_INTERVAL);
+	#if WARM_RESTART == true
+		_scheduler.schedule(_snapshotJob, WARM_RESTART_SNAPSHOT_INTERVAL, WARM_RESTART_SNAPSHOT_INTERVAL);
+	#endif
+}
 
+void ClockState::startLoopTask()
+{
 	LOG_D(TAG, "Starting ClockStateLoopCode on core 0...");
 	//Setup the loop task on the second core
 	xTaskCreatePinnedToCore(
@@ -382,48 +920,137 @@ void ClockState::setup()
 	0);				        // pin task to core 0
 }
 
+void ClockState::takeSnapshot(Snapshot& snapshot)
+{
+	snapshot.state                = _current_state;
+	snapshot.TimerDuration        = _TimerDuration;
+	snapshot.InitialTimerDuration = _InitialTimerDuration;
+	snapshot.CurrentTimerDigit    = _CurrentTimerDigit;
+	snapshot.TimerState           = _TimerState;
+	snapshot.clockBrightness      = _clockBrightness;
+	snapshot.nightModeBrightness  = _nightModeBrightness;
+	snapshot.NightModeStartTime   = _NightModeStartTime;
+	snapshot.NightModeStopTime    = _NightModeStopTime;
+	snapshot.numDots              = _numDots;
+	snapshot.airTemperature       = _airTemperature;
+	snapshot.airHumidity          = _airHumidity;
+	snapshot.waterTemperature     = _waterTemperature;
+}
+
+void ClockState::takeSettings(Settings& settings)
+{
+	//the store compares the settings byte by byte, all their members are bytes so there is no padding to clear
+	settings = Settings();
+	settings.colors              = _PoolClockDisplays->getColorScheme();
+	settings.clockBrightness     = _clockBrightness;
+	settings.nightModeBrightness = _nightModeBrightness;
+	settings.NightModeStartTime  = _NightModeStartTime;
+	settings.NightModeStopTime   = _NightModeStopTime;
+	settings.numDots             = _numDots;
+	settings.TimerDuration       = _InitialTimerDuration;
+}
+
+void ClockState::applySettings(const Settings& settings)
+{
+	_PoolClockDisplays->setColorScheme(settings.colors);
+	_HourColor           = settings.colors.hour;
+	_MinuteColor         = settings.colors.minute;
+	_InternalColor       = settings.colors.internal;
+	_DotColor            = settings.colors.dot;
+	_clockBrightness     = settings.clockBrightness;
+	_nightModeBrightness = settings.nightModeBrightness;
+	_NightModeStartTime  = settings.NightModeStartTime;
+	_NightModeStopTime   = settings.NightModeStopTime;
+	_numDots             = settings.numDots;
+	_TimerDuration       = settings.TimerDuration;
+	_InitialTimerDuration = settings.TimerDuration;
+}
+
+void ClockState::resume(const Snapshot& snapshot)
+{
+	_TimerDuration        = snapshot.TimerDuration;
+	_InitialTimerDuration = snapshot.InitialTimerDuration;
+	_CurrentTimerDigit    = snapshot.CurrentTimerDigit;
+	_TimerState           = snapshot.TimerState;
+	_clockBrightness      = snapshot.clockBrightness;
+	_nightModeBrightness  = snapshot.nightModeBrightness;
+	_NightModeStartTime   = snapshot.NightModeStartTime;
+	_NightModeStopTime    = snapshot.NightModeStopTime;
+	_numDots              = snapshot.numDots;
+	_airTemperature       = snapshot.airTemperature;
+	_airHumidity          = snapshot.airHumidity;
+	_waterTemperature     = snapshot.waterTemperature;
+	#if LCD_SCREEN == true
+		_lcd_blinking_digit = _CurrentTimerDigit == HOUR_DIGIT ? LowHour : LowMinute;
+	#endif
+	LOG_I(TAG, "Resuming mode %d, timer %02d:%02d:%02d", snapshot.state, _TimerDuration.hours, _TimerDuration.minutes, _TimerDuration.seconds);
+
+	//the events are processed by the first pass of the main loop: brightness, digits, LCD and temperatures
+	updateNightMode(true);
+	scheduleNightModeCheck();
+	switchMode(snapshot.state);
+	postEvent(EVENT_SENSOR_UPDATE);
+}
+
+/**
+ * \brief Hands a detected transition over to the main loop. Only called by the button callbacks, which all run in
+ *        the FreeRTOS timer task: it is the single producer of the button event ring. Its stack is small, so there
+ *        is no log here, dropped presses are counted by the ring.
+ */
+void ClockState::pushButtonEvent(Transitions_enum transition, uint32_t eventTime, uint16_t repeat)
+{
+	_buttonEvents.push({transition, eventTime, repeat});
+	if(_idle)
+	{
+		//the sleeping main loop only waits on the event queue
+		postEvent(EVENT_MOTION);
+	}
+}
+
 /**
  * \brief Callback to manage Mode button action in case of short press
  */
-void ClockState::Mode_onPressed() {
-    LOG_D(TAG, "Mode button has been pressed!");
-    _Mode_button_state = PRESSED;
+void ClockState::Mode_onPressed(uint32_t eventTime) {
+    getInstance()->pushButtonEvent(MODE, eventTime);
 }
 
 /**
  * \brief Callback to manage Mode button action in case of long press
  */
-void ClockState::Mode_onPressedForDuration() {
-    LOG_D(TAG, "Mode button has been pressed for the given duration!");
-    _Mode_button_state = LONG_PRESSED;
+void ClockState::Mode_onPressedForDuration(uint32_t eventTime) {
+    getInstance()->pushButtonEvent(LONG_MODE, eventTime);
 }
 
-void ClockState::Play_onPressed() {
-    LOG_D(TAG, "Play button has been pressed!");
-    _Play_button_state = PRESSED;
+void ClockState::Play_onPressed(uint32_t eventTime) {
+    getInstance()->pushButtonEvent(PLAY, eventTime);
 }
 
-void ClockState::Play_onPressedForDuration() {
-    LOG_D(TAG, "Play button has been pressed for the given duration!");
-    _Play_button_state = LONG_PRESSED;
+void ClockState::Play_onPressedForDuration(uint32_t eventTime) {
+    getInstance()->pushButtonEvent(LONG_PLAY, eventTime);
 }
-void ClockState::Plus_onPressed() {
-    LOG_D(TAG, "Plus button has been pressed!");
-    _Plus_button_state = PRESSED;
+void ClockState::Plus_onPressed(uint32_t eventTime) {
+    getInstance()->pushButtonEvent(PLUS, eventTime);
 }
 
-void ClockState::Plus_onPressedForDuration() {
-    LOG_D(TAG, "Plus button has been pressed for the given duration!");
-    _Plus_button_state = LONG_PRESSED;
+void ClockState::Plus_onPressedForDuration(uint32_t eventTime) {
+    getInstance()->pushButtonEvent(LONG_PLUS, eventTime);
 }
-void ClockState::Minus_onPressed() {
-    LOG_D(TAG, "Minus button has been pressed!");
-    _Minus_button_state = PRESSED;
+void ClockState::Minus_onPressed(uint32_t eventTime) {
+    getInstance()->pushButtonEvent(MINUS, eventTime);
 }
 
-void ClockState::Minus_onPressedForDuration() {
-    LOG_D(TAG, "Minus button has been pressed for the given duration!");
-    _Minus_button_state = LONG_PRESSED;
+void ClockState::Minus_onPressedForDuration(uint32_t eventTime) {
+    getInstance()->pushButtonEvent(LONG_MINUS, eventTime);
+}
+
+/**
+ * \brief Callbacks of the auto-repeat of the held PLUS and MINUS buttons, each repeat is a new long press
+ */
+void ClockState::Plus_onRepeat(uint32_t eventTime, uint16_t repeat) {
+    getInstance()->pushButtonEvent(LONG_PLUS, eventTime, repeat);
+}
+void ClockState::Minus_onRepeat(uint32_t eventTime, uint16_t repeat) {
+    getInstance()->pushButtonEvent(LONG_MINUS, eventTime, repeat);
 }
 
 /**
@@ -431,114 +1058,21 @@ void ClockState::Minus_onPressedForDuration() {
  * 
  * @param Transitions_enum transition
  */
-void ClockState::state_machine_run(Transitions_enum transition) 
+void ClockState::state_machine_run(Transitions_enum transition)
 {
-	LOG_D(TAG, "ClockState::state_machine_run - Transition: %d",transition);
-    switch(transition)
-    {
-        case NONE:              LOG_V(TAG, "buttons = NONE");               break;
-        case MODE:              LOG_D(TAG, "buttons = MODE");               break;
-        case LONG_MODE:         LOG_D(TAG, "buttons = LONG_MODE");          break;
-        case PLAY:              LOG_D(TAG, "buttons = PLAY");               break;
-        case LONG_PLAY:         LOG_D(TAG, "buttons = LONG_PLAY");          break;
-        case PLUS:              LOG_D(TAG, "buttons = PLUS");               break;
-        case LONG_PLUS:         LOG_D(TAG, "buttons = LONG_PLUS");          break;
-        case MINUS:             LOG_D(TAG, "buttons = MINUS");              break;
-        case LONG_MINUS:        LOG_D(TAG, "buttons = LONG_MINUS");         break;
-    }
-    
-    switch(_current_state)
-    {
-        case CLOCK_MODE:
-			if(transition == MODE){
-				ChgModeToTimer();
-				_current_state = TIMER_MODE;
-			}
-			else if(transition == LONG_MODE){
-				ChgModeToSetTimer();
-				_current_state = SET_TIMER;
-			}
-			else{
-				NOPE();
-				_current_state = CLOCK_MODE;
-			}
-        	break;
-        
-        case TIMER_MODE:
-			if(transition == MODE){
-				ChgModeToClock();
-				_current_state = CLOCK_MODE;
-			}
-			else if(transition == LONG_MODE){
-				ChgModeToSetTimer();
-				_current_state = SET_TIMER;
-			}
-			else if(transition == PLAY){
-				StartPauseResumeTimer();
-				_current_state = TIMER_MODE;
-			}
-			else if(transition == LONG_PLAY){
-				CancelTimer();
-				_current_state = TIMER_MODE;
-			}
-			else{
-				NOPE();
-				_current_state = TIMER_MODE;
-			}
-        	break;
-    
-        case SET_TIMER:
-			if(transition == MODE){
-				ValidateSetTimer();
-				_current_state = TIMER_MODE;
-			}
-			else if(transition == LONG_MODE){
-				ChgModeToClock();
-				_current_state = CLOCK_MODE;
-			}
-			else if(transition == PLAY ){
-				MoveNextDigit();
-				_current_state = SET_TIMER;
-			}
-			else if(transition == LONG_PLAY ){
-				ValidateSetTimer();
-				_current_state = TIMER_MODE;
-			}
-			else if(transition == PLUS ){
-				IncrementDigit();
-				_current_state = SET_TIMER;
-			}
-			else if(transition == LONG_PLUS ){
-				IncrementQuicklyDigit();
-				_current_state = SET_TIMER;
-			}
-			else if(transition == MINUS ){
-				DecrementDigit();
-				_current_state = SET_TIMER;
-			}
-			else if(transition == LONG_MINUS ){
-				DecrementQuicklyDigit();
-				_current_state = SET_TIMER;
-			}
-			else{
-				NOPE();
-				_current_state = SET_TIMER;
-			}
-			break;
-    }
-
-    if (_previous_state != _current_state) 
-    {
-        _previous_state = _current_state;
-        {
-            switch(_current_state)
-            {
-                case CLOCK_MODE: LOG_D(TAG, "New current state = CLOCK_MODE"); break;
-                case TIMER_MODE: LOG_D(TAG, "New current state = TIMER_MODE"); break;
-                case SET_TIMER:  LOG_D(TAG, "New current state = SET_TIMER");  break;
-            }
-        }
-    }
+	if(_current_state >= STATE_COUNT || transition >= TRANSITION_COUNT)
+	{
+		LOG_E(TAG, "Invalid state %d or transition %d", _current_state, transition);
+		return;
+	}
+	const StateMachineEntry& entry = _stateMachine[_current_state][transition];
+	LOG_D(TAG, "State %d, transition %d -> state %d", _current_state, transition, entry.next);
+	(this->*entry.action)();
+	//the change mode actions already switched, the others only stay or change the state by the table
+	if(_current_state != entry.next)
+	{
+		switchMode(entry.next);
+	}
 }
  
 void ClockState::NOPE()
@@ -577,22 +1111,9 @@ void ClockState::ChgModeToSetTimer()
 void ClockState::ChgModeToClock()
 {
     LOG_D(TAG, "Action: Change Mode To Clock");
-	_PoolClockDisplays->setGlobalBrightness(_clockBrightness);
+	//the brightness of the day or the night is restored with the mode change event
 	switchMode(CLOCK_MODE);
-	float temperature1=0.0;
-	float humidity1=0.0;
-	float temperature2=0.0;
-	float humidity2=0.0;
-	#if AIR_TEMP_SENSOR == true
-		temperature1=_am232x->getTemperature();
-		humidity1=_am232x->getHumidity();
-	#endif
-	#if WATER_TEMP_SENSOR == true
-		temperature2=_DS18B20Sensors->getPreciseTempCByAddress(waterThermometerAddress);
-	#endif
-	#if LCD_SCREEN == true
-		LCDScreen_Clock_Mode(_timeM, temperature1, humidity1, temperature2, humidity2);
-	#endif	
+	refreshLCD();
 }
 
 void ClockState::StartPauseResumeTimer()
@@ -643,13 +1164,9 @@ void ClockState::CancelTimer()
 void ClockState::CancelSetTimer()
 {
     LOG_D(TAG, "Action: Cancel Set Timer");
-	_TimerDuration.hours   = 0;
-	_TimerDuration.minutes = 0;
-	_TimerDuration.seconds = 0;
+	//the changes are dropped, the timer keeps the last validated duration. The clock screen is drawn by the mode change.
+	_TimerDuration = _InitialTimerDuration;
 	_timeM->setTimerDuration(_TimerDuration);
-	#if LCD_SCREEN == true
-		LCDScreen_Timer_Mode(_timeM, _TimerState);
-	#endif	
 }
 
 void ClockState::ValidateSetTimer()
@@ -659,6 +1176,7 @@ void ClockState::ValidateSetTimer()
 	_timeM->setTimerDuration(_TimerDuration);
 	_InitialTimerDuration = _TimerDuration;
 	_TimerState = STOPPED;
+	saveSettingsLater();
 	#if LCD_SCREEN == true
 		LCDScreen_Timer_Mode(_timeM, _TimerState);
 	#endif	
@@ -679,10 +1197,7 @@ void ClockState::MoveNextDigit()
 		_lcd_blinking_digit=LowHour;
 	}
 	_timeM->setTimerDuration(_TimerDuration);
-	#if LCD_SCREEN == true
-		LOG_D(TAG, "LCDScreen_Set_Timer from MoveNextDigit - cursor on: %d", _lcd_blinking_digit);
-		LCDScreen_Set_Timer(_timeM, _lcd_blinking_digit);  
-	#endif	
+	_lcdDirty = true;
 }
 
 void ClockState::IncrementDigit()
@@ -699,30 +1214,26 @@ void ClockState::IncrementDigit()
 		_lcd_blinking_digit=LowMinute;
 	}
 	_timeM->setTimerDuration(_TimerDuration);
-	#if LCD_SCREEN == true
-		LOG_D(TAG, "LCDScreen_Set_Timer from IncrementDigit - cursor on: %d", _lcd_blinking_digit);
-		LCDScreen_Set_Timer(_timeM, _lcd_blinking_digit);  
-	#endif	
+	_lcdDirty = true;
 }
 
 void ClockState::IncrementQuicklyDigit()
 {
-    LOG_D(TAG, "Action: Increment Quickly Digit");
-		if (_CurrentTimerDigit == HOUR_DIGIT)  {
-		_TimerDuration.hours = _TimerDuration.hours + 10;
+	uint8_t step = getAutoRepeatStep();
+    LOG_D(TAG, "Action: Increment Quickly Digit by %d", step);
+	if (_CurrentTimerDigit == HOUR_DIGIT)  {
+		_TimerDuration.hours++;
 		if (_TimerDuration.hours >= 24) _TimerDuration.hours = 0;
-		_lcd_blinking_digit=HighHour;
+		_lcd_blinking_digit=LowHour;
 	}
 	else {
-		_TimerDuration.minutes = _TimerDuration.minutes + 10;
+		//to the next multiple of the step, so that 45 minutes are reached from 37
+		_TimerDuration.minutes = (_TimerDuration.minutes / step + 1) * step;
 		if (_TimerDuration.minutes >= 60) _TimerDuration.minutes = 0;
-		_lcd_blinking_digit=HighMinute;
+		_lcd_blinking_digit = step >= 10 ? HighMinute : LowMinute;
 	}
 	_timeM->setTimerDuration(_TimerDuration);
-	#if LCD_SCREEN == true
-		LOG_D(TAG, "LCDScreen_Set_Timer from IncrementQuicklyDigit - cursor on: %d", _lcd_blinking_digit);
-		LCDScreen_Set_Timer(_timeM, _lcd_blinking_digit);  
-	#endif	
+	_lcdDirty = true;
 }
 
 void ClockState::DecrementDigit()
@@ -737,80 +1248,55 @@ void ClockState::DecrementDigit()
 		_lcd_blinking_digit=LowMinute;
 	}
 	_timeM->setTimerDuration(_TimerDuration);
-	#if LCD_SCREEN == true
-		LOG_D(TAG, "LCDScreen_Set_Timer from DecrementDigit - cursor on: %d", _lcd_blinking_digit);
-		LCDScreen_Set_Timer(_timeM, _lcd_blinking_digit);  
-	#endif	
+	_lcdDirty = true;
 }
 
 void ClockState::DecrementQuicklyDigit()
 {
-    LOG_D(TAG, "Action: Decrement Quickly Digit");
+	uint8_t step = getAutoRepeatStep();
+    LOG_D(TAG, "Action: Decrement Quickly Digit by %d", step);
 	if (_CurrentTimerDigit == HOUR_DIGIT)  {
-		if (_TimerDuration.hours >= 10) _TimerDuration.hours = _TimerDuration.hours -10;
-		else _TimerDuration.hours = 0;
-		_lcd_blinking_digit=HighHour;
+		if (_TimerDuration.hours > 0) _TimerDuration.hours--;
+		_lcd_blinking_digit=LowHour;
 	}
 	else {
-		if (_TimerDuration.minutes >= 10) _TimerDuration.minutes = _TimerDuration.minutes -10;
+		//to the previous multiple of the step
+		uint8_t remainder = _TimerDuration.minutes % step;
+		if (remainder > 0) _TimerDuration.minutes = _TimerDuration.minutes - remainder;
+		else if (_TimerDuration.minutes >= step) _TimerDuration.minutes = _TimerDuration.minutes - step;
 		else _TimerDuration.minutes = 0;
-		_lcd_blinking_digit=HighMinute;
+		_lcd_blinking_digit = step >= 10 ? HighMinute : LowMinute;
 	}
 	_timeM->setTimerDuration(_TimerDuration);
-	#if LCD_SCREEN == true
-		LOG_D(TAG, "LCDScreen_Set_Timer from DecrementQuicklyDigit - cursor on: %d", _lcd_blinking_digit);
-		LCDScreen_Set_Timer(_timeM, _lcd_blinking_digit);  
-	#endif	
+	_lcdDirty = true;
 }
 
-Transitions_enum ClockState::read_buttons()
+/**
+ * \brief Step of the minutes for the current auto-repeat of a held PLUS or MINUS, 1 for the long press itself
+ */
+uint8_t ClockState::getAutoRepeatStep()
 {
-    //code for reading buttons
-    _ModeButton->read();
-	_PlayButton->read();
-	_PlusButton->read();
-	_MinusButton->read();
-    
-    print_button_state("MODE ", _Mode_button_state);
-    if      (_Mode_button_state == PRESSED)      { _Mode_button_state = NOT_PRESSED; return MODE; }
-    else if (_Mode_button_state == LONG_PRESSED) { _Mode_button_state = NOT_PRESSED; return LONG_MODE; }
-
-    print_button_state("PLAY ", _Play_button_state);
-    if      (_Play_button_state == PRESSED)      { _Play_button_state = NOT_PRESSED; return PLAY; }
-    else if (_Play_button_state == LONG_PRESSED) { _Play_button_state = NOT_PRESSED; return LONG_PLAY; }
-
-    print_button_state("PLUS ", _Plus_button_state);
-    if      (_Plus_button_state == PRESSED)      { _Plus_button_state = NOT_PRESSED; return PLUS; }
-    else if (_Plus_button_state == LONG_PRESSED) { _Plus_button_state = NOT_PRESSED; return LONG_PLUS; }
-
-    print_button_state("MINUS", _Minus_button_state);
-    if      (_Minus_button_state == PRESSED)      { _Minus_button_state = NOT_PRESSED; return MINUS; }
-    else if (_Minus_button_state == LONG_PRESSED) { _Minus_button_state = NOT_PRESSED; return LONG_MINUS; }
-
-    return NONE;
+	if(_buttonRepeat >= AUTO_REPEAT_STEP10_AFTER)
+	{
+		return 10;
+	}
+	if(_buttonRepeat >= AUTO_REPEAT_STEP5_AFTER)
+	{
+		return 5;
+	}
+	return 1;
 }
 
-/**
- * @brief Print the state of a push button
- * 
- * @param button_name  : name of the button
- * @param button_state : state of the button
- */
-void ClockState::print_button_state(const char* button_name, Button_State_enum button_state) 
+void ClockState::DismissNotification()
 {
-    const char* state_not_pressed           = "NOT_PRESSED";
-    const char* state_pressed               = "PRESSED";
-    const char* state_long_pressed          = "LONG_PRESSED";
- 
-#if DEBUG == false
-    switch(button_state)
-    {
-        case NOT_PRESSED:          LOG_V(TAG, "button = %s   status= %s", button_name, state_not_pressed);          break;
-        case PRESSED:              LOG_D(TAG, "button = %s - status= %s", button_name, state_pressed);              break;
-        case LONG_PRESSED:         LOG_D(TAG, "button = %s - status= %s", button_name, state_long_pressed);         break;
-    }
-#endif
+    LOG_D(TAG, "Action: Dismiss Notification");
+	if(_current_state == ALARM_NOTIFICATION)
+	{
+		_timeM->clearAlarm();
+	}
+	//the table switches back to the clock, which stops the flashing
 }
+
 /**
  * \brief Notify the Blynk thread that a UI update is needed.
  *        What exactly needs to be updated will be figured out in the thread loop itself.
@@ -856,8 +1342,9 @@ BLYNK_CONNECTED()
  */
 BLYNK_WRITE(BLYNK_CHANNEL_BRIGHTNESS_SLIDER)
 {
-	ClockState::_clockBrightness = param[0].asInt();
-	ClockState::_PoolClockDisplays->setGlobalBrightness(ClockState::_clockBrightness);
+	ClockState* ClockS = ClockState::getInstance();
+	ClockS->_clockBrightness = param[0].asInt();
+	ClockS->postEvent(EVENT_SETTINGS_CHANGED);
 }
 
 /**
@@ -866,45 +1353,50 @@ BLYNK_WRITE(BLYNK_CHANNEL_BRIGHTNESS_SLIDER)
  */
 BLYNK_WRITE(BLYNK_CHANNEL_LIGHT_GROUP_SELECTOR)
 {
+	ClockState* ClockS = ClockState::getInstance();
 	switch (param.asInt())
 	{
 	case 1:
-		_ColorSelection = ClockState::CHANGE_HOURS_COLOR;
-		Blynk.virtualWrite(BLYNK_CHANNEL_CURRENT_COLOR_PICKER, _HourColor.r, _HourColor.g, _HourColor.b);
+		ClockS->_ColorSelection = ClockState::CHANGE_HOURS_COLOR;
+		Blynk.virtualWrite(BLYNK_CHANNEL_CURRENT_COLOR_PICKER, ClockS->_HourColor.r, ClockS->_HourColor.g, ClockS->_HourColor.b);
 		break;
 	case 2:
-		_ColorSelection = ClockState::CHANGE_MINUTES_COLOR;
-		Blynk.virtualWrite(BLYNK_CHANNEL_CURRENT_COLOR_PICKER, _MinuteColor.r, _MinuteColor.g, _MinuteColor.b);
+		ClockS->_ColorSelection = ClockState::CHANGE_MINUTES_COLOR;
+		Blynk.virtualWrite(BLYNK_CHANNEL_CURRENT_COLOR_PICKER, ClockS->_MinuteColor.r, ClockS->_MinuteColor.g, ClockS->_MinuteColor.b);
 		break;
 	case 3:
-		_ColorSelection = ClockState::CHANGE_INTERIOR_COLOR;
-		Blynk.virtualWrite(BLYNK_CHANNEL_CURRENT_COLOR_PICKER, _InternalColor.r, _InternalColor.g, _InternalColor.b);
+		ClockS->_ColorSelection = ClockState::CHANGE_INTERIOR_COLOR;
+		Blynk.virtualWrite(BLYNK_CHANNEL_CURRENT_COLOR_PICKER, ClockS->_InternalColor.r, ClockS->_InternalColor.g, ClockS->_InternalColor.b);
 		break;
 	case 4:
-		_ColorSelection = ClockState::CHANGE_DOT_COLOR;
-		Blynk.virtualWrite(BLYNK_CHANNEL_CURRENT_COLOR_PICKER, _DotColor.r, _DotColor.g, _DotColor.b);
+		ClockS->_ColorSelection = ClockState::CHANGE_DOT_COLOR;
+		Blynk.virtualWrite(BLYNK_CHANNEL_CURRENT_COLOR_PICKER, ClockS->_DotColor.r, ClockS->_DotColor.g, ClockS->_DotColor.b);
 		break;
 	}
 }
 
 BLYNK_WRITE(BLYNK_CHANNEL_SELECTOR_HOURS)
 {
-	changeSelection(ClockState::CHANGE_HOURS_COLOR, param.asInt());
+	ClockState* ClockS = ClockState::getInstance();
+	ClockS->changeSelection(ClockState::CHANGE_HOURS_COLOR, param.asInt());
 }
 
 BLYNK_WRITE(BLYNK_CHANNEL_SELECTOR_MINUTES)
 {
-	changeSelection(ClockState::CHANGE_MINUTES_COLOR, param.asInt());
+	ClockState* ClockS = ClockState::getInstance();
+	ClockS->changeSelection(ClockState::CHANGE_MINUTES_COLOR, param.asInt());
 }
 
 BLYNK_WRITE(BLYNK_CHANNEL_SELECTOR_INTERIOR)
 {
-	changeSelection(ClockState::CHANGE_INTERIOR_COLOR, param.asInt());
+	ClockState* ClockS = ClockState::getInstance();
+	ClockS->changeSelection(ClockState::CHANGE_INTERIOR_COLOR, param.asInt());
 }
 
 BLYNK_WRITE(BLYNK_CHANNEL_SELECTOR_DOT)
 {
-	changeSelection(ClockState::CHANGE_DOT_COLOR, param.asInt());
+	ClockState* ClockS = ClockState::getInstance();
+	ClockS->changeSelection(ClockState::CHANGE_DOT_COLOR, param.asInt());
 }
 
 /**
@@ -913,34 +1405,39 @@ BLYNK_WRITE(BLYNK_CHANNEL_SELECTOR_DOT)
  */
 BLYNK_WRITE(BLYNK_CHANNEL_CURRENT_COLOR_PICKER)
 {
+	ClockState* ClockS = ClockState::getInstance();
 	CRGB currentColor;
 	currentColor.r  = param[0].asInt();
 	currentColor.g  = param[1].asInt();
 	currentColor.b  = param[2].asInt();
-	if(_ColorSelection & ClockState::CHANGE_HOURS_COLOR)
+	//all selected light groups change together in one scheme
+	ColorScheme scheme = DisplayManager::getInstance()->getColorScheme();
+	if(ClockS->_ColorSelection & ClockState::CHANGE_HOURS_COLOR)
 	{
-		_PoolClockDisplays->setHourSegmentColors(currentColor);
+		scheme.hour = currentColor;
 		Blynk.virtualWrite(BLYNK_CHANNEL_HOUR_COLOR_SAVE, currentColor.r, currentColor.g, currentColor.b);
-		_HourColor = currentColor;
+		ClockS->_HourColor = currentColor;
 	}
-	if(_ColorSelection & ClockState::CHANGE_MINUTES_COLOR)
+	if(ClockS->_ColorSelection & ClockState::CHANGE_MINUTES_COLOR)
 	{
-		_PoolClockDisplays->setMinuteSegmentColors(currentColor);
+		scheme.minute = currentColor;
 		Blynk.virtualWrite(BLYNK_CHANNEL_MINUTE_COLOR_SAVE, currentColor.r, currentColor.g, currentColor.b);
-		_MinuteColor = currentColor;
+		ClockS->_MinuteColor = currentColor;
 	}
-	if(_ColorSelection & ClockState::CHANGE_INTERIOR_COLOR)
+	if(ClockS->_ColorSelection & ClockState::CHANGE_INTERIOR_COLOR)
 	{
-		_PoolClockDisplays->setInternalLEDColor(currentColor);
+		scheme.internal = currentColor;
 		Blynk.virtualWrite(BLYNK_CHANNEL_INTERNAL_COLOR_SAVE, currentColor.r, currentColor.g, currentColor.b);
-		_InternalColor = currentColor;
+		ClockS->_InternalColor = currentColor;
 	}
-	if(_ColorSelection & ClockState::CHANGE_DOT_COLOR)
+	if(ClockS->_ColorSelection & ClockState::CHANGE_DOT_COLOR)
 	{
-		_PoolClockDisplays->setDotLEDColor(currentColor);
+		scheme.dot = currentColor;
 		Blynk.virtualWrite(BLYNK_CHANNEL_DOT_COLOR_SAVE, currentColor.r, currentColor.g, currentColor.b);
-		_DotColor = currentColor;
+		ClockS->_DotColor = currentColor;
 	}
+	DisplayManager::getInstance()->setColorScheme(scheme, COLOR_CHANGE_CROSSFADE);
+	ClockS->postEvent(EVENT_SETTINGS_CHANGED);
 }
 
 /**
@@ -950,12 +1447,13 @@ BLYNK_WRITE(BLYNK_CHANNEL_CURRENT_COLOR_PICKER)
  */
 BLYNK_WRITE(BLYNK_CHANNEL_HOUR_COLOR_SAVE)
 {
+	ClockState* ClockS = ClockState::getInstance();
 	CRGB SavedColor;
 	SavedColor.r  = param[0].asInt();
 	SavedColor.g  = param[1].asInt();
 	SavedColor.b  = param[2].asInt();
-	_PoolClockDisplays->setHourSegmentColors(SavedColor);
-	_HourColor = SavedColor;
+	DisplayManager::getInstance()->setHourSegmentColors(SavedColor);
+	ClockS->_HourColor = SavedColor;
 }
 
 /**
@@ -965,12 +1463,13 @@ BLYNK_WRITE(BLYNK_CHANNEL_HOUR_COLOR_SAVE)
  */
 BLYNK_WRITE(BLYNK_CHANNEL_MINUTE_COLOR_SAVE)
 {
+	ClockState* ClockS = ClockState::getInstance();
 	CRGB SavedColor;
 	SavedColor.r  = param[0].asInt();
 	SavedColor.g  = param[1].asInt();
 	SavedColor.b  = param[2].asInt();
-	_PoolClockDisplays->setMinuteSegmentColors(SavedColor);
-	_MinuteColor = SavedColor;
+	DisplayManager::getInstance()->setMinuteSegmentColors(SavedColor);
+	ClockS->_MinuteColor = SavedColor;
 }
 
 /**
@@ -980,12 +1479,13 @@ BLYNK_WRITE(BLYNK_CHANNEL_MINUTE_COLOR_SAVE)
  */
 BLYNK_WRITE(BLYNK_CHANNEL_INTERNAL_COLOR_SAVE)
 {
+	ClockState* ClockS = ClockState::getInstance();
 	CRGB SavedColor;
 	SavedColor.r  = param[0].asInt();
 	SavedColor.g  = param[1].asInt();
 	SavedColor.b  = param[2].asInt();
-	_PoolClockDisplays->setInternalLEDColor(SavedColor);
-	_InternalColor = SavedColor;
+	DisplayManager::getInstance()->setInternalLEDColor(SavedColor);
+	ClockS->_InternalColor = SavedColor;
 }
 
 /**
@@ -995,12 +1495,13 @@ BLYNK_WRITE(BLYNK_CHANNEL_INTERNAL_COLOR_SAVE)
  */
 BLYNK_WRITE(BLYNK_CHANNEL_DOT_COLOR_SAVE)
 {
+	ClockState* ClockS = ClockState::getInstance();
 	CRGB SavedColor;
 	SavedColor.r  = param[0].asInt();
 	SavedColor.g  = param[1].asInt();
 	SavedColor.b  = param[2].asInt();
-	_PoolClockDisplays->setDotLEDColor(SavedColor);
-	_DotColor = SavedColor;
+	DisplayManager::getInstance()->setDotLEDColor(SavedColor);
+	ClockS->_DotColor = SavedColor;
 }
 
 /**
@@ -1009,6 +1510,7 @@ BLYNK_WRITE(BLYNK_CHANNEL_DOT_COLOR_SAVE)
  */
 BLYNK_WRITE(BLYNK_CHANNEL_TIMER_TIME_INPUT)
 {
+	TimeManager* TimeM = TimeManager::getInstance();
 	TimeManager::TimeInfo TimerDuration;
 	TimeInputParam t(param);
 	TimerDuration.hours = t.getStartHour();
@@ -1024,19 +1526,20 @@ BLYNK_WRITE(BLYNK_CHANNEL_TIMER_TIME_INPUT)
  */
 BLYNK_WRITE(BLYNK_CHANNEL_TIMER_START_BUTTON)
 {
+	TimeManager* TimeM = TimeManager::getInstance();
+	ClockState* ClockS = ClockState::getInstance();
 	if(param[0].asInt() == 1)
 	{
 		TimeM->startTimer();
 		LOG_D(TAG, "Timer Started");
-		ClockS->switchMode(ClockState::TIMER_MODE);
+		ClockS->postEvent(EVENT_TIMER_STARTED);
 	}
 	else
 	{
 		TimeM->stopTimer();
 		LOG_D(TAG, "Timer Stopped");
 		Blynk.syncVirtual(BLYNK_CHANNEL_TIMER_TIME_INPUT);
-		_PoolClockDisplays->setGlobalBrightness(ClockS->_clockBrightness);
-		ClockS->switchMode(ClockState::CLOCK_MODE);
+		ClockS->postEvent(EVENT_TIMER_STOPPED);
 	}
 }
 
@@ -1046,6 +1549,7 @@ BLYNK_WRITE(BLYNK_CHANNEL_TIMER_START_BUTTON)
  */
 BLYNK_WRITE(BLYNK_CHANNEL_NIGHT_MODE_TIME_INPUT)
 {
+	ClockState* ClockS = ClockState::getInstance();
 	TimeInputParam t(param);
 	ClockS->_NightModeStartTime.hours = t.getStartHour();
 	ClockS->_NightModeStartTime.minutes = t.getStartMinute();
@@ -1053,6 +1557,7 @@ BLYNK_WRITE(BLYNK_CHANNEL_NIGHT_MODE_TIME_INPUT)
 	ClockS->_NightModeStopTime.hours = t.getStopHour();
 	ClockS->_NightModeStopTime.minutes = t.getStopMinute();
 	ClockS->_NightModeStopTime.seconds = t.getStopSecond();
+	ClockS->postEvent(EVENT_SETTINGS_CHANGED);
 }
 
 /**
@@ -1061,11 +1566,9 @@ BLYNK_WRITE(BLYNK_CHANNEL_NIGHT_MODE_TIME_INPUT)
  */
 BLYNK_WRITE(BLYNK_CHANNEL_NIGHT_MODE_BRIGHTNESS)
 {
+	ClockState* ClockS = ClockState::getInstance();
 	ClockS->_nightModeBrightness = param[0].asInt();
-	if(TimeM->isInBetween(ClockS->_NightModeStartTime, ClockS->_NightModeStopTime))
-	{
-		_PoolClockDisplays->setGlobalBrightness(ClockS->_nightModeBrightness);
-	}
+	ClockS->postEvent(EVENT_SETTINGS_CHANGED);
 }
 
 /**
@@ -1074,7 +1577,9 @@ BLYNK_WRITE(BLYNK_CHANNEL_NIGHT_MODE_BRIGHTNESS)
  */
 BLYNK_WRITE(BLYNK_CHANNEL_NUM_SEPARATION_DOTS)
 {
+	ClockState* ClockS = ClockState::getInstance();
 	ClockS->_numDots = param[0].asInt() - 1;
+	ClockS->postEvent(EVENT_SETTINGS_CHANGED);
 }
 
 /**
@@ -1083,6 +1588,7 @@ BLYNK_WRITE(BLYNK_CHANNEL_NUM_SEPARATION_DOTS)
  */
 BLYNK_WRITE(BLYNK_CHANNEL_ALARM_TIME_INPUT)
 {
+	TimeManager* TimeM = TimeManager::getInstance();
 	TimeInputParam t(param);
 	TimeManager::TimeInfo AlarmTime
 	{
@@ -1107,16 +1613,18 @@ BLYNK_WRITE(BLYNK_CHANNEL_ALARM_TIME_INPUT)
  */
 BLYNK_WRITE(BLYNK_CHANNEL_ALARM_START_BUTTON)
 {
-	if(ClockS->getMode() == ClockState::ALARM_NOTIFICATION)
+	TimeManager* TimeM = TimeManager::getInstance();
+	ClockState* ClockS = ClockState::getInstance();
+	if(ClockS->getMode() == ALARM_NOTIFICATION)
 	{
 		Blynk.setProperty(BLYNK_CHANNEL_ALARM_START_BUTTON, "onLabel", "Deactivate");
 		TimeM->clearAlarm();
 		Blynk.virtualWrite(BLYNK_CHANNEL_ALARM_START_BUTTON, 1);
-		_isClearAction = true;
+		ClockS->_isClearAction = true;
 	}
-	else if(_isClearAction == true)
+	else if(ClockS->_isClearAction == true)
 	{
-		_isClearAction = false;
+		ClockS->_isClearAction = false;
 	}
 	else
 	{
@@ -0,0 +1,95 @@
+/**
+ * \file BrightnessRamp.h
+ * \author Yves Gaignard
+ * \brief Perceptual brightness ramp used by the DisplayManager to smooth all brightness changes
+ */
+
+#ifndef __BRIGHTNESS_RAMP_H_
+#define __BRIGHTNESS_RAMP_H_
+
+#include <Arduino.h>
+#include <array>
+
+/**
+ * \brief CIE 1976 lightness (L*) scaled to 0..255 into FastLED brightness (linear luminance, 0..255)
+ */
+constexpr uint8_t lightnessToBrightness(uint8_t lightness)
+{
+	double l = lightness * 100.0 / 255.0;
+	double y = l <= 8 ? l / 903.3 : ((l + 16) / 116) * ((l + 16) / 116) * ((l + 16) / 116);
+	return (uint8_t)(y * 255 + 0.5);
+}
+
+/**
+ * \brief Computes the FastLED brightness of every L* value
+ */
+constexpr std::array<uint8_t, 256> computeBrightnessTable()
+{
+	std::array<uint8_t, 256> table{};
+	for (uint16_t i = 0; i < 256; i++)
+	{
+		table[i] = lightnessToBrightness(i);
+	}
+	return table;
+}
+
+/**
+ * \brief Ramps the LED brightness towards a target in fixed point.
+ *        The ramp runs linearly on the CIE L* scale, which the eye perceives as an even fade, and is mapped to the
+ *        linear FastLED brightness through a table computed at compile time.
+ *        A new target does not restart the ramp from a fixed start point: it continues from the current value, so
+ *        overlapping requests (night mode, light sensor, ...) merge into one continuous ramp.
+ */
+class BrightnessRamp
+{
+private:
+	/** FastLED brightness of every L* value */
+	static constexpr std::array<uint8_t, 256> BrightnessTable = computeBrightnessTable();
+
+	uint16_t currentLightness;	/** current L* in 8.8 fixed point */
+	uint16_t targetLightness;	/** L* the ramp is heading to, in 8.8 fixed point */
+	uint16_t rate;				/** L* change per ms in 8.8 fixed point */
+	uint8_t targetBrightness;	/** brightness the ramp ends on, returned unchanged once the target is reached */
+	uint8_t output;
+	unsigned long lastAdvance;
+	uint16_t duration;
+
+	static uint16_t brightnessToLightness(uint8_t brightness);
+
+public:
+	/**
+	 * \brief Construct a new Brightness Ramp object
+	 * \param rampDuration time in ms a ramp takes to reach a new target, whatever the distance to it
+	 */
+	BrightnessRamp(uint16_t rampDuration);
+
+	/**
+	 * \brief Sets a new target brightness. The ramp continues from the current brightness and reaches the target after the ramp duration.
+	 * \param brightness FastLED brightness to ramp to
+	 * \param now current time in ms
+	 */
+	void setTarget(uint8_t brightness, unsigned long now);
+
+	/**
+	 * \brief Sets the brightness immediately without a ramp
+	 */
+	void jumpTo(uint8_t brightness, unsigned long now);
+
+	/**
+	 * \brief Advances the ramp to the given time. Should be called once per rendered frame.
+	 *        A time before the one of the last call does not move the ramp.
+	 */
+	void advance(unsigned long now);
+
+	/**
+	 * \brief Returns the FastLED brightness of the current ramp position
+	 */
+	uint8_t getBrightness() const;
+
+	/**
+	 * \brief Returns true while the ramp has not reached its target
+	 */
+	bool isRamping() const;
+};
+
+#endif
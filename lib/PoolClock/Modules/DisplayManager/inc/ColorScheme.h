@@ -0,0 +1,86 @@
+/**
+ * \file ColorScheme.h
+ * \author Yves Gaignard
+ * \brief Colors of all light groups of the clock, applied together by the DisplayManager
+ */
+
+#ifndef __COLOR_SCHEME_H_
+#define __COLOR_SCHEME_H_
+
+#include <Arduino.h>
+#include "Configuration.h"
+#define FASTLED_INTERNAL
+#include "FastLED.h"
+
+/**
+ * \brief Color of every light group. The DisplayManager applies a whole scheme in one pass at the beginning of a
+ *        frame, so a frame never shows some groups in the old and others in the new colors.
+ */
+struct ColorScheme
+{
+	CRGB hour;
+	CRGB minute;
+	CRGB temp1;
+	CRGB temp2;
+	CRGB internal;
+	CRGB dot;
+
+	/**
+	 * \brief The default colors from \ref DisplayConfiguration.h
+	 */
+	static ColorScheme fromConfiguration()
+	{
+		return {HOUR_COLOR, MINUTE_COLOR, TEMP1_COLOR, TEMP2_COLOR, INTERNAL_COLOR, SEPARATION_DOT_COLOR};
+	}
+
+	/**
+	 * \brief The same color for all light groups
+	 */
+	static ColorScheme uniform(CRGB color)
+	{
+		return {color, color, color, color, color, color};
+	}
+
+	/**
+	 * \brief Fixed point blend between two schemes
+	 * \param amountOfTo 0 returns from, 255 returns almost to
+	 */
+	static ColorScheme blend(const ColorScheme& from, const ColorScheme& to, fract8 amountOfTo)
+	{
+		return {::blend(from.hour, to.hour, amountOfTo), ::blend(from.minute, to.minute, amountOfTo),
+		        ::blend(from.temp1, to.temp1, amountOfTo), ::blend(from.temp2, to.temp2, amountOfTo),
+		        ::blend(from.internal, to.internal, amountOfTo), ::blend(from.dot, to.dot, amountOfTo)};
+	}
+
+	/**
+	 * \brief Color of the segments of the given display
+	 */
+	CRGB forDisplay(uint8_t display) const
+	{
+		#if DISPLAY_FOR_SEPARATION_DOT > -1
+			if(display == DISPLAY_FOR_SEPARATION_DOT)
+			{
+				return dot;
+			}
+		#endif
+		switch (display)
+		{
+			case HIGHER_DIGIT_HOUR_DISPLAY:
+			case LOWER_DIGIT_HOUR_DISPLAY:
+				return hour;
+			case HIGHER_DIGIT_MINUTE_DISPLAY:
+			case LOWER_DIGIT_MINUTE_DISPLAY:
+				return minute;
+			case HIGHER_DIGIT_TEMP1_DISPLAY:
+			case LOWER_DIGIT_TEMP1_DISPLAY:
+				return temp1;
+			case HIGHER_DIGIT_TEMP2_DISPLAY:
+			case LOWER_DIGIT_TEMP2_DISPLAY:
+				return temp2;
+			default:
+				return dot;
+		}
+	}
+};
+
+#endif
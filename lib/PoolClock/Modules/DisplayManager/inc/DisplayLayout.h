@@ -0,0 +1,343 @@
+/**
+ * \file DisplayLayout.h
+ * \author Yves Gaignard
+ * \brief Compile time description of the LED layout. The layout from \ref DisplayLayoutConfiguration.h is evaluated
+ *        here: LED offsets of every segment are computed and the whole configuration is validated by the compiler.
+ */
+
+#ifndef __DISPLAY_LAYOUT_H_
+#define __DISPLAY_LAYOUT_H_
+
+#include <Arduino.h>
+#include <array>
+#include "Configuration.h"
+#include "Segment.h"
+#include "SevenSegment.h"
+
+namespace DisplayLayout {
+
+/**
+ * \brief Description of one seven segment display
+ */
+struct DisplayDescription {
+	SevenSegment::SevenSegmentMode mode;	/** which segments the display is made of */
+	SevenSegment::SevenSegmentSize size;	/** defines the number of LEDs of each segment of the display */
+};
+
+/**
+ * \brief Description of one segment, in the order in which the segments are wired
+ */
+struct SegmentDescription {
+	DisplayIDs display;						/** display the segment belongs to */
+	SevenSegment::SegmentPosition position;	/** position of the segment within its display */
+	Segment::direction direction;			/** direction in which the LEDs of the segment are wired */
+};
+
+/**
+ * \brief Description of one independently wired LED strip
+ */
+struct StripDescription {
+	uint8_t pin;							/** data pin of the strip */
+	DisplayIDs firstDisplay;				/** display whose first segment is the first one on the strip */
+};
+
+} // namespace DisplayLayout
+
+#include "DisplayLayoutConfiguration.h"
+
+namespace DisplayLayout {
+
+/**
+ * \brief Number of LEDs of a segment of the given size
+ */
+constexpr uint8_t ledsPerSegment(SevenSegment::SevenSegmentSize size)
+{
+	return size == SevenSegment::LONG_SEGMENT  ? NUM_LEDS_PER_LONG_SEGMENT :
+	       size == SevenSegment::SHORT_SEGMENT ? NUM_LEDS_PER_SHORT_SEGMENT :
+	                                             NUM_LEDS_PER_DOT_SEGMENT;
+}
+
+/**
+ * \brief Number of LEDs of the segment with the given index
+ */
+constexpr uint8_t segmentLength(uint16_t segment)
+{
+	return ledsPerSegment(Displays[Segments[segment].display].size);
+}
+
+/**
+ * \brief Computes the index of the first LED of every segment. The last entry is the total number of segment LEDs.
+ */
+constexpr std::array<uint16_t, NUM_SEGMENTS + 1> computeLedOffsets()
+{
+	std::array<uint16_t, NUM_SEGMENTS + 1> offsets{};
+	for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
+	{
+		offsets[i + 1] = offsets[i] + segmentLength(i);
+	}
+	return offsets;
+}
+
+/**
+ * \brief Index of the first LED of every segment in the LED string
+ */
+inline constexpr std::array<uint16_t, NUM_SEGMENTS + 1> LedOffsets = computeLedOffsets();
+
+/**
+ * \brief Index of the first LED of the segment with the given index
+ */
+constexpr uint16_t firstLedOfSegment(uint16_t segment)
+{
+	return LedOffsets[segment];
+}
+
+/**
+ * \brief Number of LEDs used by all segments together
+ */
+inline constexpr uint16_t NumSegmentLeds = LedOffsets[NUM_SEGMENTS];
+
+/**
+ * \brief Number of segments which belong to displays of the given size
+ */
+constexpr uint16_t countSegmentsOfSize(SevenSegment::SevenSegmentSize size)
+{
+	uint16_t count = 0;
+	for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
+	{
+		if(Displays[Segments[i].display].size == size)
+		{
+			count++;
+		}
+	}
+	return count;
+}
+
+/**
+ * \brief Checks that every segment references an existing display
+ */
+constexpr bool segmentDisplaysAreValid()
+{
+	for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
+	{
+		if(Segments[i].display >= NUM_DISPLAYS)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * \brief Checks that no position is wired twice within one display
+ */
+constexpr bool noPositionIsWiredTwice()
+{
+	for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
+	{
+		for (uint16_t j = i + 1; j < NUM_SEGMENTS; j++)
+		{
+			if(Segments[i].display == Segments[j].display && Segments[i].position == Segments[j].position)
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * \brief Checks that every display has exactly the segments its #SevenSegment::SevenSegmentMode requires
+ */
+constexpr bool displaysAreComplete()
+{
+	for (uint8_t d = 0; d < NUM_DISPLAYS; d++)
+	{
+		uint8_t wired = 0;
+		for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
+		{
+			if(Segments[i].display == d)
+			{
+				wired |= Segments[i].position;
+			}
+		}
+		uint8_t required = Displays[d].mode == SevenSegment::TWO_VERTICAL_SEGMENTS ?
+		                   (SevenSegment::RightTopSegment | SevenSegment::RightBottomSegment) : 0x7F;
+		if(wired != required)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * \brief Computes the index of the segment at every position of every display, or #NO_SEGMENTS if the position is not wired
+ */
+constexpr std::array<std::array<int16_t, 7>, NUM_DISPLAYS> computeSegmentIndexTable()
+{
+	std::array<std::array<int16_t, 7>, NUM_DISPLAYS> table{};
+	for (uint8_t d = 0; d < NUM_DISPLAYS; d++)
+	{
+		for (uint8_t p = 0; p < 7; p++)
+		{
+			table[d][p] = NO_SEGMENTS;
+		}
+	}
+	for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
+	{
+		for (uint8_t p = 0; p < 7; p++)
+		{
+			if(Segments[i].display < NUM_DISPLAYS && Segments[i].position == (1 << p))
+			{
+				table[Segments[i].display][p] = i;
+			}
+		}
+	}
+	return table;
+}
+
+/**
+ * \brief Index of the segment at every position of every display
+ */
+inline constexpr std::array<std::array<int16_t, 7>, NUM_DISPLAYS> SegmentIndexTable = computeSegmentIndexTable();
+
+/**
+ * \brief Index of the segment at the given position of the given display
+ * \return int16_t index of the Segment in the #DisplayLayout::Segments array or #NO_SEGMENTS if there is none
+ */
+constexpr int16_t segmentIndex(SegmentPositions_t segmentPosition, DisplayIDs display)
+{
+	return (display < NUM_DISPLAYS && segmentPosition < 7) ? SegmentIndexTable[display][segmentPosition] : NO_SEGMENTS;
+}
+
+/**
+ * \brief Segment index resolved at compile time. Referencing a segment which is not wired fails the build.
+ */
+template<SegmentPositions_t segmentPosition, DisplayIDs display>
+struct SegmentIndex
+{
+	static_assert(display < NUM_DISPLAYS, "SEGMENT(): the display does not exist, see DisplayIDs");
+	static_assert(segmentIndex(segmentPosition, display) != NO_SEGMENTS, "SEGMENT(): no segment is wired at this position of this display, see DisplayLayoutConfiguration.h");
+	static constexpr int16_t value = segmentIndex(segmentPosition, display);
+};
+
+/**
+ * \brief Index of the first segment of the given strip, #NUM_SEGMENTS if no segment belongs to its first display
+ */
+constexpr uint16_t firstSegmentOfStrip(uint8_t strip)
+{
+	for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
+	{
+		if(Segments[i].display == Strips[strip].firstDisplay)
+		{
+			return i;
+		}
+	}
+	return NUM_SEGMENTS;
+}
+
+/**
+ * \brief Index of the first LED of the given strip in the LED buffer
+ */
+constexpr uint16_t firstLedOfStrip(uint8_t strip)
+{
+	return LedOffsets[firstSegmentOfStrip(strip)];
+}
+
+/**
+ * \brief Number of LEDs of the given strip. The last strip also drives the LEDs appended after the segments.
+ */
+constexpr uint16_t stripLength(uint8_t strip)
+{
+	return (strip + 1 < NUM_LED_STRIPS ? firstLedOfStrip(strip + 1) : (NUM_LEDS)) - firstLedOfStrip(strip);
+}
+
+/**
+ * \brief Strip the segment with the given index is wired to
+ */
+constexpr uint8_t stripOfSegment(uint16_t segment)
+{
+	uint8_t strip = 0;
+	while (strip + 1 < NUM_LED_STRIPS && firstSegmentOfStrip(strip + 1) <= segment)
+	{
+		strip++;
+	}
+	return strip;
+}
+
+/**
+ * \brief Checks that the strips start with the first segment and follow the wiring order
+ */
+constexpr bool stripsFollowWiringOrder()
+{
+	if(firstSegmentOfStrip(0) != 0)
+	{
+		return false;
+	}
+	for (uint8_t strip = 1; strip < NUM_LED_STRIPS; strip++)
+	{
+		if(firstSegmentOfStrip(strip) >= NUM_SEGMENTS || firstSegmentOfStrip(strip) <= firstSegmentOfStrip(strip - 1))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * \brief Checks that all segments of a display are wired to the same strip
+ */
+constexpr bool noDisplayIsSplitAcrossStrips()
+{
+	for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
+	{
+		for (uint16_t j = i + 1; j < NUM_SEGMENTS; j++)
+		{
+			if(Segments[i].display == Segments[j].display && stripOfSegment(i) != stripOfSegment(j))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * \brief Time model of the WS2812B protocol: 24 bits at 800 kHz per LED and the latch time after every transmission
+ */
+constexpr uint32_t WS2812B_MICROS_PER_LED = 30;
+constexpr uint32_t WS2812B_LATCH_MICROS = 50;
+
+/**
+ * \brief Time in us one FastLED.show() takes to transmit all strips, they are transmitted in parallel so the longest strip counts
+ */
+constexpr uint32_t estimatedShowTimeMicros()
+{
+	uint16_t longestStrip = 0;
+	for (uint8_t strip = 0; strip < NUM_LED_STRIPS; strip++)
+	{
+		if(stripLength(strip) > longestStrip)
+		{
+			longestStrip = stripLength(strip);
+		}
+	}
+	return longestStrip * WS2812B_MICROS_PER_LED + WS2812B_LATCH_MICROS;
+}
+
+static_assert(segmentDisplaysAreValid(), "DisplayLayoutConfiguration.h: a segment references a display that does not exist");
+static_assert(noPositionIsWiredTwice(), "DisplayLayoutConfiguration.h: a segment position is wired twice in the same display");
+static_assert(displaysAreComplete(), "DisplayLayoutConfiguration.h: a display does not have the segments its mode requires");
+static_assert(countSegmentsOfSize(SevenSegment::LONG_SEGMENT) == NUM_BIG_SEGMENTS, "DisplayLayoutConfiguration.h: number of long segments does not match NUM_BIG_SEGMENTS");
+static_assert(countSegmentsOfSize(SevenSegment::SHORT_SEGMENT) == NUM_SMALL_SEGMENTS, "DisplayLayoutConfiguration.h: number of short segments does not match NUM_SMALL_SEGMENTS");
+static_assert(countSegmentsOfSize(SevenSegment::DOT_SEGMENT) == NUM_DOT_SEGMENTS, "DisplayLayoutConfiguration.h: number of dot segments does not match NUM_DOT_SEGMENTS");
+static_assert(stripsFollowWiringOrder(), "DisplayLayoutConfiguration.h: every strip must start at a display with segments, the first one at the first segment, in wiring order");
+static_assert(noDisplayIsSplitAcrossStrips(), "DisplayLayoutConfiguration.h: the segments of a display are wired to different strips");
+#if APPEND_DOWN_LIGHTERS == true
+static_assert(NumSegmentLeds + ADDITIONAL_LEDS == NUM_LEDS, "DisplayLayoutConfiguration.h: segment LEDs and down lighters do not add up to NUM_LEDS");
+#else
+static_assert(NumSegmentLeds == NUM_LEDS, "DisplayLayoutConfiguration.h: segment LEDs do not add up to NUM_LEDS");
+#endif
+
+} // namespace DisplayLayout
+
+#endif
@@ -8,13 +8,23 @@
 #define __DISPLAY_MANAGER_H_
 
 #include <Arduino.h>
+#include <atomic>
+#include <mutex>
 #include "Configuration.h"
 #define FASTLED_INTERNAL
 #include "FastLED.h"
 #include "Animator.h"
 #include "Segment.h"
 #include "SevenSegment.h"
+#include "DisplayLayout.h"
 #include "TimeManager.h"
+#include "RunningMedian.h"
+#include "HysteresisFilter.h"
+#include "BrightnessRamp.h"
+#include "ColorScheme.h"
+#if ENABLE_FRAME_RECORDER == true
+	#include "FrameRecorder.h"
+#endif
 namespace AnimatorLinkedList {
 	#include "LinkedList.h"
 }
@@ -22,8 +32,9 @@ namespace AnimatorLinkedList {
 
 /**
  * \brief Macro to shorten then name of the function to make usage easier in the animation config files.
+ *        The index is resolved at compile time, a position which is not wired in the display fails the build.
  */
-#define SEGMENT(POSITION, DISPLAY)		DisplayManager::getGlobalSegmentIndex(POSITION, DISPLAY)
+#define SEGMENT(POSITION, DISPLAY)		(DisplayLayout::SegmentIndex<POSITION, DISPLAY>::value)
 
 /**
  * \brief The display manager is responsible to Manage all displays.
@@ -34,23 +45,21 @@ namespace AnimatorLinkedList {
 class DisplayManager
 {
 private:
-	//segment configurations
-	static SevenSegment::SegmentPosition SegmentPositions[NUM_SEGMENTS];
-	static Segment::direction SegmentDirections[NUM_SEGMENTS];
-	static SevenSegment::SevenSegmentMode SegmentDisplayModes[NUM_DISPLAYS];
-	static SevenSegment::SevenSegmentSize SegmentDisplaySize[NUM_DISPLAYS];
-	static uint8_t diplayIndex[NUM_SEGMENTS];
 	static DisplayManager* instance;
 
+	//segments and displays are placed statically, their layout is computed at compile time in DisplayLayout.h
+	static CRGB leds[NUM_LEDS];
+	static std::array<Segment, NUM_SEGMENTS> SegmentStorage;
+	static std::array<SevenSegment, NUM_DISPLAYS> DisplayStorage;
+
 	Animator* animationManager;
 	Segment* allSegments[NUM_SEGMENTS];
 	SevenSegment* Displays[NUM_DISPLAYS];
 	uint8_t currentLEDBrightness;
-	uint8_t LEDBrightnessSmoothingStartPoint;
-	uint8_t LEDBrightnessSetPoint;
-	uint8_t LEDBrightnessCurrent;
-	uint64_t lastBrightnessChange;
-    CubicEase* lightSensorEasing;
+	BrightnessRamp brightnessRamp;
+	unsigned long lastBrightnessFrame;
+	bool idle;			/** fading out or dark, see #DisplayManager::setIdle */
+	bool idleDark;		/** a dark frame was shown, the animator is stopped */
 	Animator::ComplexAnimationInstance* loadingAnimationID;
 
 	uint8_t _Temp1;
@@ -61,19 +70,53 @@ private:
 	uint8_t currentProgressStep;
 	Animator::ComplexAnimationInstance* loadingAnimationInst;
 
-	typedef struct {
-		SegmentPositions_t segmentPosition;
-		DisplayIDs Display;
-	} SegmentInstanceError;
-	static AnimatorLinkedList::LinkedList<SegmentInstanceError>* SegmentIndexErrorList;
+	//progress posted by #DisplayManager::postProgress, 0 if nothing new was posted since the last frame
+	static constexpr uint32_t ProgressResolution = 10000;
+	static constexpr uint32_t ProgressEnd = UINT32_MAX;
+	std::atomic<uint32_t> progressMailbox;
+	bool progressShown;
+	void renderPostedProgress(uint32_t posted);
+
+	//digit shown on every display (0-9 or SEGMENT_OFF), unchanged digits are not sent to the displays again
+	static constexpr uint8_t DigitUnknown = 0xFF;	/** the display content was changed outside of #DisplayManager::commitFrame */
+	static constexpr uint8_t DigitKeep = 0xFE;		/** the display is not part of the frame */
+	uint8_t committedDigits[NUM_DISPLAYS];
+	uint32_t displayUpdatesIssued;
+	uint32_t displayUpdatesApplied;
+	HysteresisFilter temperature1Filter;
+	HysteresisFilter temperature2Filter;
+
+	uint8_t toDisplayedHours(uint8_t hours);
+	uint8_t toDisplayedTemperature(HysteresisFilter& filter, float temperature);
+	void setNumberInFrame(uint8_t frame[], DisplayIDs higherDigit, DisplayIDs lowerDigit, uint8_t number);
+	void commitFrame(const uint8_t frame[]);
+	void invalidateCommittedDigits();
+
+	//color scheme requested by any task, applied by #DisplayManager::handle at the beginning of the next frame
+	std::mutex colorSchemeLock;
+	ColorScheme requestedScheme;
+	uint16_t requestedCrossfade;
+	bool colorSchemePending;
+	ColorScheme shownScheme;		/** colors of the segments since the last application */
+	ColorScheme crossfadeFrom;
+	ColorScheme crossfadeTo;
+	unsigned long crossfadeStart;
+	uint16_t crossfadeDuration;		/** 0 if no crossfade is running */
+	void takeRequestedColorScheme();
+	void advanceCrossfade(unsigned long now);
+	void applyColorScheme(const ColorScheme& scheme);
+	void writeInternalLEDs(CRGB color);
 
-	CRGB leds[NUM_LEDS];
 	#if APPEND_DOWN_LIGHTERS == false
 		CRGB DownlightLeds[ADDITIONAL_LEDS];
 	#endif
 
+	#if ENABLE_FRAME_RECORDER == true
+		FrameRecorder frameRecorder;
+	#endif
+
 	#if ENABLE_LIGHT_SENSOR == true
-		AnimatorLinkedList::LinkedList<uint16_t> lightSensorMeasurements;
+		RunningMedian<uint16_t, LIGHT_SENSOR_AVERAGE> lightSensorMeasurements;
 		uint64_t lastSensorMeasurement;
 		uint8_t lightSensorBrightness;
 		void takeBrightnessMeasurement();
@@ -97,39 +140,54 @@ public:
 	static DisplayManager* getInstance();
 
 	/**
-	 * \brief Initialize all the segment using the configuration from \ref DisplayConfiguration.cpp
-	 * \param indexOfFirstLed 	Index of the first led in the string that is part of a segment (usually 0)
+	 * \brief Initialize all the segment using the configuration from \ref DisplayLayoutConfiguration.h
 	 * \param initialColor 		Sets the initial color of all the segments. This does not switch any segments on by it's own
 	 * \param initBrightness	Sets the initial brightness of all the segments to avoid brigness jumps during startup
 	 */
-	void InitSegments(uint16_t indexOfFirstLed, CRGB initialColor, uint8_t initBrightness = 128);
+	void InitSegments(CRGB initialColor, uint8_t initBrightness = 128);
 
 	/**
-	 * \brief Sets the color of all segments and updates it immediately for all segments that are currently switched on
+	 * \brief Sets the color of all segments and updates it immediately for all segments that are currently switched on.
+	 * 		  Used for status colors (WIFI, errors, OTA): a running color scheme crossfade is stopped and a scheme still
+	 * 		  pending is dropped, the next color scheme requested with #DisplayManager::setColorScheme replaces these
+	 * 		  colors again.
 	 * \param color Color to set the LEDs to
 	 */
 	void setAllSegmentColors(CRGB color);
 
 	/**
-	 * \brief Sets the color of the  egments which are displaying hours and updates it immediately for all segments that are currently switched on
+	 * \brief Requests a new color scheme. It can be called from any task, the whole scheme is applied in one pass at the
+	 * 		  beginning of the next frame handled by #DisplayManager::handle. Requests made before that frame are merged.
+	 * \param scheme colors of all light groups
+	 * \param crossfade time in ms to fade from the current colors to the new ones, 0 to switch with the next frame
+	 */
+	void setColorScheme(const ColorScheme& scheme, uint16_t crossfade = 0);
+
+	/**
+	 * \brief Returns the color scheme requested last, whether it is already shown or not
+	 */
+	ColorScheme getColorScheme();
+
+	/**
+	 * \brief Sets the color of the segments which are displaying hours with the next frame, see #DisplayManager::setColorScheme
 	 * \param color Color to set the LEDs to
 	 */
 	void setHourSegmentColors(CRGB color);
 
 	/**
-	 * \brief Sets the color of the segments which are displaying minutes and updates it immediately for all segments that are currently switched on
+	 * \brief Sets the color of the segments which are displaying minutes with the next frame, see #DisplayManager::setColorScheme
 	 * \param color Color to set the LEDs to
 	 */
 	void setMinuteSegmentColors(CRGB color);
 
 	/**
-	 * \brief Sets the color of the segments which are displaying temperature 1 and updates it immediately for all segments that are currently switched on
+	 * \brief Sets the color of the segments which are displaying temperature 1 with the next frame, see #DisplayManager::setColorScheme
 	 * \param color Color to set the LEDs to
 	 */
 	void setTemp1SegmentColors(CRGB color);
 
 	/**
-	 * \brief Sets the color of the segments which are displaying temperature 2 and updates it immediately for all segments that are currently switched on
+	 * \brief Sets the color of the segments which are displaying temperature 2 with the next frame, see #DisplayManager::setColorScheme
 	 * \param color Color to set the LEDs to
 	 */
 	void setTemp2SegmentColors(CRGB color);
@@ -164,19 +222,51 @@ public:
 	void handle();
 
 	/**
-	 * \brief Displays the temperature 1 and 2 on the respective displays
+	 * \brief Displays the temperature 1 and 2 on the respective displays, rounded with the hysteresis set by #TEMPERATURE_DEAD_BAND and #TEMPERATURE_MIN_DWELL
 	 * \param Temp1 Number to show on the temp1 display
 	 * \param Temp2 Number to show on the temp2 display
 	 */
 	void displayTemperature(float Temp1, float Humidity1, float Temp2, float Humidity2);
 
 	/**
-	 * \brief Sets the color of the interrior LEDs and displays it immediately
+	 * \brief Displays the time and both temperatures at once. Only the digits which differ from what is currently
+	 * 		  shown are updated, so calling this with unchanged values does not touch the displays.
+	 * \param hours 		Hours in a range of 0 to 24, converted like in #DisplayManager::displayTime
+	 * \param minutes 		Minutes in a range of 0 to 59
+	 * \param Temp1 		Number to show on the temp1 display
+	 * \param Temp2 		Number to show on the temp2 display
+	 */
+	void setFrame(uint8_t hours, uint8_t minutes, float Temp1, float Temp2);
+
+	/**
+	 * \brief Number of digit updates requested through the display functions since startup
+	 */
+	uint32_t getDisplayUpdatesIssued();
+
+	/**
+	 * \brief Number of digit updates which changed a digit and were sent to the displays since startup
+	 */
+	uint32_t getDisplayUpdatesApplied();
+
+	/**
+	 * \brief Number of temperature changes which were not shown because of #TEMPERATURE_DEAD_BAND or #TEMPERATURE_MIN_DWELL
+	 */
+	uint32_t getSuppressedTemperatureChanges();
+
+	#if ENABLE_FRAME_RECORDER == true
+		/**
+		 * \brief Recorder of the last frames sent to the LEDs, see #ENABLE_FRAME_RECORDER
+		 */
+		FrameRecorder* getFrameRecorder();
+	#endif
+
+	/**
+	 * \brief Sets the color of the interrior LEDs with the next frame, see #DisplayManager::setColorScheme
 	 */
 	void setInternalLEDColor(CRGB color);
 
 	/**
-	 * \brief Sets the color of the seperation dot LEDs and displays it immediately
+	 * \brief Sets the color of the seperation dot LEDs with the next frame, see #DisplayManager::setColorScheme
 	 */
 	void setDotLEDColor(CRGB color);
 
@@ -219,6 +309,26 @@ public:
 	 */
 	void updateProgress(uint32_t progress);
 
+	/**
+	 * \brief Posts the progress of a long running operation (e.g. an OTA update) to be shown as a progress bar.
+	 *        This only stores the progress in a lock-free mailbox and returns immediately, so it can be called from
+	 *        any task or callback. The progress bar is drawn by #DisplayManager::handle at its own pace, only the
+	 *        latest progress posted in between two frames is shown.
+	 * \param progress How much progress was done already
+	 * \param total How much progress there is to do in total
+	 */
+	void postProgress(uint32_t progress, uint32_t total);
+
+	/**
+	 * \brief Ends the progress bar shown by #DisplayManager::postProgress. Can be called from any task or callback.
+	 */
+	void postProgressEnd();
+
+	/**
+	 * \brief Returns true while a progress bar posted with #DisplayManager::postProgress is shown
+	 */
+	bool isShowingProgress();
+
 	/**
 	 * \brief Use this delay instead of the Arduino delay to enable Display updates during the delay.
 	 * \param timeInMs Delay time in ms
@@ -232,6 +342,22 @@ public:
 	 */
 	void setGlobalBrightness(uint8_t brightness, bool enableSmoothTransition = true);
 
+	/**
+	 * \brief Idle mode: the LEDs fade out and the animator stops once a dark frame was shown. Brightness changes
+	 *        are only stored meanwhile. Leaving the idle mode restores the brightness with the next frame.
+	 */
+	void setIdle(bool enable);
+
+	/**
+	 * \brief Returns true once the idle mode showed a dark frame, nothing is rendered until it ends
+	 */
+	bool isDark();
+
+	/**
+	 * \brief Estimated power in mW of the frame in the LED buffer at the current brightness (FastLED power model)
+	 */
+	uint32_t getLEDPower();
+
 	/**
 	 * \brief Calling the Flash dot animation for the appropriate segments in the middle of the clock face
 	 */
@@ -245,22 +371,17 @@ public:
     /**
      * \brief get the index of a segment in regards to it's position on the clock face.
      *  	  This makes writing animations a lot easier as it will act as an abstraction layer between the animation
-     *        config and the display config
+     *        config and the display config. This is a lookup in the table computed at compile time in \ref DisplayLayout.h,
+     *        use the #SEGMENT macro where the position and display are known at compile time.
      *
      * \param segmentPosition Position of a segment in the seven segment display
      * \param Display Which display should be targeted
-     * \return int16_t index of the Segment in the #DisplayManager::SegmentPositions array
-     */
-	static int16_t getGlobalSegmentIndex(SegmentPositions_t segmentPosition, DisplayIDs Display);
-
-    /**
-     * \brief Debugging function which will print out any errors that occurred when using the
-     *        #DisplayManager::getGlobalSegmentIndex function.
-     *        Especially useful for debugging weirdly behaving animations as animations will be configured before the
-     *        Serial connection is up. If an error was detected by the #DisplayManager::getGlobalSegmentIndex function a
-     *        message will be added to a buffer which can then be printed out using this function.
+     * \return int16_t index of the Segment in the #DisplayLayout::Segments array or #NO_SEGMENTS if there is none
      */
-	static void printAnimationInitErrors();
+	static constexpr int16_t getGlobalSegmentIndex(SegmentPositions_t segmentPosition, DisplayIDs Display)
+	{
+		return DisplayLayout::segmentIndex(segmentPosition, Display);
+	}
 };
 
 
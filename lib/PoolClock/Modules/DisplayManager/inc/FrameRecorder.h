@@ -0,0 +1,133 @@
+/**
+ * \file FrameRecorder.h
+ * \author Yves Gaignard
+ * \brief Flight recorder of the LED frames shown during the last seconds
+ */
+
+#ifndef __FRAME_RECORDER_H_
+#define __FRAME_RECORDER_H_
+
+#include <Arduino.h>
+#include <mutex>
+#include "Configuration.h"
+#define FASTLED_INTERNAL
+#include "FastLED.h"
+
+#if ENABLE_FRAME_RECORDER == true
+
+/**
+ * \brief Keeps the LED frames of the last #FRAME_RECORDER_DURATION ms in a ring buffer of #FRAME_RECORDER_BUFFER_SIZE bytes.
+ *
+ *        Every frame is stored as the difference to the previous one: runs of unchanged LEDs are skipped and only
+ *        runs of changed LEDs are stored with their colors. A frame without any change is not stored at all, so
+ *        a static clock costs nothing. The record that drops out of the ring buffer is applied to a base frame,
+ *        which is where the decoding of the recording starts.
+ *
+ *        The recording is downloaded in chunks with #FrameRecorder::beginDownload and #FrameRecorder::readDownload,
+ *        straight from the ring buffer. No frame is recorded during a download, so the chunks stay consistent.
+ *
+ *        File format of the download, all numbers little endian:
+ *        - header: "PCFR", version (uint8_t), reserved (uint8_t), number of LEDs (uint16_t)
+ *        - base frame: time in ms (uint32_t), brightness (uint8_t), number of LEDs * RGB
+ *        - records: time since the previous frame in ms (uint16_t), brightness (uint8_t), payload length (uint16_t), payload
+ *        - payload tokens: 0x00-0x7F skips token+1 unchanged LEDs, 0x80-0xFF is followed by (token & 0x7F)+1 RGB colors
+ */
+class FrameRecorder
+{
+public:
+	static constexpr uint8_t FileVersion = 1;
+
+private:
+	static constexpr uint16_t NumLeds = NUM_LEDS;
+	static constexpr uint16_t RecordHeaderSize = 5;
+	static constexpr uint16_t FileHeaderSize = 8;
+	static constexpr uint16_t BaseHeaderSize = 5;
+	static constexpr uint16_t MaxRun = 128;
+	//worst case payload: every LED changed, one token every 128 LEDs
+	static constexpr uint16_t MaxPayloadSize = NumLeds * 3 + (NumLeds + MaxRun - 1) / MaxRun;
+	static_assert(FRAME_RECORDER_BUFFER_SIZE >= MaxPayloadSize + RecordHeaderSize, "DisplayConfiguration.h: FRAME_RECORDER_BUFFER_SIZE must hold at least one frame in which every LED changed");
+
+	uint8_t ring[FRAME_RECORDER_BUFFER_SIZE];
+	uint32_t oldest;			/** position of the oldest record in the ring */
+	uint32_t used;				/** number of bytes used in the ring */
+
+	CRGB baseFrame[NumLeds];	/** frame before the oldest record */
+	unsigned long baseTime;
+	uint8_t baseBrightness;
+	unsigned long oldestTime;	/** time of the oldest record */
+
+	CRGB previousFrame[NumLeds];	/** last recorded frame, the next one is encoded against it */
+	unsigned long previousTime;
+	uint8_t previousBrightness;
+	bool hasFrame;
+
+	uint8_t payload[MaxPayloadSize];
+
+	uint32_t recordedFrames;
+	uint32_t skippedFrames;
+	uint8_t  downloads;			/** downloads in progress, the recording is paused while there is one */
+
+	std::mutex lock;
+
+	uint16_t encode(const CRGB* frame);
+	void write(const uint8_t* data, uint32_t length);
+	uint8_t readByte(uint32_t offset) const;
+	void dropOldest();
+	uint8_t fileByte(uint32_t offset) const;
+
+public:
+	FrameRecorder();
+
+	/**
+	 * \brief Records a frame, should be called once for every frame sent to the LEDs. Never blocks: while the recording
+	 * 		  is downloaded the frame is skipped and the next one is encoded against the last recorded frame.
+	 * \param frame LEDs as sent to the strips
+	 * \param brightness FastLED brightness the frame was sent with
+	 * \param now time of the frame in ms
+	 */
+	void record(const CRGB* frame, uint8_t brightness, unsigned long now);
+
+	/**
+	 * \brief Pauses the recording for a download, to be ended with #FrameRecorder::endDownload
+	 * \return size in bytes of the file described above
+	 */
+	uint32_t beginDownload();
+
+	/**
+	 * \brief Copies a chunk of the file described above
+	 * \param buffer where the chunk is written to
+	 * \param maxLength size of the buffer
+	 * \param index offset of the chunk in the file
+	 * \return number of bytes written, 0 after the end of the file
+	 */
+	size_t readDownload(uint8_t* buffer, size_t maxLength, size_t index);
+
+	/**
+	 * \brief Resumes the recording after a download
+	 */
+	void endDownload();
+
+	/**
+	 * \brief Number of frames recorded since boot, frames without any change are not counted
+	 */
+	uint32_t getRecordedFrames() const;
+
+	/**
+	 * \brief Number of frames which could not be recorded because the recording was downloaded at the same time
+	 */
+	uint32_t getSkippedFrames() const;
+
+	/**
+	 * \brief Number of bytes currently used in the ring buffer
+	 */
+	uint32_t getUsedBytes() const;
+
+	/**
+	 * \brief Time in ms covered by the records in the ring buffer
+	 */
+	unsigned long getRecordedDuration() const;
+};
+
+#endif
+
+#endif
@@ -0,0 +1,115 @@
+/**
+ * \file BrightnessRamp.cpp
+ * \author Yves Gaignard
+ * \brief Implementation of the BrightnessRamp class member functions
+ */
+
+#include "BrightnessRamp.h"
+
+BrightnessRamp::BrightnessRamp(uint16_t rampDuration)
+{
+	duration = rampDuration > 0 ? rampDuration : 1;
+	currentLightness = 0;
+	targetLightness = 0;
+	rate = 1;
+	targetBrightness = 0;
+	output = 0;
+	lastAdvance = 0;
+}
+
+uint16_t BrightnessRamp::brightnessToLightness(uint8_t brightness)
+{
+	//smallest L* whose brightness is not lower than the requested one
+	uint16_t low = 0;
+	uint16_t high = 255;
+	while (low < high)
+	{
+		uint16_t middle = (low + high) / 2;
+		if(BrightnessTable[middle] < brightness)
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+	return low << 8;
+}
+
+void BrightnessRamp::setTarget(uint8_t brightness, unsigned long now)
+{
+	//bring the current value up to date before the ramp is changed, this is what keeps the ramp continuous
+	advance(now);
+	targetBrightness = brightness;
+	targetLightness = brightnessToLightness(brightness);
+	uint16_t distance = targetLightness > currentLightness ? targetLightness - currentLightness : currentLightness - targetLightness;
+	//rounded up so that the target is reached within the ramp duration
+	rate = ((uint32_t)distance + duration - 1) / duration;
+	if(rate == 0)
+	{
+		rate = 1;
+	}
+}
+
+void BrightnessRamp::jumpTo(uint8_t brightness, unsigned long now)
+{
+	targetBrightness = brightness;
+	targetLightness = currentLightness = brightnessToLightness(brightness);
+	output = brightness;
+	lastAdvance = now;
+}
+
+void BrightnessRamp::advance(unsigned long now)
+{
+	//the callers mix the time of the last frame and millis(), a time before the last advance counts as no time at all
+	unsigned long elapsed = 0;
+	if((long)(now - lastAdvance) > 0)
+	{
+		elapsed = now - lastAdvance;
+		lastAdvance = now;
+	}
+	//no ramp lasts longer than its duration, this also keeps the step from overflowing after a long pause
+	if(elapsed > duration)
+	{
+		elapsed = duration;
+	}
+	uint32_t step = (uint32_t)rate * elapsed;
+
+	if(currentLightness < targetLightness)
+	{
+		currentLightness = ((uint32_t)(targetLightness - currentLightness) > step) ? currentLightness + step : targetLightness;
+	}
+	else if(currentLightness > targetLightness)
+	{
+		currentLightness = ((uint32_t)(currentLightness - targetLightness) > step) ? currentLightness - step : targetLightness;
+	}
+
+	if(currentLightness == targetLightness)
+	{
+		output = targetBrightness;
+	}
+	else
+	{
+		//the table is not invertible at the ends of the scale, never pass the target on the way to it
+		output = BrightnessTable[currentLightness >> 8];
+		if(currentLightness < targetLightness && output > targetBrightness)
+		{
+			output = targetBrightness;
+		}
+		else if(currentLightness > targetLightness && output < targetBrightness)
+		{
+			output = targetBrightness;
+		}
+	}
+}
+
+uint8_t BrightnessRamp::getBrightness() const
+{
+	return output;
+}
+
+bool BrightnessRamp::isRamping() const
+{
+	return currentLightness != targetLightness;
+}
@@ -8,13 +8,49 @@
 
 #include "DisplayManager.h"
 #include "LogManager.h"
+#if ENABLE_LIGHT_SENSOR == true && LIGHT_SENSOR_ANALOG == true
+#include "Sensor_LDR.h"
+#endif
 
 DisplayManager* DisplayManager::instance = nullptr;
-AnimatorLinkedList::LinkedList<DisplayManager::SegmentInstanceError>* DisplayManager::SegmentIndexErrorList = nullptr;
 
-DisplayManager::DisplayManager()
+namespace {
+	/**
+	 * \brief Constructs every segment in place with the LED offsets computed by \ref DisplayLayout.h
+	 */
+	template<size_t... I>
+	std::array<Segment, sizeof...(I)> makeSegments(CRGB* ledBuffer, std::index_sequence<I...>)
+	{
+		return {{ Segment(ledBuffer, DisplayLayout::firstLedOfSegment(I), DisplayLayout::segmentLength(I), DisplayLayout::Segments[I].direction)... }};
+	}
+
+	/**
+	 * \brief Adds one FastLED controller per strip defined in \ref DisplayLayoutConfiguration.h
+	 */
+	template<size_t... I>
+	void addStripControllers(CRGB* ledBuffer, std::index_sequence<I...>)
+	{
+		(FastLED.addLeds<WS2812B, DisplayLayout::Strips[I].pin, GRB>(ledBuffer + DisplayLayout::firstLedOfStrip(I), DisplayLayout::stripLength(I)), ...);  // GRB ordering is typical
+	}
+
+	/**
+	 * \brief Constructs every display in place with the mode defined in \ref DisplayLayoutConfiguration.h
+	 */
+	template<size_t... I>
+	std::array<SevenSegment, sizeof...(I)> makeDisplays(std::index_sequence<I...>)
+	{
+		return {{ SevenSegment(DisplayLayout::Displays[I].mode, Animator::getInstance())... }};
+	}
+}
+
+CRGB DisplayManager::leds[NUM_LEDS];
+std::array<Segment, NUM_SEGMENTS> DisplayManager::SegmentStorage = makeSegments(DisplayManager::leds, std::make_index_sequence<NUM_SEGMENTS>());
+std::array<SevenSegment, NUM_DISPLAYS> DisplayManager::DisplayStorage = makeDisplays(std::make_index_sequence<NUM_DISPLAYS>());
+
+DisplayManager::DisplayManager() : brightnessRamp(BRIGHTNESS_INTERPOLATION),
+	temperature1Filter(TEMPERATURE_DEAD_BAND, TEMPERATURE_MIN_DWELL), temperature2Filter(TEMPERATURE_DEAD_BAND, TEMPERATURE_MIN_DWELL)
 {
-	FastLED.addLeds<WS2812B, LED_DATA_PIN, GRB>(leds, NUM_LEDS);  // GRB ordering is typical
+	addStripControllers(leds, std::make_index_sequence<NUM_LED_STRIPS>());
 
 	#if APPEND_DOWN_LIGHTERS == false
 		FastLED.addLeds<WS2812B, DOWNLIGHT_LED_DATA_PIN, GRB>(DownlightLeds, ADDITIONAL_LEDS);
@@ -32,33 +68,52 @@ DisplayManager::DisplayManager()
 		}
 	#endif
 
+	for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
+	{
+		allSegments[i] = &SegmentStorage[i];
+	}
+
 	for (uint8_t i = 0; i < NUM_DISPLAYS; i++)
 	{
-		Displays[i] = nullptr;
+		Displays[i] = &DisplayStorage[i];
 	}
 
 	animationManager = Animator::getInstance();
 
-	LEDBrightnessCurrent = 128;
-	LEDBrightnessSmoothingStartPoint = 128;
+	lastBrightnessFrame = 0;
+	idle = false;
+	idleDark = false;
 	setGlobalBrightness(128, false);
 
 	#if ENABLE_LIGHT_SENSOR == true
-	    pinMode (LIGHT_SENSOR_PIN, INPUT); // define photosensitive resistance sensor as the input interface
+		#if LIGHT_SENSOR_ANALOG == true
+			Sensor_LDR::getInstance()->initAO(LIGHT_SENSOR_PIN, LIGHT_SENSOR_READ_DELAY);
+		#else
+			pinMode (LIGHT_SENSOR_PIN, INPUT); // define photosensitive resistance sensor as the input interface
+		#endif
 		lastSensorMeasurement = 0;
 		takeBrightnessMeasurement();
 	#endif
 
-    lightSensorEasing = new CubicEase();
-    lightSensorEasing->setDuration(BRIGHTNESS_INTERPOLATION);
 	progressTotal = 0;
 	currentProgressOffset = 0;
 	currentProgressStep = 0;
+	progressMailbox = 0;
+	progressShown = false;
+	displayUpdatesIssued = 0;
+	displayUpdatesApplied = 0;
+	invalidateCommittedDigits();
+
+	requestedScheme = ColorScheme::fromConfiguration();
+	requestedCrossfade = 0;
+	colorSchemePending = false;
+	shownScheme = ColorScheme::uniform(CRGB::Black);
+	crossfadeStart = 0;
+	crossfadeDuration = 0;
 }
 
 DisplayManager::~DisplayManager()
 {
-	delete lightSensorEasing;
 	instance = nullptr;
 }
 
@@ -73,70 +128,124 @@ DisplayManager* DisplayManager::getInstance()
 
 void DisplayManager::setAllSegmentColors(CRGB color)
 {
+	{
+		//a scheme requested before must not replace the status color with the next frame
+		std::lock_guard<std::mutex> guard(colorSchemeLock);
+		colorSchemePending = false;
+		requestedCrossfade = 0;
+	}
+	crossfadeDuration = 0;
 	for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
 	{
 		allSegments[i]->updateColor(color);
 	}
+	CRGB internal = shownScheme.internal;
+	shownScheme = ColorScheme::uniform(color);
+	shownScheme.internal = internal;
 }
 
-#if ENABLE_LIGHT_SENSOR == true
+void DisplayManager::setColorScheme(const ColorScheme& scheme, uint16_t crossfade)
+{
+	std::lock_guard<std::mutex> guard(colorSchemeLock);
+	requestedScheme = scheme;
+	requestedCrossfade = crossfade;
+	colorSchemePending = true;
+}
 
-int SortFunction_SmallerThan(uint16_t &a, uint16_t &b)
+ColorScheme DisplayManager::getColorScheme()
 {
-	return a < b;
+	std::lock_guard<std::mutex> guard(colorSchemeLock);
+	return requestedScheme;
 }
 
+void DisplayManager::takeRequestedColorScheme()
+{
+	//never wait for a task which is requesting a scheme, the request is taken with one of the next frames
+	std::unique_lock<std::mutex> guard(colorSchemeLock, std::try_to_lock);
+	if(!guard.owns_lock() || colorSchemePending == false)
+	{
+		return;
+	}
+	ColorScheme scheme = requestedScheme;
+	uint16_t crossfade = requestedCrossfade;
+	colorSchemePending = false;
+	requestedCrossfade = 0;
+	guard.unlock();
+
+	if(crossfade == 0)
+	{
+		crossfadeDuration = 0;
+		applyColorScheme(scheme);
+	}
+	else
+	{
+		//a crossfade which is still running continues from the colors shown right now
+		crossfadeFrom = shownScheme;
+		crossfadeTo = scheme;
+		crossfadeStart = millis();
+		crossfadeDuration = crossfade;
+	}
+}
+
+void DisplayManager::advanceCrossfade(unsigned long now)
+{
+	if(crossfadeDuration == 0)
+	{
+		return;
+	}
+	unsigned long elapsed = now - crossfadeStart;
+	if(elapsed >= crossfadeDuration)
+	{
+		crossfadeDuration = 0;
+		applyColorScheme(crossfadeTo);
+	}
+	else
+	{
+		//the colors of the six light groups are blended once per frame, the segments only copy them
+		applyColorScheme(ColorScheme::blend(crossfadeFrom, crossfadeTo, elapsed * 256 / crossfadeDuration));
+	}
+}
+
+void DisplayManager::applyColorScheme(const ColorScheme& scheme)
+{
+	CRGB displayColors[NUM_DISPLAYS];
+	for (uint8_t i = 0; i < NUM_DISPLAYS; i++)
+	{
+		displayColors[i] = scheme.forDisplay(i);
+	}
+	for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
+	{
+		allSegments[i]->updateColor(displayColors[DisplayLayout::Segments[i].display]);
+	}
+	writeInternalLEDs(scheme.internal);
+	shownScheme = scheme;
+}
+
+#if ENABLE_LIGHT_SENSOR == true
+
 void DisplayManager::takeBrightnessMeasurement()
 {
 	if(lastSensorMeasurement + LIGHT_SENSOR_READ_DELAY < millis())
 	{
-		uint8_t lightSensorBrightnessNew = 0;
 		lastSensorMeasurement = millis();
-		//lightSensorMeasurements.add(analogRead(LIGHT_SENSOR_PIN));
-		uint16_t val = digitalRead(LIGHT_SENSOR_PIN); 
-		if ( val == LOW)  // val is LOW means it is the complete brightness
-		{
-			LOG_D(TAG, "Read brightness value = LOW ==> Complete Brightness");
-    		lightSensorMeasurements.add(LIGHT_SENSOR_MAX);
-		}
-		else // val is HIGH means it is the complete darkness
-		{
-			LOG_D(TAG, "Read brightness value = HIGH ==> Complete Darkness");
-    		lightSensorMeasurements.add(LIGHT_SENSOR_MIN);
-		}
-
-		if(lightSensorMeasurements.size() >= LIGHT_SENSOR_AVERAGE)
-		{
-			lightSensorMeasurements.shift();
-		}
-		if(lightSensorMeasurements.size() < LIGHT_SENSOR_MEDIAN_WIDTH)
-		{
-			//Calculate a normal average as long as the median width is not reached yet
-			uint64_t BrightnessListSum = 0;
-			for (uint16_t i = 0; i < lightSensorMeasurements.size(); i++)
-			{
-				BrightnessListSum += lightSensorMeasurements.get(i);
-			}
-			lightSensorBrightnessNew = map(BrightnessListSum / lightSensorMeasurements.size(), 0, 4095, 0, 255);
-		}
-		else
-		{
-			AnimatorLinkedList::LinkedList<uint16_t> sortedMeasurements;
-			//copy all the values to a new temporary list in order to sort them
-			for (uint16_t i = 0; i < lightSensorMeasurements.size(); i++)
+		#if LIGHT_SENSOR_ANALOG == true
+			lightSensorMeasurements.add(Sensor_LDR::getInstance()->getAOValue());
+		#else
+			if (digitalRead(LIGHT_SENSOR_PIN) == LOW)  // LOW means it is the complete brightness
 			{
-				sortedMeasurements.add(lightSensorMeasurements.get(i));
+				LOG_D(TAG, "Read brightness value = LOW ==> Complete Brightness");
+				lightSensorMeasurements.add(LIGHT_SENSOR_MAX);
 			}
-			sortedMeasurements.sort(SortFunction_SmallerThan);
-			//calculate the average of the median window
-			uint64_t BrightnessListSum = 0;
-			uint16_t medianOffset = floor((sortedMeasurements.size() - LIGHT_SENSOR_MEDIAN_WIDTH) / 2);
-			for (uint16_t i = 0; i < LIGHT_SENSOR_MEDIAN_WIDTH; i++)
+			else // HIGH means it is the complete darkness
 			{
-				BrightnessListSum += sortedMeasurements.get(i + medianOffset);
+				LOG_D(TAG, "Read brightness value = HIGH ==> Complete Darkness");
+				lightSensorMeasurements.add(LIGHT_SENSOR_MIN);
 			}
-			lightSensorBrightnessNew = map(BrightnessListSum / LIGHT_SENSOR_MEDIAN_WIDTH, LIGHT_SENSOR_MIN, LIGHT_SENSOR_MAX, LIGHT_SENSOR_SENSITIVITY, 0);
-		}
+		#endif
+
+		//average of the median window, or of all measurements as long as the median width is not reached yet
+		uint16_t measurement = lightSensorMeasurements.trimmedMean(LIGHT_SENSOR_MEDIAN_WIDTH);
+		uint8_t lightSensorBrightnessNew = map(measurement, LIGHT_SENSOR_MIN, LIGHT_SENSOR_MAX, LIGHT_SENSOR_SENSITIVITY, 0);
 		if(lightSensorBrightnessNew != lightSensorBrightness)
 		{
 			lightSensorBrightness = lightSensorBrightnessNew;
@@ -150,94 +259,62 @@ void DisplayManager::takeBrightnessMeasurement()
 
 void DisplayManager::setHourSegmentColors(CRGB color)
 {
-	Displays[LOWER_DIGIT_HOUR_DISPLAY]->updateColor(color);
-	Displays[HIGHER_DIGIT_HOUR_DISPLAY]->updateColor(color);
+	std::lock_guard<std::mutex> guard(colorSchemeLock);
+	requestedScheme.hour = color;
+	colorSchemePending = true;
 }
 
 void DisplayManager::setMinuteSegmentColors(CRGB color)
 {
-	Displays[LOWER_DIGIT_MINUTE_DISPLAY]->updateColor(color);
-	Displays[HIGHER_DIGIT_MINUTE_DISPLAY]->updateColor(color);
+	std::lock_guard<std::mutex> guard(colorSchemeLock);
+	requestedScheme.minute = color;
+	colorSchemePending = true;
 }
 
 void DisplayManager::setTemp1SegmentColors(CRGB color)
 {
-	Displays[LOWER_DIGIT_TEMP1_DISPLAY]->updateColor(color);
-	Displays[HIGHER_DIGIT_TEMP1_DISPLAY]->updateColor(color);
+	std::lock_guard<std::mutex> guard(colorSchemeLock);
+	requestedScheme.temp1 = color;
+	colorSchemePending = true;
 }
 
 void DisplayManager::setTemp2SegmentColors(CRGB color)
 {
-	Displays[LOWER_DIGIT_TEMP2_DISPLAY]->updateColor(color);
-	Displays[HIGHER_DIGIT_TEMP2_DISPLAY]->updateColor(color);
+	std::lock_guard<std::mutex> guard(colorSchemeLock);
+	requestedScheme.temp2 = color;
+	colorSchemePending = true;
 }
 
-void DisplayManager::InitSegments(uint16_t indexOfFirstLed, CRGB initialColor, uint8_t initBrightness)
+void DisplayManager::InitSegments(CRGB initialColor, uint8_t initBrightness)
 {
-	uint8_t ledsPerSegment = 0;
-
-	for (uint8_t i = 0; i < NUM_DISPLAYS; i++)
+	LOG_D(TAG, "Segment Number = %d, LED Number = %d", NUM_SEGMENTS, DisplayLayout::NumSegmentLeds);
+	for (uint8_t i = 0; i < NUM_LED_STRIPS; i++)
 	{
-		if(Displays[i] != nullptr)
-		{
-			free(Displays[i]);
-			Displays[i] = nullptr;
-		}
+		LOG_D(TAG, "LED strip %d: pin %d, %d LEDs from LED %d", i, DisplayLayout::Strips[i].pin, DisplayLayout::stripLength(i), DisplayLayout::firstLedOfStrip(i));
 	}
-	uint16_t currentLEDIndex = indexOfFirstLed;
-	LOG_D(TAG, "Segment Number = %d", NUM_SEGMENTS);
+	LOG_I(TAG, "Estimated LED show time: %u us", DisplayLayout::estimatedShowTimeMicros());
+	shownScheme = ColorScheme::uniform(initialColor);
+	shownScheme.internal = CRGB::Black;
 	for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
 	{
-		ledsPerSegment = 0;
-		if      ( SegmentDisplaySize[diplayIndex[i]] == SevenSegment::LONG_SEGMENT )  {ledsPerSegment = NUM_LEDS_PER_LONG_SEGMENT  ;}
-		else if ( SegmentDisplaySize[diplayIndex[i]] == SevenSegment::SHORT_SEGMENT)  {ledsPerSegment = NUM_LEDS_PER_SHORT_SEGMENT ;}
-		else if ( SegmentDisplaySize[diplayIndex[i]] == SevenSegment::DOT_SEGMENT  )  {ledsPerSegment = NUM_LEDS_PER_DOT_SEGMENT   ;} 
-		LOG_D(TAG, "Segment = %d    Size = %d ", i, ledsPerSegment);
-
-		allSegments[i] = new Segment(leds, currentLEDIndex, ledsPerSegment, SegmentDirections[i], initialColor);
-		LOG_D(TAG, "Segment addr= %d", allSegments[i]);
-		if(Displays[diplayIndex[i]] == nullptr)
-		{
-			Displays[diplayIndex[i]] = new SevenSegment(SegmentDisplayModes[diplayIndex[i]], animationManager);
-		}
-		Displays[diplayIndex[i]]->add(allSegments[i], SegmentPositions[i]);
-		LOG_D(TAG, "Displays[%d]->add(%d, %d)", diplayIndex[i], allSegments[i], SegmentPositions[i]);
-		currentLEDIndex += ledsPerSegment;
+		allSegments[i]->setColor(initialColor);
+		Displays[DisplayLayout::Segments[i].display]->add(allSegments[i], DisplayLayout::Segments[i].position);
+		LOG_D(TAG, "Displays[%d]->add(%d, %d)", DisplayLayout::Segments[i].display, i, DisplayLayout::Segments[i].position);
 	}
 	//set the initial brightness to avoid jumps
-	LEDBrightnessCurrent = initBrightness;
-	LEDBrightnessSmoothingStartPoint = initBrightness;
 	setGlobalBrightness(initBrightness, false);
-	//All animations should be initialized by now. So now print the backlog of errors to not forget about it
-	printAnimationInitErrors();
 }
 
 void DisplayManager::displayRaw(uint8_t Hour, uint8_t Minute)
 {
-	uint8_t firstHourDigit = Hour / 10;
-	if(firstHourDigit == 0 && DISPLAY_SWITCH_OFF_AT_0 == true)
-	{
-		Displays[HIGHER_DIGIT_HOUR_DISPLAY]->off();
-	}
-	else
-	{
-		Displays[HIGHER_DIGIT_HOUR_DISPLAY]->DisplayNumber(firstHourDigit);
-	}
-	Displays[LOWER_DIGIT_HOUR_DISPLAY]->DisplayNumber(Hour - firstHourDigit * 10); //get the last digit
-
-	uint8_t firstMinuteDigit = Minute / 10;
-	if(firstMinuteDigit == 0 && DISPLAY_SWITCH_OFF_AT_0 == true)
-	{
-		Displays[HIGHER_DIGIT_MINUTE_DISPLAY]->off();
-	}
-	else
-	{
-		Displays[HIGHER_DIGIT_MINUTE_DISPLAY]->DisplayNumber(firstMinuteDigit);
-	}
-	Displays[LOWER_DIGIT_MINUTE_DISPLAY]->DisplayNumber(Minute - firstMinuteDigit * 10); //get the last digit
+	uint8_t frame[NUM_DISPLAYS];
+	std::fill_n(frame, NUM_DISPLAYS, DigitKeep);
+	setNumberInFrame(frame, HIGHER_DIGIT_HOUR_DISPLAY, LOWER_DIGIT_HOUR_DISPLAY, Hour);
+	setNumberInFrame(frame, HIGHER_DIGIT_MINUTE_DISPLAY, LOWER_DIGIT_MINUTE_DISPLAY, Minute);
+	commitFrame(frame);
 }
 
-void DisplayManager::displayTime(uint8_t hours, uint8_t minutes)
+uint8_t DisplayManager::toDisplayedHours(uint8_t hours)
 {
 	#if DISPLAY_0_AT_MIDNIGHT == true
 	if(hours == 24)
@@ -251,9 +328,99 @@ void DisplayManager::displayTime(uint8_t hours, uint8_t minutes)
 			hours -= 12;
 		}
 	#endif
-	displayRaw(hours, minutes);
+	return hours;
+}
+
+uint8_t DisplayManager::toDisplayedTemperature(HysteresisFilter& filter, float temperature)
+{
+	// negative temperature not accepted as it is an indoor pool
+	int roundedTemperature = filter.update(temperature, millis());
+	return roundedTemperature < 0 ? 0 : roundedTemperature;
+}
+
+void DisplayManager::setNumberInFrame(uint8_t frame[], DisplayIDs higherDigit, DisplayIDs lowerDigit, uint8_t number)
+{
+	uint8_t firstDigit = number / 10;
+	if(firstDigit == 0 && DISPLAY_SWITCH_OFF_AT_0 == true)
+	{
+		frame[higherDigit] = SEGMENT_OFF;
+	}
+	else
+	{
+		frame[higherDigit] = firstDigit;
+	}
+	frame[lowerDigit] = number - firstDigit * 10; //get the last digit
+}
+
+void DisplayManager::commitFrame(const uint8_t frame[])
+{
+	for (uint8_t i = 0; i < NUM_DISPLAYS; i++)
+	{
+		if(frame[i] == DigitKeep)
+		{
+			continue;
+		}
+		displayUpdatesIssued++;
+		if(frame[i] == committedDigits[i])
+		{
+			continue;
+		}
+		displayUpdatesApplied++;
+		if(frame[i] == SEGMENT_OFF)
+		{
+			Displays[i]->off();
+		}
+		else
+		{
+			Displays[i]->DisplayNumber(frame[i]);
+		}
+		committedDigits[i] = frame[i];
+	}
 }
 
+void DisplayManager::invalidateCommittedDigits()
+{
+	std::fill_n(committedDigits, NUM_DISPLAYS, DigitUnknown);
+}
+
+void DisplayManager::displayTime(uint8_t hours, uint8_t minutes)
+{
+	displayRaw(toDisplayedHours(hours), minutes);
+}
+
+void DisplayManager::setFrame(uint8_t hours, uint8_t minutes, float Temp1, float Temp2)
+{
+	uint8_t frame[NUM_DISPLAYS];
+	std::fill_n(frame, NUM_DISPLAYS, DigitKeep);
+	setNumberInFrame(frame, HIGHER_DIGIT_HOUR_DISPLAY, LOWER_DIGIT_HOUR_DISPLAY, toDisplayedHours(hours));
+	setNumberInFrame(frame, HIGHER_DIGIT_MINUTE_DISPLAY, LOWER_DIGIT_MINUTE_DISPLAY, minutes);
+	setNumberInFrame(frame, HIGHER_DIGIT_TEMP1_DISPLAY, LOWER_DIGIT_TEMP1_DISPLAY, toDisplayedTemperature(temperature1Filter, Temp1));
+	setNumberInFrame(frame, HIGHER_DIGIT_TEMP2_DISPLAY, LOWER_DIGIT_TEMP2_DISPLAY, toDisplayedTemperature(temperature2Filter, Temp2));
+	commitFrame(frame);
+}
+
+uint32_t DisplayManager::getDisplayUpdatesIssued()
+{
+	return displayUpdatesIssued;
+}
+
+uint32_t DisplayManager::getDisplayUpdatesApplied()
+{
+	return displayUpdatesApplied;
+}
+
+uint32_t DisplayManager::getSuppressedTemperatureChanges()
+{
+	return temperature1Filter.getSuppressedChanges() + temperature2Filter.getSuppressedChanges();
+}
+
+#if ENABLE_FRAME_RECORDER == true
+	FrameRecorder* DisplayManager::getFrameRecorder()
+	{
+		return &frameRecorder;
+	}
+#endif
+
 void DisplayManager::displayTimer(uint8_t hours, uint8_t minutes, uint8_t seconds)
 {
 	if(hours != 0)
@@ -262,7 +429,7 @@ void DisplayManager::displayTimer(uint8_t hours, uint8_t minutes, uint8_t second
 	}
 	else
 	{
-		if(SegmentDisplayModes[HIGHER_DIGIT_HOUR_DISPLAY] == SevenSegment::TWO_VERTICAL_SEGMENTS)
+		if(DisplayLayout::Displays[HIGHER_DIGIT_HOUR_DISPLAY].mode == SevenSegment::TWO_VERTICAL_SEGMENTS)
 		{
 			if(minutes < 20)
 			{
@@ -282,70 +449,71 @@ void DisplayManager::displayTimer(uint8_t hours, uint8_t minutes, uint8_t second
 
 void DisplayManager::handle()
 {
+	uint32_t postedProgress = progressMailbox.exchange(0, std::memory_order_acquire);
+	if(postedProgress != 0)
+	{
+		//an update is always shown, even when nobody is around
+		setIdle(false);
+		renderPostedProgress(postedProgress);
+	}
+
+	takeRequestedColorScheme();
+
+	if(idleDark)
+	{
+		return;
+	}
+
 	animationManager->handle();
 
 	#if ENABLE_LIGHT_SENSOR == true
 		takeBrightnessMeasurement();
 	#endif
-	uint64_t currentMillis = millis();
-	if(LEDBrightnessCurrent != LEDBrightnessSetPoint && lastBrightnessChange + BRIGHTNESS_INTERPOLATION >= currentMillis)
+
+	//advance the brightness once per frame shown by the animator, the new value is used by the next frame
+	unsigned long frame = Animator::getLastFrameTime();
+	if(frame != lastBrightnessFrame)
 	{
-		if(LEDBrightnessSetPoint > LEDBrightnessSmoothingStartPoint)
-		{
-			lightSensorEasing->setTotalChangeInPosition(LEDBrightnessSmoothingStartPoint - LEDBrightnessSetPoint);
-			LEDBrightnessCurrent = LEDBrightnessSmoothingStartPoint - lightSensorEasing->easeInOut(currentMillis - lastBrightnessChange);
-		}
-        else
+		lastBrightnessFrame = frame;
+		//the frame just shown was dark, nothing needs to be rendered until the idle mode ends
+		idleDark = idle && FastLED.getBrightness() == 0;
+		#if ENABLE_FRAME_RECORDER == true
+			frameRecorder.record(leds, FastLED.getBrightness(), frame);
+		#endif
+		advanceCrossfade(millis());
+		brightnessRamp.advance(frame);
+		if(brightnessRamp.getBrightness() != FastLED.getBrightness())
 		{
-			lightSensorEasing->setTotalChangeInPosition(LEDBrightnessSetPoint - LEDBrightnessSmoothingStartPoint);
-			LEDBrightnessCurrent = LEDBrightnessSmoothingStartPoint + lightSensorEasing->easeInOut(currentMillis - lastBrightnessChange);
+			FastLED.setBrightness(brightnessRamp.getBrightness());
 		}
-		FastLED.setBrightness(LEDBrightnessCurrent);
-		LOG_D(TAG, "Set Sensor brightness in handle: %d", lightSensorBrightness);
-
 	}
 }
 
 void DisplayManager::displayTemperature(float Temp1, float Humidity1, float Temp2, float Humidity2)
 {
-	int iTemp1 = round(Temp1);
-	int iTemp2 = round(Temp2);
+	uint8_t iTemp1 = toDisplayedTemperature(temperature1Filter, Temp1);
+	uint8_t iTemp2 = toDisplayedTemperature(temperature2Filter, Temp2);
 	int iHumidity1 = round(Humidity1);
 	int iHumidity2 = round(Humidity2);
 
-	// negative temperature not accepted as it is an indoor pool
-	if (iTemp1 < 0) iTemp1 = 0;
-	if (iTemp2 < 0) iTemp2 = 0;
-
-	uint8_t firstTempDigit = 0;
-
-	firstTempDigit = iTemp1 / 10;
-	if(firstTempDigit == 0 && DISPLAY_SWITCH_OFF_AT_0 == true)
-	{
-		Displays[HIGHER_DIGIT_TEMP1_DISPLAY]->off();
-	}
-	else
-	{
-		Displays[HIGHER_DIGIT_TEMP1_DISPLAY]->DisplayNumber(firstTempDigit);
-	}
-	Displays[LOWER_DIGIT_TEMP1_DISPLAY]->DisplayNumber(iTemp1 - firstTempDigit * 10); //get the last digit
-
-	firstTempDigit = iTemp2 / 10;
-	if(firstTempDigit == 0 && DISPLAY_SWITCH_OFF_AT_0 == true)
-	{
-		Displays[HIGHER_DIGIT_TEMP2_DISPLAY]->off();
-	}
-	else
-	{
-		Displays[HIGHER_DIGIT_TEMP2_DISPLAY]->DisplayNumber(firstTempDigit);
-	}
-	Displays[LOWER_DIGIT_TEMP2_DISPLAY]->DisplayNumber(iTemp2 - firstTempDigit * 10); //get the last digit
+	uint8_t frame[NUM_DISPLAYS];
+	std::fill_n(frame, NUM_DISPLAYS, DigitKeep);
+	setNumberInFrame(frame, HIGHER_DIGIT_TEMP1_DISPLAY, LOWER_DIGIT_TEMP1_DISPLAY, iTemp1);
+	setNumberInFrame(frame, HIGHER_DIGIT_TEMP2_DISPLAY, LOWER_DIGIT_TEMP2_DISPLAY, iTemp2);
+	commitFrame(frame);
 
 	LOG_D(TAG, "PoolClockDisplays->displayTemperature... T-indoor=%02d H-indoor=%02d T-water=%02d H-water=%02",iTemp1, iHumidity1, iTemp2, iHumidity2);
 
 }
 
 void DisplayManager::setInternalLEDColor(CRGB color)
+{
+	std::lock_guard<std::mutex> guard(colorSchemeLock);
+	requestedScheme.internal = color;
+	colorSchemePending = true;
+}
+
+void DisplayManager::writeInternalLEDs(CRGB color)
 {
 	for (uint16_t i = 0; i < ADDITIONAL_LEDS; i++)
 	{
@@ -359,13 +527,14 @@ void DisplayManager::setInternalLEDColor(CRGB color)
 
 void DisplayManager::setDotLEDColor(CRGB color)
 {
-	#if DISPLAY_FOR_SEPARATION_DOT > -1
-		Displays[DISPLAY_FOR_SEPARATION_DOT]->setColor(color);
-	#endif
+	std::lock_guard<std::mutex> guard(colorSchemeLock);
+	requestedScheme.dot = color;
+	colorSchemePending = true;
 }
 
 void DisplayManager::showLoadingAnimation()
 {
+	invalidateCommittedDigits();
 	loadingAnimationID = animationManager->PlayComplexAnimation(IndefiniteLoadingAnimation, (AnimatableObject**)allSegments, true);
 }
 
@@ -381,6 +550,7 @@ void DisplayManager::waitForLoadingAnimationFinish()
 
 void DisplayManager::turnAllSegmentsOff()
 {
+	invalidateCommittedDigits();
 	for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
 	{
 		allSegments[i]->off();
@@ -394,7 +564,7 @@ void DisplayManager::turnAllLEDsOff()
 		animationManager->stopAnimation(allSegments[i]);
 	}
 	turnAllSegmentsOff();
-	setInternalLEDColor(CRGB::Black);
+	writeInternalLEDs(CRGB::Black);
 }
 
 void DisplayManager::displayProgress(uint32_t total)
@@ -409,12 +579,53 @@ void DisplayManager::displayProgress(uint32_t total)
 
 void DisplayManager::updateProgress(uint32_t progress)
 {
-	if(progress - currentProgressOffset > (progressTotal / NUM_SEGMENTS_PROGRESS))
+	//the progress can advance by more than one step between two updates
+	while(progress - currentProgressOffset > (progressTotal / NUM_SEGMENTS_PROGRESS) && currentProgressStep < NUM_SEGMENTS_PROGRESS - 1)
 	{
 		currentProgressOffset += (progressTotal / NUM_SEGMENTS_PROGRESS);
 		currentProgressStep++;
 	}
-	animationManager->setComplexAnimationStep(loadingAnimationInst, currentProgressStep, map(progress - currentProgressOffset, 0, progressTotal / NUM_SEGMENTS_PROGRESS, 0, LoadingProgressAnimation->LengthPerAnimation));
+	uint32_t stepProgress = constrain(progress - currentProgressOffset, 0, progressTotal / NUM_SEGMENTS_PROGRESS);
+	animationManager->setComplexAnimationStep(loadingAnimationInst, currentProgressStep, map(stepProgress, 0, progressTotal / NUM_SEGMENTS_PROGRESS, 0, LoadingProgressAnimation->LengthPerAnimation));
+}
+
+void DisplayManager::postProgress(uint32_t progress, uint32_t total)
+{
+	uint32_t scaledProgress = total == 0 ? ProgressResolution : (uint64_t)std::min(progress, total) * ProgressResolution / total;
+	//offset by one as 0 marks an empty mailbox
+	progressMailbox.store(scaledProgress + 1, std::memory_order_release);
+}
+
+void DisplayManager::postProgressEnd()
+{
+	progressMailbox.store(ProgressEnd, std::memory_order_release);
+}
+
+bool DisplayManager::isShowingProgress()
+{
+	return progressShown;
+}
+
+void DisplayManager::renderPostedProgress(uint32_t posted)
+{
+	if(posted == ProgressEnd)
+	{
+		if(progressShown)
+		{
+			progressShown = false;
+			turnAllLEDsOff();
+		}
+		return;
+	}
+	if(progressShown == false)
+	{
+		progressShown = true;
+		setAllSegmentColors(OTA_UPDATE_COLOR);
+		turnAllLEDsOff();
+		setGlobalBrightness(50);
+		displayProgress(ProgressResolution);
+	}
+	updateProgress(posted - 1);
 }
 
 void DisplayManager::delay(uint32_t timeInMs)
@@ -430,25 +641,56 @@ void DisplayManager::delay(uint32_t timeInMs)
 void DisplayManager::setGlobalBrightness(uint8_t brightness, bool enableSmoothTransition)
 {
 	currentLEDBrightness = brightness;
+	if(idle)
+	{
+		return;
+	}
 
+	//the light sensor, night mode and the user setting all end up in this one target
 	#if ENABLE_LIGHT_SENSOR == true
-		LEDBrightnessSetPoint = constrain(brightness - lightSensorBrightness, 0, 255);
-		LOG_I(TAG, "Set the LED Brightness: %d", LEDBrightnessSetPoint);
+		uint8_t target = constrain(brightness - lightSensorBrightness, 0, 255);
+		LOG_I(TAG, "Set the LED Brightness: %d", target);
 	#else
-		LEDBrightnessSetPoint = brightness;
+		uint8_t target = brightness;
 	#endif
 	if(enableSmoothTransition)
 	{
-		LEDBrightnessSmoothingStartPoint = LEDBrightnessCurrent;
-		lastBrightnessChange = millis();
+		brightnessRamp.setTarget(target, millis());
 	}
 	else
 	{
-		LEDBrightnessSmoothingStartPoint = LEDBrightnessCurrent = LEDBrightnessSetPoint;
-		FastLED.setBrightness(LEDBrightnessCurrent);
-		LOG_I(TAG, "Get Global brightness: %d", lightSensorBrightness);
+		brightnessRamp.jumpTo(target, millis());
+		FastLED.setBrightness(brightnessRamp.getBrightness());
+		LOG_I(TAG, "Get Global brightness: %d", target);
+	}
+}
 
+void DisplayManager::setIdle(bool enable)
+{
+	if(enable == idle)
+	{
+		return;
 	}
+	idle = enable;
+	idleDark = false;
+	if(idle)
+	{
+		brightnessRamp.setTarget(0, millis());
+	}
+	else
+	{
+		setGlobalBrightness(currentLEDBrightness, false);
+	}
+}
+
+bool DisplayManager::isDark()
+{
+	return idleDark;
+}
+
+uint32_t DisplayManager::getLEDPower()
+{
+	return calculate_unscaled_power_mW(leds, NUM_LEDS) * FastLED.getBrightness() / 256;
 }
 
 void DisplayManager::flashSeparationDot(uint8_t numDots)
@@ -470,43 +712,7 @@ void DisplayManager::test()
 	{
 		direction *= -1;
 	}
+	invalidateCommittedDigits();
 	Displays[0]->DisplayNumber(count);
 
 }
-
-int16_t DisplayManager::getGlobalSegmentIndex(SegmentPositions_t segmentPosition, DisplayIDs Display)
-{
-	for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
-	{
-		if(diplayIndex[i] == Display && SegmentPositions[i] == (1 << segmentPosition))
-		{
-			return i;
-		}
-	}
-	if(!Serial.availableForWrite()) // during startup Serial is not availiable yet so put the errors to a list
-	{
-		if(SegmentIndexErrorList == nullptr)
-		{
-			SegmentIndexErrorList = new AnimatorLinkedList::LinkedList<SegmentInstanceError>();
-		}
-		SegmentInstanceError newError = {.segmentPosition = segmentPosition, .Display = Display};
-		SegmentIndexErrorList->add(newError);
-	}
-	else // once Serial was initialized print errors right away to not forget about them
-	{
-		LOG_W(TAG, "Segment not valid; Position: %d; Display: %d", segmentPosition, Display);
-	}
-	return NO_SEGMENTS;
-}
-
-void DisplayManager::printAnimationInitErrors()
-{
-	if(SegmentIndexErrorList != nullptr)
-	{
-		while(SegmentIndexErrorList->size() > 0)
-		{
-			SegmentInstanceError currentError =	SegmentIndexErrorList->pop();
-			LOG_W(TAG, "Segment not valid; Position: %d; Display: %d", currentError.segmentPosition, currentError.Display);
-		}
-	}
-}
@@ -0,0 +1,237 @@
+/**
+ * \file FrameRecorder.cpp
+ * \author Yves Gaignard
+ * \brief Implementation of the FrameRecorder class member functions
+ */
+
+#include "FrameRecorder.h"
+
+#if ENABLE_FRAME_RECORDER == true
+
+FrameRecorder::FrameRecorder()
+{
+	oldest = 0;
+	used = 0;
+	baseTime = 0;
+	baseBrightness = 0;
+	previousTime = 0;
+	previousBrightness = 0;
+	hasFrame = false;
+	recordedFrames = 0;
+	skippedFrames = 0;
+	downloads = 0;
+}
+
+uint16_t FrameRecorder::encode(const CRGB* frame)
+{
+	uint16_t length = 0;
+	uint16_t lastChange = 0;
+	uint16_t i = 0;
+	while (i < NumLeds)
+	{
+		uint16_t run = 1;
+		if(frame[i] == previousFrame[i])
+		{
+			while (i + run < NumLeds && run < MaxRun && frame[i + run] == previousFrame[i + run])
+			{
+				run++;
+			}
+			payload[length++] = run - 1;
+		}
+		else
+		{
+			while (i + run < NumLeds && run < MaxRun && frame[i + run] != previousFrame[i + run])
+			{
+				run++;
+			}
+			payload[length++] = 0x80 | (run - 1);
+			for (uint16_t j = i; j < i + run; j++)
+			{
+				payload[length++] = frame[j].r;
+				payload[length++] = frame[j].g;
+				payload[length++] = frame[j].b;
+			}
+			lastChange = length;
+		}
+		i += run;
+	}
+	//the LEDs after the last change stay as they are, no need to skip them
+	return lastChange;
+}
+
+void FrameRecorder::write(const uint8_t* data, uint32_t length)
+{
+	uint32_t position = (oldest + used) % FRAME_RECORDER_BUFFER_SIZE;
+	for (uint32_t i = 0; i < length; i++)
+	{
+		ring[position] = data[i];
+		position = (position + 1) % FRAME_RECORDER_BUFFER_SIZE;
+	}
+	used += length;
+}
+
+uint8_t FrameRecorder::readByte(uint32_t offset) const
+{
+	return ring[(oldest + offset) % FRAME_RECORDER_BUFFER_SIZE];
+}
+
+void FrameRecorder::dropOldest()
+{
+	uint16_t elapsed = readByte(0) | (readByte(1) << 8);
+	uint8_t brightness = readByte(2);
+	uint16_t length = readByte(3) | (readByte(4) << 8);
+
+	//apply the record to the base frame so the recording still decodes without it
+	uint32_t offset = RecordHeaderSize;
+	uint16_t led = 0;
+	while (offset < (uint32_t)RecordHeaderSize + length)
+	{
+		uint8_t token = readByte(offset++);
+		uint16_t run = (token & 0x7F) + 1;
+		if(token & 0x80)
+		{
+			for (uint16_t j = 0; j < run; j++)
+			{
+				baseFrame[led + j].r = readByte(offset++);
+				baseFrame[led + j].g = readByte(offset++);
+				baseFrame[led + j].b = readByte(offset++);
+			}
+		}
+		led += run;
+	}
+	baseTime += elapsed;
+	baseBrightness = brightness;
+
+	oldest = (oldest + RecordHeaderSize + length) % FRAME_RECORDER_BUFFER_SIZE;
+	used -= RecordHeaderSize + length;
+}
+
+void FrameRecorder::record(const CRGB* frame, uint8_t brightness, unsigned long now)
+{
+	std::unique_lock<std::mutex> guard(lock, std::try_to_lock);
+	if(!guard.owns_lock() || downloads > 0)
+	{
+		skippedFrames++;
+		return;
+	}
+
+	if(hasFrame == false)
+	{
+		std::copy(frame, frame + NumLeds, baseFrame);
+		std::copy(frame, frame + NumLeds, previousFrame);
+		baseTime = previousTime = now;
+		baseBrightness = previousBrightness = brightness;
+		hasFrame = true;
+		return;
+	}
+
+	uint16_t length = encode(frame);
+	if(length == 0 && brightness == previousBrightness && now - previousTime < UINT16_MAX)
+	{
+		return;
+	}
+
+	//the time between two records is stored in 16 bit, longer pauses are bridged with empty records
+	while (now - previousTime > UINT16_MAX)
+	{
+		while (FRAME_RECORDER_BUFFER_SIZE - used < RecordHeaderSize)
+		{
+			dropOldest();
+		}
+		uint8_t header[RecordHeaderSize] = {0xFF, 0xFF, previousBrightness, 0, 0};
+		write(header, RecordHeaderSize);
+		previousTime += UINT16_MAX;
+	}
+
+	uint16_t elapsed = now - previousTime;
+	while (FRAME_RECORDER_BUFFER_SIZE - used < (uint32_t)RecordHeaderSize + length)
+	{
+		dropOldest();
+	}
+	uint8_t header[RecordHeaderSize] = {(uint8_t)elapsed, (uint8_t)(elapsed >> 8), brightness, (uint8_t)length, (uint8_t)(length >> 8)};
+	write(header, RecordHeaderSize);
+	write(payload, length);
+
+	std::copy(frame, frame + NumLeds, previousFrame);
+	previousTime = now;
+	previousBrightness = brightness;
+	recordedFrames++;
+
+	//only keep the last seconds, the space is freed for the next records
+	while (used > 0 && now - (baseTime + (readByte(0) | (readByte(1) << 8))) > FRAME_RECORDER_DURATION)
+	{
+		dropOldest();
+	}
+}
+
+uint8_t FrameRecorder::fileByte(uint32_t offset) const
+{
+	if(offset < FileHeaderSize)
+	{
+		const uint8_t header[FileHeaderSize] = {'P', 'C', 'F', 'R', FileVersion, 0, (uint8_t)NumLeds, (uint8_t)(NumLeds >> 8)};
+		return header[offset];
+	}
+	offset -= FileHeaderSize;
+	if(offset < BaseHeaderSize)
+	{
+		return offset < 4 ? (uint8_t)(baseTime >> (8 * offset)) : baseBrightness;
+	}
+	offset -= BaseHeaderSize;
+	if(offset < NumLeds * 3)
+	{
+		const CRGB& led = baseFrame[offset / 3];
+		return offset % 3 == 0 ? led.r : offset % 3 == 1 ? led.g : led.b;
+	}
+	return readByte(offset - NumLeds * 3);
+}
+
+uint32_t FrameRecorder::beginDownload()
+{
+	std::lock_guard<std::mutex> guard(lock);
+	downloads++;
+	return FileHeaderSize + BaseHeaderSize + NumLeds * 3 + used;
+}
+
+size_t FrameRecorder::readDownload(uint8_t* buffer, size_t maxLength, size_t index)
+{
+	std::lock_guard<std::mutex> guard(lock);
+	uint32_t size = FileHeaderSize + BaseHeaderSize + NumLeds * 3 + used;
+	size_t length = 0;
+	while (length < maxLength && index + length < size)
+	{
+		buffer[length] = fileByte(index + length);
+		length++;
+	}
+	return length;
+}
+
+void FrameRecorder::endDownload()
+{
+	std::lock_guard<std::mutex> guard(lock);
+	if(downloads > 0)
+	{
+		downloads--;
+	}
+}
+
+uint32_t FrameRecorder::getRecordedFrames() const
+{
+	return recordedFrames;
+}
+
+uint32_t FrameRecorder::getSkippedFrames() const
+{
+	return skippedFrames;
+}
+
+uint32_t FrameRecorder::getUsedBytes() const
+{
+	return used;
+}
+
+unsigned long FrameRecorder::getRecordedDuration() const
+{
+	return hasFrame ? previousTime - baseTime : 0;
+}
+
+#endif
@@ -0,0 +1,107 @@
+/**
+ * \file PushButton.h
+ * \author Yves Gaignard
+ * \brief Header for class definition of the interrupt driven push button
+ */
+
+#ifndef _PUSH_BUTTON_H_
+#define _PUSH_BUTTON_H_
+
+#include <Arduino.h>
+#include "freertos/timers.h"
+
+/**
+ * \brief Push button handled by interrupts instead of polling.
+ *        Every edge on the pin (re)starts a one-shot debounce timer; once the pin has been stable for the debounce
+ *        time the timer callback evaluates the level. A press starts a second one-shot timer which detects the long
+ *        press. Both callbacks run in the FreeRTOS timer task, so all buttons share one single context to report
+ *        their presses from.
+ *
+ *        The semantics are the ones of EasyButton: the press callback is called when a short press is released,
+ *        the long press callback is called once while the button is still held. On top of that a held button can
+ *        auto-repeat: after the long press the long press timer is restarted, slowly for the first repeats and
+ *        faster afterwards, until the button is released.
+ */
+class PushButton
+{
+public:
+	/**
+	 * \brief Callback of a detected press
+	 * \param eventTime micros() of the edge which completed the press (release of a short press) or of the moment
+	 *                  the long press was detected
+	 */
+	typedef void (*PressCallback)(uint32_t eventTime);
+
+	/**
+	 * \brief Callback of an auto-repeat of a held button
+	 * \param eventTime micros() of the repeat
+	 * \param repeat number of the repeat since the long press, starting at 1
+	 */
+	typedef void (*RepeatCallback)(uint32_t eventTime, uint16_t repeat);
+
+private:
+	uint8_t       _pin;
+	uint32_t      _debounceTime;
+	bool          _pullUpEnabled;
+	bool          _activeLow;
+	TimerHandle_t _debounceTimer;
+	TimerHandle_t _longPressTimer;
+	PressCallback _pressedCallback;
+	PressCallback _longPressedCallback;
+	uint32_t      _longPressDuration;
+	RepeatCallback _repeatCallback;
+	uint32_t      _slowRepeatInterval;
+	uint16_t      _slowRepeats;
+	uint32_t      _fastRepeatInterval;
+	uint16_t      _repeatCount;
+	volatile uint32_t   _lastEdgeTime;		/** micros() of the last edge, written by the interrupt */
+	volatile TickType_t _lastTimerReset;	/** tick of the last debounce timer reset, limits the timer commands to one per tick */
+	bool          _pressed;
+	bool          _longPressReported;
+
+	static void IRAM_ATTR onEdge(void* arg);
+	static void onDebounced(TimerHandle_t timer);
+	static void onLongPress(TimerHandle_t timer);
+	void restartLongPressTimer(uint32_t duration);
+
+public:
+	/**
+	 * \brief Construct a new Push Button object
+	 * \param pin GPIO the button is connected to
+	 * \param debounceTime time in ms the pin has to be stable before its level is taken
+	 * \param pullUpEnabled enable the internal pull-up resistor
+	 * \param activeLow the button pulls the pin to ground when pressed
+	 */
+	PushButton(uint8_t pin, uint32_t debounceTime = 30, bool pullUpEnabled = true, bool activeLow = true);
+
+	/**
+	 * \brief Configures the pin, creates the timers and attaches the interrupt
+	 */
+	void begin();
+
+	/**
+	 * \brief Set the callback of a short press, called on release
+	 */
+	void onPressed(PressCallback callback);
+
+	/**
+	 * \brief Set the callback of a long press, called once the button was held for the given duration
+	 * \param duration time in ms the button has to be held
+	 */
+	void onPressedFor(uint32_t duration, PressCallback callback);
+
+	/**
+	 * \brief Set the callback of the auto-repeat, called while the button is still held after the long press
+	 * \param slowInterval time in ms between the first repeats
+	 * \param slowRepeats number of repeats at the slow interval
+	 * \param fastInterval time in ms between the following repeats
+	 */
+	void onRepeat(RepeatCallback callback, uint32_t slowInterval, uint16_t slowRepeats, uint32_t fastInterval);
+
+	/**
+	 * \brief Returns the debounced state of the button
+	 */
+	bool isPressed() const;
+};
+
+#endif
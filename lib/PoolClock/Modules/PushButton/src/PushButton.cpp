@@ -0,0 +1,139 @@
+/**
+ * \file PushButton.cpp
+ * \author Yves Gaignard
+ * \brief Implementation of the PushButton class member functions
+ */
+
+#include "PushButton.h"
+
+PushButton::PushButton(uint8_t pin, uint32_t debounceTime, bool pullUpEnabled, bool activeLow)
+{
+	_pin                 = pin;
+	_debounceTime        = debounceTime;
+	_pullUpEnabled       = pullUpEnabled;
+	_activeLow           = activeLow;
+	_debounceTimer       = nullptr;
+	_longPressTimer      = nullptr;
+	_pressedCallback     = nullptr;
+	_longPressedCallback = nullptr;
+	_longPressDuration   = 0;
+	_repeatCallback      = nullptr;
+	_slowRepeatInterval  = 0;
+	_slowRepeats         = 0;
+	_fastRepeatInterval  = 0;
+	_repeatCount         = 0;
+	_lastEdgeTime        = 0;
+	_lastTimerReset      = 0;
+	_pressed             = false;
+	_longPressReported   = false;
+}
+
+void PushButton::begin()
+{
+	pinMode(_pin, _pullUpEnabled ? INPUT_PULLUP : INPUT);
+	_pressed = digitalRead(_pin) == (_activeLow ? LOW : HIGH);
+	//the timers are one-shot: the debounce timer is restarted by every edge, the long press timer by every press
+	_debounceTimer = xTimerCreate("Debounce", pdMS_TO_TICKS(_debounceTime) > 0 ? pdMS_TO_TICKS(_debounceTime) : 1, pdFALSE, this, onDebounced);
+	_longPressTimer = xTimerCreate("LongPress", 1, pdFALSE, this, onLongPress);
+	attachInterruptArg(digitalPinToInterrupt(_pin), onEdge, this, CHANGE);
+}
+
+void PushButton::onPressed(PressCallback callback)
+{
+	_pressedCallback = callback;
+}
+
+void PushButton::onPressedFor(uint32_t duration, PressCallback callback)
+{
+	_longPressDuration = duration;
+	_longPressedCallback = callback;
+}
+
+void PushButton::onRepeat(RepeatCallback callback, uint32_t slowInterval, uint16_t slowRepeats, uint32_t fastInterval)
+{
+	_slowRepeatInterval = slowInterval;
+	_slowRepeats = slowRepeats;
+	_fastRepeatInterval = fastInterval;
+	_repeatCallback = callback;
+}
+
+bool PushButton::isPressed() const
+{
+	return _pressed;
+}
+
+void IRAM_ATTR PushButton::onEdge(void* arg)
+{
+	PushButton* button = (PushButton*)arg;
+	button->_lastEdgeTime = micros();
+	//a bouncing contact fires many edges, one timer command per tick is enough to restart the debounce time
+	TickType_t now = xTaskGetTickCountFromISR();
+	if(now != button->_lastTimerReset)
+	{
+		button->_lastTimerReset = now;
+		BaseType_t higherPriorityTaskWoken = pdFALSE;
+		xTimerResetFromISR(button->_debounceTimer, &higherPriorityTaskWoken);
+		if(higherPriorityTaskWoken == pdTRUE)
+		{
+			portYIELD_FROM_ISR();
+		}
+	}
+}
+
+void PushButton::onDebounced(TimerHandle_t timer)
+{
+	PushButton* button = (PushButton*)pvTimerGetTimerID(timer);
+	bool pressed = digitalRead(button->_pin) == (button->_activeLow ? LOW : HIGH);
+	if(pressed == button->_pressed)
+	{
+		return;
+	}
+	button->_pressed = pressed;
+	if(pressed)
+	{
+		button->_longPressReported = false;
+		button->_repeatCount = 0;
+		if(button->_longPressedCallback != nullptr)
+		{
+			//the debounce time already passed since the press
+			button->restartLongPressTimer(button->_longPressDuration > button->_debounceTime ? button->_longPressDuration - button->_debounceTime : 1);
+		}
+	}
+	else
+	{
+		xTimerStop(button->_longPressTimer, 0);
+		if(button->_longPressReported == false && button->_pressedCallback != nullptr)
+		{
+			button->_pressedCallback(button->_lastEdgeTime);
+		}
+	}
+}
+
+void PushButton::onLongPress(TimerHandle_t timer)
+{
+	PushButton* button = (PushButton*)pvTimerGetTimerID(timer);
+	if(button->_pressed == false)
+	{
+		return;
+	}
+	if(button->_longPressReported == false)
+	{
+		button->_longPressReported = true;
+		button->_longPressedCallback(micros());
+	}
+	else if(button->_repeatCallback != nullptr)
+	{
+		button->_repeatCount++;
+		button->_repeatCallback(micros(), button->_repeatCount);
+	}
+	if(button->_repeatCallback != nullptr)
+	{
+		//the release stops the timer, the button repeats as long as it is held
+		button->restartLongPressTimer(button->_repeatCount < button->_slowRepeats ? button->_slowRepeatInterval : button->_fastRepeatInterval);
+	}
+}
+
+void PushButton::restartLongPressTimer(uint32_t duration)
+{
+	xTimerChangePeriod(_longPressTimer, pdMS_TO_TICKS(duration) > 0 ? pdMS_TO_TICKS(duration) : 1, 0);
+}
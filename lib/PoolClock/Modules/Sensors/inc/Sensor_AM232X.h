@@ -67,8 +67,9 @@ public:
     /**
      * \brief Has to be called periodically to read the sensor
      *
+     * \return true if a new measurement was read
      */
-	void handle();
+	bool handle();
 };
 
 #endif
@@ -63,8 +63,8 @@ class Sensor_DS18B20 {
     // Get the handle of the DallasTemperature object
     DallasTemperature& getSensors();
 
-    // sends command for all devices on the bus to perform a temperature conversion
-    void requestTemperatures();
+    // sends command for all devices on the bus to perform a temperature conversion, returns true if a new conversion was done
+    bool requestTemperatures();
 
     // Request temperature (float precision) for the sensor through its index in the array
     float getPreciseTempCByIndex(int idx);
@@ -26,6 +26,10 @@ private:
 
 	Sensor_HCSR501();
 public:
+    /**
+     * \brief Called from the interrupt when a motion starts, must be short and ISR safe
+     */
+    typedef void (*MotionCallback)();
 
     /**
      * \brief Get the instance of the Sensor_HCSR501 object or create it if it was not yet instantiated.
@@ -60,6 +64,12 @@ public:
      */
     bool isMotionDetected();
 
+    /**
+     * \brief Calls the callback from the pin interrupt each time the sensor detects a new motion (rising edge)
+     * \pre #Sensor_HCSR501::init was called
+     */
+    void onMotion(MotionCallback callback);
+
 };
 
 #endif
@@ -91,7 +91,7 @@ float Sensor_AM232X::getHumidity()
     return _humidity;
 }
 
-void Sensor_AM232X::handle()
+bool Sensor_AM232X::handle()
 {
     if (_is_init)
     {
@@ -119,7 +119,8 @@ void Sensor_AM232X::handle()
             LOG_D(TAG, "AM232X sensor humidity    = %4.2f", _humidity);
 
             _last_read = millis();
+            return true;
         }
     }
-
+    return false;
 }
@@ -121,18 +121,20 @@ DallasTemperature& Sensor_DS18B20::getSensors() {
 }
 
 // sends command for all devices on the bus to perform a temperature conversion
-void Sensor_DS18B20::requestTemperatures() {
+bool Sensor_DS18B20::requestTemperatures() {
   if (_isInit) {
     uint64_t currentMillis = millis();
     if (currentMillis - _lastRead > uint64_t(_readFrequency) ) {
       _request = _sensors.requestTemperatures();
       _lastRead = millis();
       LOG_D(TAG, "_sensors.requestTemperatures() at: %lu", _lastRead);
+      return true;
     }
   }
   else {
     LOG_E(TAG, "TempManager object not initialized");
   }
+  return false;
 }
 
 // Request temperature (float precision) for the sensor through its index in the array
@@ -90,4 +90,8 @@ bool Sensor_HCSR501::isMotionDetected() {
     }
     else
         return false;
-}
\ No newline at end of file
+}
+
+void Sensor_HCSR501::onMotion(MotionCallback callback) {
+    attachInterrupt(digitalPinToInterrupt(_pir_pin), callback, RISING);
+}
@@ -0,0 +1,85 @@
+/**
+ * \file SettingsStore.h
+ * \author Yves Gaignard
+ * \brief Header for class definition of the #SettingsStore which keeps the user settings over a power cycle
+ */
+
+#ifndef _SETTINGS_STORE_H_
+#define _SETTINGS_STORE_H_
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include "ClockState.h"
+
+/**
+ * \brief Keeps the settings of the clock in the NVS flash. They are read once at boot and held in RAM, a save only
+ *        writes the flash if the settings differ from the ones stored. The caller coalesces the changes, see
+ *        #SETTINGS_SAVE_DELAY, so dragging a slider in the app costs one flash write and not one per step.
+ *
+ *        The settings are stored as one blob with a version and a size: a blob written by a firmware with a
+ *        different layout is ignored and the defaults are kept.
+ */
+class SettingsStore
+{
+public:
+	/**
+	 * \brief Content of the NVS blob
+	 */
+	typedef struct
+	{
+		uint16_t              version;
+		uint16_t              size;
+		ClockState::Settings  settings;
+	}Record;
+
+private:
+	static SettingsStore* _instance;
+	static constexpr const char* Namespace = "PoolClock";
+	static constexpr const char* Key       = "settings";
+	static constexpr uint16_t    Version   = 1;		/** increment when #ClockState::Settings or its members change */
+	Preferences _preferences;
+	Record      _stored;			/** copy of the blob in the flash */
+	bool        _valid;				/** whether _stored holds settings read or written */
+	uint32_t    _flashWrites;
+	uint32_t    _skippedWrites;
+	uint32_t    _failedWrites;
+
+	SettingsStore();
+public:
+	/**
+	 * \brief Get the instance of the SettingsStore object or create it if it was not yet instantiated.
+	 */
+	static SettingsStore* getInstance();
+
+	/**
+	 * \brief Reads the settings from the flash, to be called once in the setup
+	 *
+	 * \param settings filled with the stored settings, untouched if there are none
+	 * \return true if valid settings were found
+	 */
+	bool load(ClockState::Settings& settings);
+
+	/**
+	 * \brief Writes the settings to the flash if they differ from the stored ones
+	 *
+	 * \return true if the settings are stored, whether they had to be written or not
+	 */
+	bool save(const ClockState::Settings& settings);
+
+	/**
+	 * \brief Number of writes to the flash since the boot
+	 */
+	uint32_t getFlashWrites();
+
+	/**
+	 * \brief Number of saves since the boot which did not write because nothing changed
+	 */
+	uint32_t getSkippedWrites();
+
+	/**
+	 * \brief Number of writes since the boot which failed
+	 */
+	uint32_t getFailedWrites();
+};
+
+#endif
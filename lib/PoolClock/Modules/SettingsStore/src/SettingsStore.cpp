@@ -0,0 +1,103 @@
+/**
+ * \file SettingsStore.cpp
+ * \author Yves Gaignard
+ * \brief Implementation of the SettingsStore class member functions
+ */
+#define TAG "SettingsStore"
+
+#include "SettingsStore.h"
+#include "LogManager.h"
+
+SettingsStore* SettingsStore::_instance = nullptr;
+
+SettingsStore::SettingsStore()
+{
+	_stored = Record();
+	_valid         = false;
+	_flashWrites   = 0;
+	_skippedWrites = 0;
+	_failedWrites  = 0;
+}
+
+SettingsStore* SettingsStore::getInstance()
+{
+	if(_instance == nullptr)
+	{
+		_instance = new SettingsStore();
+	}
+	return _instance;
+}
+
+bool SettingsStore::load(ClockState::Settings& settings)
+{
+	if(!_preferences.begin(Namespace, true))
+	{
+		//the namespace only exists once something was written
+		LOG_I(TAG, "No settings stored, using the defaults");
+		return false;
+	}
+	Record record;
+	size_t length = _preferences.getBytesLength(Key);
+	bool found = length == sizeof(Record) && _preferences.getBytes(Key, &record, sizeof(Record)) == sizeof(Record);
+	_preferences.end();
+	if(!found)
+	{
+		LOG_I(TAG, "No settings stored, using the defaults");
+		return false;
+	}
+	if(record.version != Version || record.size != sizeof(ClockState::Settings))
+	{
+		LOG_W(TAG, "Settings version %d of %d bytes can't be read, using the defaults", record.version, record.size);
+		return false;
+	}
+	_stored = record;
+	_valid = true;
+	settings = record.settings;
+	LOG_I(TAG, "Settings loaded");
+	return true;
+}
+
+bool SettingsStore::save(const ClockState::Settings& settings)
+{
+	if(_valid && memcmp(&_stored.settings, &settings, sizeof(ClockState::Settings)) == 0)
+	{
+		_skippedWrites++;
+		return true;
+	}
+	Record record{};
+	record.version  = Version;
+	record.size     = sizeof(ClockState::Settings);
+	record.settings = settings;
+	bool written = false;
+	if(_preferences.begin(Namespace, false))
+	{
+		written = _preferences.putBytes(Key, &record, sizeof(Record)) == sizeof(Record);
+		_preferences.end();
+	}
+	if(!written)
+	{
+		_failedWrites++;
+		LOG_E(TAG, "Settings could not be written");
+		return false;
+	}
+	_stored = record;
+	_valid = true;
+	_flashWrites++;
+	LOG_I(TAG, "Settings written, %u writes since the boot", _flashWrites);
+	return true;
+}
+
+uint32_t SettingsStore::getFlashWrites()
+{
+	return _flashWrites;
+}
+
+uint32_t SettingsStore::getSkippedWrites()
+{
+	return _skippedWrites;
+}
+
+uint32_t SettingsStore::getFailedWrites()
+{
+	return _failedWrites;
+}
@@ -28,6 +28,7 @@ SevenSegment::SevenSegment(SevenSegmentMode mode, Animator* DisplayAnimationHand
 	DisplayMode = mode;
 	AnimationHandler = DisplayAnimationHandler;
 	isAnimationInitialized = false;
+	currentValue = SEGMENT_OFF;
 	for (uint8_t i = 0; i < 7; i++)
 	{
 		Segments[i] = nullptr;
@@ -235,6 +236,7 @@ void SevenSegment::off()
 			Segments[i]->off();
 		}
 	}
+	currentValue = SEGMENT_OFF;
 }
 
 bool SevenSegment::canDisplay(char charToCheck)
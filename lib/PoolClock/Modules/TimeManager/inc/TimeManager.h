@@ -11,12 +11,19 @@
 
 #include <Arduino.h>
 #include "time.h"
+#include <atomic>
+#include <mutex>
 #include "TimeManagerConfiguration.h"
 #if RUN_WITHOUT_WIFI == false
 	#include "WiFi.h"
 #endif
 
 
+/**
+ * \brief Keeps the time, the timer and the alarm. The hardware timer interrupt only counts the seconds and wakes up
+ *        the time task, which advances the time and calls the callbacks. The state is shared with the other tasks
+ *        through the public methods, which all take the state lock.
+ */
 class TimeManager
 {
 	friend void IRAM_ATTR onTimer();
@@ -57,15 +64,42 @@ public:
 	 * \brief Timer callback function type which is called if a timer ticks or is elapsed or an alrm is triggered
 	 */
 	typedef void (*TimerCallBack)(void);
+
+	/**
+	 * \brief State of the time manager kept over a warm restart, see #WarmRestart
+	 */
+	typedef struct
+	{
+		TimeInfo currentTime;
+		uint8_t  currentWeekday;
+		TimeInfo TimerInitialDuration;
+		TimeInfo TimerDuration;
+		bool     TimerModeActive;
+		TimeInfo AlarmTime;
+		Weekdays AlarmActiveDays;
+		bool     AlarmActive;
+		bool     AlarmTriggered;
+		bool     AlarmCleared;
+	}Snapshot;
 private:
+	/**
+	 * \brief Guards the time, the timer and the alarm, which are written by the time task and by the other tasks
+	 */
+	std::mutex stateLock;
 	TimeInfo currentTime;
 	hw_timer_t* timer;
+	TaskHandle_t timeTask;
+	std::atomic<uint32_t> pendingTicks;		/** seconds counted by the interrupt, not yet handled by the time task */
+	uint32_t lateTicks;						/** seconds the time task handled after the next one was already counted */
+	volatile uint32_t lastIsrCycles;		/** CPU cycles of the last run of the interrupt, only written by it */
+	volatile uint32_t maxIsrCycles;
 	uint32_t offlineTimeCounter;
 	static TimeManager* TimeManagerSingleton;
 	TimeInfo TimerInitialDuration;
 	TimeInfo TimerDuration;
 	TimeInfo AlarmTime;
 	Weekdays AlarmActiveDays;
+	TimerCallBack SecondTickCallback;
 	TimerCallBack TimerTickCallback;
 	TimerCallBack TimerDoneCallback;
 	TimerCallBack AlarmTriggeredCallback;
@@ -74,11 +108,15 @@ private:
 	bool AlarmActive;
 	bool AlarmTriggered;
 	bool AlarmCleared;
-	bool SynchronizeRequested;
+	std::atomic<bool> SynchronizeRequested;
 
 	TimeManager();
+	void beginSecondInterrupt();
 	void advanceByOneSecondOffline();
 	void TimerCountDownByOneSecond();
+	void handleSecond();
+	static void TimeTaskCode(void* pvParameters);
+	static bool isInBetween(TimeInfo time, TimeInfo timeStart, TimeInfo timeStop);
 public:
 	/**
 	 * \brief Destroy the Time Manager object
@@ -97,6 +135,27 @@ public:
 	 */
 	bool init();
 
+	/**
+	 * \brief Initialize the time manager from a snapshot after a warm restart, without waiting for the NTP server
+	 *
+	 * \param snapshot State taken by #TimeManager::takeSnapshot before the restart
+	 * \param elapsedSeconds Time between the snapshot and now, the time and a running timer are advanced by it
+	 */
+	void resume(const Snapshot& snapshot, uint32_t elapsedSeconds);
+
+	/**
+	 * \brief Start the NTP synchronization after #TimeManager::resume and wait for the first answer. The time is
+	 *        taken over by the next #TimeManager::handle.
+	 * \pre prerequisite is that WIFI is already up and running
+	 * \returns true if the NTP server answered
+	 */
+	bool startSynchronization();
+
+	/**
+	 * \brief Copy the state which has to survive a warm restart
+	 */
+	void takeSnapshot(Snapshot& snapshot);
+
 	/**
 	 * \brief Handle any Time manager tasks that need to be handled outside of interrupts
 	 */
@@ -157,6 +216,14 @@ public:
 	 */
 	bool isInBetween(TimeInfo timeStart, TimeInfo timeStop);
 
+	/**
+	 * \brief Seconds from the current time until the given time of the day is reached the next time
+	 *
+	 * \param time Time of the day
+	 * \return uint32_t 1 to 86400 seconds, a full day if it is the current time
+	 */
+	uint32_t secondsUntil(TimeInfo time);
+
 	/**
 	 * \brief Adds the specified amount of seconds to a given time
 	 *
@@ -166,6 +233,14 @@ public:
 	 */
 	TimeInfo addSeconds(TimeInfo time, uint16_t secondsToAdd);
 
+	/**
+	 * \brief Set the Second Tick Callback function
+	 *
+	 * \param callback Function which shall be called every time the time advanced by one second. Like the other
+	 *                 callbacks it is called by the time task and has to return quickly.
+	 */
+	void setSecondTickCallback(TimerCallBack callback);
+
 	/**
 	 * \brief Set the Timer Tick Callback function
 	 *
@@ -215,6 +290,21 @@ public:
 	 */
 	void clearAlarm();
 
+	/**
+	 * \brief CPU cycles spent in the last run of the second interrupt
+	 */
+	uint32_t getLastIsrCycles();
+
+	/**
+	 * \brief Highest number of CPU cycles spent in one run of the second interrupt since boot
+	 */
+	uint32_t getMaxIsrCycles();
+
+	/**
+	 * \brief Number of seconds since boot the time task handled only once the next second was already counted
+	 */
+	uint32_t getLateTicks();
+
 };
 
 #endif
@@ -24,6 +24,7 @@ TimeManager::TimeManager()
 	TimerInitialDuration.hours = 0;
 	TimerInitialDuration.minutes = 0;
 	TimerInitialDuration.seconds = 0;
+	SecondTickCallback = nullptr;
 	TimerTickCallback = nullptr;
 	TimerDoneCallback = nullptr;
 	AlarmTriggeredCallback = nullptr;
@@ -33,6 +34,12 @@ TimeManager::TimeManager()
 	AlarmTriggered = false;
 	AlarmCleared = false;
 	SynchronizeRequested = false;
+	timer = nullptr;
+	timeTask = nullptr;
+	pendingTicks = 0;
+	lateTicks = 0;
+	lastIsrCycles = 0;
+	maxIsrCycles = 0;
 }
 
 TimeManager::~TimeManager()
@@ -50,11 +57,21 @@ TimeManager* TimeManager::getInstance()
 	return TimeManagerSingleton;
 }
 
-bool TimeManager::init()
+void TimeManager::beginSecondInterrupt()
 {
-	#if TIME_MANAGER_DEMO_MODE == false
-		configTzTime(TIMEZONE_INFO, NTP_SERVER);
-	#endif
+	//the interrupt only wakes up the time task, it has to exist before the first second is counted
+	if(timeTask == nullptr)
+	{
+		xTaskCreatePinnedToCore(
+		TimeTaskCode,			// Task function.
+		"TimeManager",			// name of task.
+		TIME_TASK_STACK_SIZE,	// Stack size of task
+		this,					// parameter of the task
+		TIME_TASK_PRIORITY,		// priority of the task
+		&timeTask,				// Task handle to keep track of created task
+		TIME_TASK_CORE);		// pin task to core
+	}
+
 	// timer 0 divider 80 because 80Mhz and count up
 	timer = timerBegin(0, 80, true);
 
@@ -63,6 +80,14 @@ bool TimeManager::init()
 
 	// Set alarm to call onTimer function every second 1 tick is 1us
 	timerAlarmWrite(timer, 1000000, true);
+}
+
+bool TimeManager::init()
+{
+	#if TIME_MANAGER_DEMO_MODE == false
+		configTzTime(TIMEZONE_INFO, NTP_SERVER);
+	#endif
+	beginSecondInterrupt();
 
 	//synchronize the time for the first time then start the timer
 	uint8_t retry = 0;
@@ -80,6 +105,72 @@ bool TimeManager::init()
 	return true;
 }
 
+void TimeManager::resume(const Snapshot& snapshot, uint32_t elapsedSeconds)
+{
+	std::unique_lock<std::mutex> guard(stateLock);
+	currentTime          = snapshot.currentTime;
+	currentWeekday       = snapshot.currentWeekday;
+	TimerInitialDuration = snapshot.TimerInitialDuration;
+	TimerDuration        = snapshot.TimerDuration;
+	TimerModeActive      = snapshot.TimerModeActive;
+	AlarmTime            = snapshot.AlarmTime;
+	AlarmActiveDays      = snapshot.AlarmActiveDays;
+	AlarmActive          = snapshot.AlarmActive;
+	AlarmTriggered       = snapshot.AlarmTriggered;
+	AlarmCleared         = snapshot.AlarmCleared;
+	for (uint32_t i = 0; i < elapsedSeconds; i++)
+	{
+		advanceByOneSecondOffline();
+		//a timer which expired during the restart fires with the next tick, once the callbacks are set again
+		if(TimerModeActive == true && (TimerDuration.hours != 0 || TimerDuration.minutes != 0 || TimerDuration.seconds > 1))
+		{
+			TimerCountDownByOneSecond();
+		}
+	}
+	//the time is synchronized as soon as the WIFI is connected again
+	offlineTimeCounter = TIME_SYNC_INTERVAL;
+	guard.unlock();
+	beginSecondInterrupt();
+	timerAlarmEnable(timer);
+}
+
+bool TimeManager::startSynchronization()
+{
+	#if TIME_MANAGER_DEMO_MODE == false
+		configTzTime(TIMEZONE_INFO, NTP_SERVER);
+		struct tm timeinfo;
+		uint8_t retry = 0;
+		bool synchronized = getLocalTime(&timeinfo);
+		while(synchronized != true && retry < 20)
+		{
+			synchronized = getLocalTime(&timeinfo);
+			retry++;
+		}
+		if(synchronized == false)
+		{
+			LOG_E(TAG, "TimeManager failed to get time from NTP server");
+			return false;
+		}
+	#endif
+	SynchronizeRequested = true;
+	return true;
+}
+
+void TimeManager::takeSnapshot(Snapshot& snapshot)
+{
+	std::lock_guard<std::mutex> guard(stateLock);
+	snapshot.currentTime          = currentTime;
+	snapshot.currentWeekday       = currentWeekday;
+	snapshot.TimerInitialDuration = TimerInitialDuration;
+	snapshot.TimerDuration        = TimerDuration;
+	snapshot.TimerModeActive      = TimerModeActive;
+	snapshot.AlarmTime            = AlarmTime;
+	snapshot.AlarmActiveDays      = AlarmActiveDays;
+	snapshot.AlarmActive          = AlarmActive;
+	snapshot.AlarmTriggered       = AlarmTriggered;
+	snapshot.AlarmCleared         = AlarmCleared;
+}
+
 String TimeManager::getCurrentTimeString(TimeManager::TimeFormat timeFormat)
 {
 	char buf[10];
@@ -112,11 +203,13 @@ String TimeManager::getCurrentTimerString(TimeManager::TimeFormat timeFormat)
 
 TimeManager::TimeInfo TimeManager::getCurrentTime()
 {
+	std::lock_guard<std::mutex> guard(stateLock);
 	return currentTime;
 }
 
 TimeManager::TimeInfo TimeManager::getRemainingTimerTime()
 {
+	std::lock_guard<std::mutex> guard(stateLock);
 	return TimerDuration;
 }
 
@@ -128,6 +221,8 @@ bool TimeManager::synchronize()
 		LOG_E(TAG, "TimeManager failed to get time from NTP server");
 		return false;
 	}
+	//getLocalTime may wait for the server, the lock is only taken to copy its answer
+	std::lock_guard<std::mutex> guard(stateLock);
 	currentTime.hours 	= timeinfo.tm_hour;
 	currentTime.minutes = timeinfo.tm_min;
 	currentTime.seconds = timeinfo.tm_sec;
@@ -188,25 +283,33 @@ void TimeManager::TimerCountDownByOneSecond()
 
 void TimeManager::setTimerDuration(TimeInfo newTimerDuration)
 {
+	std::lock_guard<std::mutex> guard(stateLock);
 	TimerInitialDuration = newTimerDuration;
 	TimerDuration = newTimerDuration;
 }
 
 void TimeManager::startTimer()
 {
+	std::lock_guard<std::mutex> guard(stateLock);
 	TimerModeActive = true;
 }
 
 void TimeManager::stopTimer()
 {
+	std::lock_guard<std::mutex> guard(stateLock);
 	TimerModeActive = false;
 }
 
 bool TimeManager::isInBetween(TimeInfo timeStart, TimeInfo timeStop)
+{
+	return isInBetween(getCurrentTime(), timeStart, timeStop);
+}
+
+bool TimeManager::isInBetween(TimeInfo time, TimeInfo timeStart, TimeInfo timeStop)
 {
 	uint32_t startTime = timeStart.hours * 3600 + timeStart.minutes * 60 + timeStart.seconds;
 	uint32_t endTime = timeStop.hours * 3600 + timeStop.minutes * 60 + timeStop.seconds;
-	uint32_t nowTime = currentTime.hours * 3600 + currentTime.minutes * 60 + currentTime.seconds;
+	uint32_t nowTime = time.hours * 3600 + time.minutes * 60 + time.seconds;
 
 	if(startTime > endTime)
 	{
@@ -225,6 +328,15 @@ bool TimeManager::isInBetween(TimeInfo timeStart, TimeInfo timeStop)
 	return false;
 }
 
+uint32_t TimeManager::secondsUntil(TimeInfo time)
+{
+	TimeInfo now = getCurrentTime();
+	uint32_t targetTime = time.hours * 3600 + time.minutes * 60 + time.seconds;
+	uint32_t nowTime = now.hours * 3600 + now.minutes * 60 + now.seconds;
+	uint32_t seconds = (targetTime + 86400 - nowTime) % 86400;
+	return seconds == 0 ? 86400 : seconds;
+}
+
 TimeManager::TimeInfo TimeManager::addSeconds(TimeInfo time, uint16_t secondsToAdd)
 {
 	uint32_t Time = time.hours * 3600 + time.minutes * 60 + time.seconds + secondsToAdd;
@@ -235,6 +347,11 @@ TimeManager::TimeInfo TimeManager::addSeconds(TimeInfo time, uint16_t secondsToA
 	return newTime;
 }
 
+void TimeManager::setSecondTickCallback(TimerCallBack callback)
+{
+	SecondTickCallback = callback;
+}
+
 void TimeManager::setTimerTickCallback(TimerCallBack callback)
 {
 	TimerTickCallback = callback;
@@ -247,6 +364,7 @@ void TimeManager::setTimerDoneCallback(TimerCallBack callback)
 
 void TimeManager::setAlarmTime(TimeInfo alarmTime, Weekdays activeDays)
 {
+	std::lock_guard<std::mutex> guard(stateLock);
 	AlarmTime = alarmTime;
 	AlarmActiveDays = activeDays;
 	AlarmTriggered = false;
@@ -254,6 +372,7 @@ void TimeManager::setAlarmTime(TimeInfo alarmTime, Weekdays activeDays)
 
 void TimeManager::setAlarmMode(bool active)
 {
+	std::lock_guard<std::mutex> guard(stateLock);
 	AlarmActive = active;
 	AlarmTriggered = false;
 }
@@ -265,93 +384,170 @@ void TimeManager::setAlarmCallback(TimerCallBack callback)
 
 bool TimeManager::isAlarmActive()
 {
+	std::lock_guard<std::mutex> guard(stateLock);
 	return AlarmTriggered == true && AlarmCleared == false;
 }
 
 void TimeManager::clearAlarm()
 {
+	std::lock_guard<std::mutex> guard(stateLock);
 	AlarmCleared = true;
 }
 
+uint32_t TimeManager::getLastIsrCycles()
+{
+	return lastIsrCycles;
+}
+
+uint32_t TimeManager::getMaxIsrCycles()
+{
+	return maxIsrCycles;
+}
+
+uint32_t TimeManager::getLateTicks()
+{
+	return lateTicks;
+}
+
 void TimeManager::handle()
 {
 	if(SynchronizeRequested == true)
 	{
 		if(synchronize() == true)
 		{
+			std::lock_guard<std::mutex> guard(stateLock);
 			offlineTimeCounter = 0;
 		}
 		else
 		{
+			std::lock_guard<std::mutex> guard(stateLock);
 			advanceByOneSecondOffline();
 		}
 		SynchronizeRequested = false;
 	}
 }
 
-void IRAM_ATTR onTimer()
+void TimeManager::handleSecond()
 {
-	TimeManager* timeM = TimeManager::getInstance();
-	// Time code, use this for normal operation
+	bool timerTick = false;
+	bool timerDone = false;
+	bool alarmTriggered = false;
 	#if TIME_MANAGER_DEMO_MODE == false
-		if(timeM->offlineTimeCounter++ >= TIME_SYNC_INTERVAL && WiFi.status() == WL_CONNECTED)
-		{
-			timeM->SynchronizeRequested = true;
-		}
-		else
-		{
-			timeM->advanceByOneSecondOffline();
-		}
-		//handle timer
-		if(timeM->TimerModeActive == true)
-		{
-			timeM->TimerCountDownByOneSecond();
-			if(timeM->TimerTickCallback != nullptr)
+		bool connected = WiFi.status() == WL_CONNECTED;
+	#endif
+	{
+		std::lock_guard<std::mutex> guard(stateLock);
+		// Time code, use this for normal operation
+		#if TIME_MANAGER_DEMO_MODE == false
+			if(offlineTimeCounter++ >= TIME_SYNC_INTERVAL && connected)
+			{
+				SynchronizeRequested = true;
+			}
+			else
 			{
-				timeM->TimerTickCallback();
+				advanceByOneSecondOffline();
 			}
-			if(timeM->TimerDuration.hours == 0 && timeM->TimerDuration.minutes == 0 && timeM->TimerDuration.seconds == 0)
+			//handle timer
+			if(TimerModeActive == true)
 			{
-				if(timeM->TimerDoneCallback != nullptr)
+				TimerCountDownByOneSecond();
+				timerTick = true;
+				if(TimerDuration.hours == 0 && TimerDuration.minutes == 0 && TimerDuration.seconds == 0)
 				{
-					timeM->TimerDoneCallback();
+					timerDone = true;
+					TimerDuration = TimerInitialDuration;
+					TimerModeActive = false;
 				}
-				timeM->TimerDuration = timeM->TimerInitialDuration;
-				timeM->TimerModeActive = false;
 			}
-		}
-		// handle the alarm
-		if(((1 << timeM->currentWeekday) & timeM->AlarmActiveDays) != 0)
-		{
-			if(timeM->isInBetween(timeM->AlarmTime, timeM->addSeconds(timeM->AlarmTime, ALARM_NOTIFICATION_PERIOD)))
+			// handle the alarm
+			if(((1 << currentWeekday) & AlarmActiveDays) != 0)
 			{
-				if(timeM->AlarmTriggered == false)
+				if(isInBetween(currentTime, AlarmTime, addSeconds(AlarmTime, ALARM_NOTIFICATION_PERIOD)))
 				{
-					timeM->AlarmTriggered = true;
-					timeM->AlarmCleared = false;
-					if(timeM->AlarmTriggeredCallback != nullptr)
+					if(AlarmTriggered == false)
 					{
-						timeM->AlarmTriggeredCallback();
+						AlarmTriggered = true;
+						AlarmCleared = false;
+						alarmTriggered = true;
 					}
 				}
+				else if(AlarmTriggered == true)
+				{
+					AlarmTriggered = false;
+					AlarmCleared = false;
+				}
 			}
-			else if(timeM->AlarmTriggered == true)
+		#else
+			//DEMO CODE: Useful for testing animations
+			currentTime.minutes++;
+			if(currentTime.minutes > 59)
 			{
-				timeM->AlarmTriggered = false;
-				timeM->AlarmCleared = false;
+				currentTime.hours++;
+				currentTime.minutes = 0;
 			}
-		}
-	#else
-		//DEMO CODE: Useful for testing animations
-		timeM->currentTime.minutes++;
-		if(timeM->currentTime.minutes > 59)
+			if(currentTime.hours > 24)
+			{
+				currentTime.hours = 0;
+			}
+		#endif
+	}
+	//the callbacks switch the mode and read the time again, they are called without the lock
+	if(timerTick && TimerTickCallback != nullptr)
+	{
+		TimerTickCallback();
+	}
+	if(timerDone && TimerDoneCallback != nullptr)
+	{
+		TimerDoneCallback();
+	}
+	if(alarmTriggered && AlarmTriggeredCallback != nullptr)
+	{
+		AlarmTriggeredCallback();
+	}
+	if(SecondTickCallback != nullptr)
+	{
+		SecondTickCallback();
+	}
+}
+
+void TimeManager::TimeTaskCode(void* pvParameters)
+{
+	TimeManager* timeM = (TimeManager*)pvParameters;
+	for(;;)
+	{
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		//every counted second is handled, even if the task was kept from running for more than one
+		uint32_t ticks = timeM->pendingTicks.exchange(0);
+		if(ticks > 1)
 		{
-			timeM->currentTime.hours++;
-			timeM->currentTime.minutes = 0;
+			timeM->lateTicks += ticks - 1;
 		}
-		if(timeM->currentTime.hours > 24)
+		for (uint32_t i = 0; i < ticks; i++)
 		{
-			timeM->currentTime.hours = 0;
+			timeM->handleSecond();
 		}
-	#endif
-}
\ No newline at end of file
+	}
+}
+
+/**
+ * \brief Runs once per second in the interrupt context: counts the second and wakes up the time task, which does
+ *        all the work. Its own duration is measured in CPU cycles.
+ */
+void IRAM_ATTR onTimer()
+{
+	uint32_t start = ESP.getCycleCount();
+	TimeManager* timeM = TimeManager::TimeManagerSingleton;
+	timeM->pendingTicks.fetch_add(1, std::memory_order_relaxed);
+	BaseType_t higherPriorityTaskWoken = pdFALSE;
+	vTaskNotifyGiveFromISR(timeM->timeTask, &higherPriorityTaskWoken);
+	uint32_t cycles = ESP.getCycleCount() - start;
+	timeM->lastIsrCycles = cycles;
+	if(cycles > timeM->maxIsrCycles)
+	{
+		timeM->maxIsrCycles = cycles;
+	}
+	if(higherPriorityTaskWoken == pdTRUE)
+	{
+		portYIELD_FROM_ISR();
+	}
+}
@@ -0,0 +1,85 @@
+/**
+ * \file HysteresisFilter.h
+ * \author Yves Gaignard
+ * \brief Rounds a measurement to an integer with a dead-band and a minimum dwell time between two changes
+ */
+
+#ifndef __HYSTERESIS_FILTER_H_
+#define __HYSTERESIS_FILTER_H_
+
+#include <stdint.h>
+#include <math.h>
+
+/**
+ * \brief Keeps the integer shown for a noisy measurement stable.
+ *        The shown value only changes once the measurement has left the rounding interval of the shown value
+ *        by more than the dead-band, and not before the minimum dwell time has passed since the last change.
+ *        A measurement hovering around 27.5 therefore keeps showing 27 (or 28) instead of flipping on every read.
+ */
+class HysteresisFilter
+{
+private:
+	float deadBand;
+	unsigned long minDwell;
+	int shownValue;
+	int lastRoundedValue;
+	bool hasValue;
+	unsigned long lastChange;
+	uint32_t suppressedChanges;
+
+public:
+	/**
+	 * \brief Construct a new Hysteresis Filter object
+	 * \param deadBandWidth how far the measurement has to be beyond the rounding boundary (0.5) before the shown value changes
+	 * \param minDwellTime minimum time in ms a shown value is kept
+	 */
+	HysteresisFilter(float deadBandWidth, unsigned long minDwellTime)
+	{
+		deadBand = deadBandWidth;
+		minDwell = minDwellTime;
+		shownValue = 0;
+		lastRoundedValue = 0;
+		hasValue = false;
+		lastChange = 0;
+		suppressedChanges = 0;
+	}
+
+	/**
+	 * \brief Feeds a new measurement into the filter
+	 * \param value measurement
+	 * \param now current time in ms
+	 * \return int the value that shall be shown
+	 */
+	int update(float value, unsigned long now)
+	{
+		int roundedValue = round(value);
+		if(hasValue == false)
+		{
+			hasValue = true;
+			shownValue = roundedValue;
+			lastChange = now;
+		}
+		else if(roundedValue != shownValue && fabsf(value - shownValue) > 0.5f + deadBand && now - lastChange >= minDwell)
+		{
+			shownValue = roundedValue;
+			lastChange = now;
+		}
+		else if(roundedValue != lastRoundedValue && roundedValue != shownValue)
+		{
+			//the rounded measurement moved away from the shown value, without the filter this would be a transition
+			suppressedChanges++;
+		}
+		lastRoundedValue = roundedValue;
+		return shownValue;
+	}
+
+	/**
+	 * \brief Number of changes of the rounded measurement which were not shown
+	 */
+	uint32_t getSuppressedChanges() const
+	{
+		return suppressedChanges;
+	}
+};
+
+#endif
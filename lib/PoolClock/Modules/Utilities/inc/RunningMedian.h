@@ -0,0 +1,118 @@
+/**
+ * \file RunningMedian.h
+ * \author Yves Gaignard
+ * \brief Streaming median filter over the last N samples without any heap allocation
+ */
+
+#ifndef __RUNNING_MEDIAN_H_
+#define __RUNNING_MEDIAN_H_
+
+#include <stdint.h>
+#include <algorithm>
+
+/**
+ * \brief Keeps the last SIZE samples in a ring buffer and the same samples in a sorted window next to it.
+ *        A new sample replaces the oldest one in the sorted window: both positions are found with a binary
+ *        search and only the samples in between move by one place, so the window never has to be sorted again.
+ *        The median and the trimmed mean are then read directly from the sorted window.
+ *
+ * \tparam T    type of the samples
+ * \tparam SIZE number of samples the filter is computed over
+ */
+template<typename T, uint16_t SIZE>
+class RunningMedian
+{
+private:
+	T samples[SIZE];	/** samples in the order they were added, #next is the oldest one once the filter is full */
+	T sorted[SIZE];		/** the same samples in ascending order */
+	uint16_t count;
+	uint16_t next;
+
+public:
+	RunningMedian()
+	{
+		clear();
+	}
+
+	/**
+	 * \brief Removes all samples
+	 */
+	void clear()
+	{
+		count = 0;
+		next = 0;
+	}
+
+	/**
+	 * \brief Adds a sample, the oldest sample is dropped once the filter holds SIZE samples
+	 */
+	void add(T value)
+	{
+		if(count < SIZE)
+		{
+			T* insertAt = std::upper_bound(sorted, sorted + count, value);
+			std::copy_backward(insertAt, sorted + count, sorted + count + 1);
+			*insertAt = value;
+			count++;
+		}
+		else
+		{
+			T* removeAt = std::lower_bound(sorted, sorted + count, samples[next]);
+			T* insertAt = std::upper_bound(sorted, sorted + count, value);
+			if(insertAt > removeAt)
+			{
+				// the new sample is bigger, everything in between moves one place down
+				std::copy(removeAt + 1, insertAt, removeAt);
+				*(insertAt - 1) = value;
+			}
+			else
+			{
+				std::copy_backward(insertAt, removeAt, removeAt + 1);
+				*insertAt = value;
+			}
+		}
+		samples[next] = value;
+		next = (next + 1) % SIZE;
+	}
+
+	/**
+	 * \brief Number of samples currently held by the filter
+	 */
+	uint16_t size() const
+	{
+		return count;
+	}
+
+	/**
+	 * \brief Median of all samples, the lower one of the two middle samples for an even number of samples
+	 */
+	T median() const
+	{
+		return count == 0 ? 0 : sorted[(count - 1) / 2];
+	}
+
+	/**
+	 * \brief Average of the width samples in the middle of the sorted window, which drops the outliers on both sides.
+	 *        As long as the filter holds no more than width samples, this is the average of all samples.
+	 */
+	T trimmedMean(uint16_t width) const
+	{
+		if(count == 0)
+		{
+			return 0;
+		}
+		if(width > count || width == 0)
+		{
+			width = count;
+		}
+		uint16_t offset = (count - width) / 2;
+		uint32_t sum = 0;
+		for (uint16_t i = offset; i < offset + width; i++)
+		{
+			sum += sorted[i];
+		}
+		return sum / width;
+	}
+};
+
+#endif
@@ -0,0 +1,88 @@
+/**
+ * \file SpscRing.h
+ * \author Yves Gaignard
+ * \brief Lock-free ring buffer between exactly one producer and one consumer
+ */
+
+#ifndef __SPSC_RING_H_
+#define __SPSC_RING_H_
+
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * \brief Hands items over from one producer to one consumer, e.g. from a task on core 0 to the main loop on core 1,
+ *        without locks. Each index is only written by one side: the producer publishes an item by advancing the head
+ *        with release semantics, the consumer frees it by advancing the tail. An item is therefore never lost nor
+ *        delivered twice; when the ring is full the new item is rejected and counted as dropped.
+ *
+ * \tparam T copyable item type
+ * \tparam Size capacity of the ring, must be a power of two
+ */
+template <typename T, uint16_t Size>
+class SpscRing
+{
+	static_assert(Size > 0 && (Size & (Size - 1)) == 0, "SpscRing: Size must be a power of two");
+
+private:
+	T items[Size];
+	std::atomic<uint32_t> head;		/** number of items pushed, only written by the producer */
+	std::atomic<uint32_t> tail;		/** number of items popped, only written by the consumer */
+	std::atomic<uint32_t> dropped;	/** number of items rejected because the ring was full */
+
+public:
+	SpscRing() : head(0), tail(0), dropped(0)
+	{
+	}
+
+	/**
+	 * \brief Adds an item, may only be called by the producer
+	 * \return false if the ring was full and the item was dropped
+	 */
+	bool push(const T& item)
+	{
+		uint32_t h = head.load(std::memory_order_relaxed);
+		if(h - tail.load(std::memory_order_acquire) >= Size)
+		{
+			dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		items[h & (Size - 1)] = item;
+		head.store(h + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * \brief Takes the oldest item, may only be called by the consumer
+	 * \return false if the ring was empty
+	 */
+	bool pop(T& item)
+	{
+		uint32_t t = tail.load(std::memory_order_relaxed);
+		if(t == head.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+		item = items[t & (Size - 1)];
+		tail.store(t + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * \brief Number of items pushed since the start
+	 */
+	uint32_t getPushed() const
+	{
+		return head.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * \brief Number of items dropped since the start because the ring was full
+	 */
+	uint32_t getDropped() const
+	{
+		return dropped.load(std::memory_order_relaxed);
+	}
+};
+
+#endif
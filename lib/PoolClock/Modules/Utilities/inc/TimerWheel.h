@@ -0,0 +1,253 @@
+/**
+ * \file TimerWheel.h
+ * \author Yves Gaignard
+ * \brief Hierarchical timer wheel scheduling one-shot and periodic jobs
+ */
+
+#ifndef __TIMER_WHEEL_H_
+#define __TIMER_WHEEL_H_
+
+#include <stdint.h>
+
+/**
+ * \brief Runs jobs when they are due instead of comparing millis() for each of them on every loop.
+ *        The time is divided in ticks. A job is placed in one of 64 slots of the level covering its distance:
+ *        level 0 holds the next 64 ticks, level 1 the next 64 * 64 ticks and so on. Each time the lower level
+ *        wraps, the next slot of the level above is spread over the levels below. Scheduling, cancelling and
+ *        running a job is O(1), finding the next deadline scans one bit mask per level.
+ *
+ *        The time is passed by the caller (millis() on the target, a virtual clock on the host), the wheel holds
+ *        no allocations and is not thread safe: schedule and advance from the same task.
+ */
+class TimerWheel
+{
+public:
+	typedef void (*JobCallback)(void* context);
+
+	/**
+	 * \brief Links of the slot lists, the heads of the slots are links only
+	 */
+	struct Link
+	{
+		Link* next;
+		Link* prev;
+	};
+
+	/**
+	 * \brief A job owned by the caller. Must stay valid as long as it is scheduled.
+	 */
+	struct Job : Link
+	{
+		JobCallback callback;
+		void*       context;
+		uint32_t    period;		/** ticks between two runs, 0 for a one-shot job */
+		uint32_t    expires;	/** tick the job is due */
+
+		Job(JobCallback callback = nullptr, void* context = nullptr) :
+			Link{nullptr, nullptr}, callback(callback), context(context), period(0), expires(0)
+		{
+		}
+
+		bool isScheduled() const
+		{
+			return prev != nullptr;
+		}
+	};
+
+	static constexpr uint32_t NoDeadline = UINT32_MAX;
+
+private:
+	static constexpr uint8_t  Levels = 4;
+	static constexpr uint8_t  SlotBits = 6;
+	static constexpr uint32_t Slots = 1 << SlotBits;
+	static constexpr uint32_t SlotMask = Slots - 1;
+	static constexpr uint32_t MaxDistance = (1UL << (SlotBits * Levels)) - 1;
+
+	Link     slots[Levels][Slots];	/** list heads, a slot is empty when its head points to itself */
+	uint64_t occupied[Levels];		/** one bit per non empty slot */
+	uint32_t tickLength;			/** ms per tick */
+	uint32_t currentTick;
+	uint32_t currentTickTime;		/** time the current tick started */
+
+	void place(Job& job)
+	{
+		//a job cascaded on its due tick lands in the current slot, which is run right after the cascade
+		uint32_t distance = job.expires - currentTick;
+		if(distance > MaxDistance)
+		{
+			job.expires = currentTick + MaxDistance;
+			distance = MaxDistance;
+		}
+		uint8_t level = 0;
+		while (level < Levels - 1 && distance >= (1UL << (SlotBits * (level + 1))))
+		{
+			level++;
+		}
+		uint32_t slot = (job.expires >> (SlotBits * level)) & SlotMask;
+		Link& head = slots[level][slot];
+		job.next = head.next;
+		job.prev = &head;
+		head.next->prev = &job;
+		head.next = &job;
+		occupied[level] |= 1ULL << slot;
+	}
+
+	void unlink(Job& job)
+	{
+		job.prev->next = job.next;
+		job.next->prev = job.prev;
+		job.next = nullptr;
+		job.prev = nullptr;
+	}
+
+	void updateOccupied(uint8_t level, uint32_t slot)
+	{
+		if(slots[level][slot].next == &slots[level][slot])
+		{
+			occupied[level] &= ~(1ULL << slot);
+		}
+	}
+
+	/**
+	 * \brief Moves all jobs of a slot to the levels below
+	 */
+	void cascade(uint8_t level, uint32_t slot)
+	{
+		Link& head = slots[level][slot];
+		while (head.next != &head)
+		{
+			Job& job = *static_cast<Job*>(head.next);
+			unlink(job);
+			place(job);
+		}
+		updateOccupied(level, slot);
+	}
+
+	void tick()
+	{
+		currentTick++;
+		for (uint8_t level = 1; level < Levels; level++)
+		{
+			if((currentTick & ((1UL << (SlotBits * level)) - 1)) != 0)
+			{
+				break;
+			}
+			cascade(level, (currentTick >> (SlotBits * level)) & SlotMask);
+		}
+
+		uint32_t slot = currentTick & SlotMask;
+		Link& head = slots[0][slot];
+		while (head.next != &head)
+		{
+			Job& job = *static_cast<Job*>(head.next);
+			unlink(job);
+			if(job.period > 0)
+			{
+				//from the due tick so a late run does not shift the following ones
+				job.expires += job.period;
+				place(job);
+			}
+			//the callback may reschedule or cancel any job, including this one
+			job.callback(job.context);
+		}
+		updateOccupied(0, slot);
+	}
+
+	uint32_t toTicks(uint32_t delay) const
+	{
+		return (delay + tickLength - 1) / tickLength;
+	}
+
+public:
+	/**
+	 * \param tickLength resolution of the wheel in ms
+	 * \param now current time in ms
+	 */
+	TimerWheel(uint32_t tickLength, uint32_t now) : tickLength(tickLength), currentTick(0), currentTickTime(now)
+	{
+		for (uint8_t level = 0; level < Levels; level++)
+		{
+			occupied[level] = 0;
+			for (uint32_t slot = 0; slot < Slots; slot++)
+			{
+				slots[level][slot].next = &slots[level][slot];
+				slots[level][slot].prev = &slots[level][slot];
+			}
+		}
+	}
+
+	/**
+	 * \brief (Re)schedules a job
+	 * \param delay time in ms from the current tick until the job is due, rounded up to the next tick. Delays
+	 *              beyond 2^24 ticks (46 hours with 10 ms ticks) are shortened to that range.
+	 * \param period time in ms between the following runs, 0 to run the job only once
+	 */
+	void schedule(Job& job, uint32_t delay, uint32_t period = 0)
+	{
+		if(job.isScheduled())
+		{
+			unlink(job);
+		}
+		job.period = toTicks(period);
+		//the current tick is already run, the earliest is the next one
+		uint32_t ticks = toTicks(delay);
+		job.expires = currentTick + (ticks > 0 ? ticks : 1);
+		place(job);
+	}
+
+	void cancel(Job& job)
+	{
+		if(job.isScheduled())
+		{
+			unlink(job);
+		}
+	}
+
+	/**
+	 * \brief Advances the wheel to the given time and runs the jobs which became due, in the order of their ticks
+	 */
+	void advance(uint32_t now)
+	{
+		while (now - currentTickTime >= tickLength)
+		{
+			currentTickTime += tickLength;
+			tick();
+		}
+	}
+
+	/**
+	 * \brief Time in ms from now until the next job is due at the latest, #NoDeadline if no job is scheduled.
+	 *        For a job on a higher level this is the time of its cascade, which is never after the job is due.
+	 */
+	uint32_t getNextDeadline(uint32_t now) const
+	{
+		uint32_t ticks = NoDeadline;
+		for (uint8_t level = 0; level < Levels; level++)
+		{
+			if(occupied[level] == 0)
+			{
+				continue;
+			}
+			uint8_t shift = SlotBits * level;
+			uint32_t position = currentTick >> shift;
+			//the first occupied slot after the current position, the current slot of a level comes last
+			uint8_t rotation = (position + 1) & SlotMask;
+			uint64_t rotated = rotation == 0 ? occupied[level] : (occupied[level] >> rotation) | (occupied[level] << (Slots - rotation));
+			uint32_t distance = __builtin_ctzll(rotated) + 1;
+			uint32_t due = ((position + distance) << shift) - currentTick;
+			if(due < ticks)
+			{
+				ticks = due;
+			}
+		}
+		if(ticks == NoDeadline)
+		{
+			return NoDeadline;
+		}
+		uint32_t elapsed = now - currentTickTime;
+		uint32_t deadline = ticks * tickLength;
+		return deadline > elapsed ? deadline - elapsed : 0;
+	}
+};
+
+#endif
@@ -0,0 +1,96 @@
+/**
+ * \file WarmRestart.h
+ * \author Yves Gaignard
+ * \brief Header for class definition of the #WarmRestart which keeps the state of the clock over a reset
+ */
+
+#ifndef _WARM_RESTART_H_
+#define _WARM_RESTART_H_
+
+#include <Arduino.h>
+#include "TimeManager.h"
+#include "ClockState.h"
+
+/**
+ * \brief Snapshots the state of the clock into the RTC memory, which is not initialized by a reset. After a
+ *        software reset (OTA update), a watchdog, a panic or a brownout a valid snapshot is resumed instead of
+ *        going through the full boot: the time, the running timer and the brightness are back on the digits
+ *        within a fraction of a second.
+ *
+ *        The snapshot is only trusted if its magic, version, size and CRC match, it is not older than
+ *        #WARM_RESTART_MAX_AGE and less than #WARM_RESTART_MAX_ATTEMPTS warm restarts happened in a row. The age is
+ *        measured by the RTC timer, which keeps counting through all resets but the power-on.
+ */
+class WarmRestart
+{
+public:
+	/**
+	 * \brief Content of the RTC memory
+	 */
+	typedef struct
+	{
+		uint32_t              magic;
+		uint16_t              version;
+		uint16_t              size;
+		uint64_t              rtcTime;		/** RTC time in us when the snapshot was taken */
+		uint8_t               attempts;		/** warm restarts in a row without running stable */
+		TimeManager::Snapshot time;
+		ClockState::Snapshot  clock;
+		uint32_t              crc;			/** CRC32 of all the fields above */
+	}Snapshot;
+
+private:
+	static WarmRestart* _instance;
+	static constexpr uint32_t Magic   = 0x50434C4B; // "PCLK"
+	static constexpr uint16_t Version = 1;			/** increment when #WarmRestart::Snapshot or its members change */
+	bool     _warmBoot;
+	uint8_t  _attempts;
+	uint32_t _elapsedSeconds;
+	uint32_t _snapshotsTaken;
+	unsigned long _resumeTime;
+
+	WarmRestart();
+	static uint32_t computeCrc(const Snapshot& snapshot);
+	void invalidate();
+public:
+	/**
+	 * \brief Get the instance of the WarmRestart object or create it if it was not yet instantiated.
+	 */
+	static WarmRestart* getInstance();
+
+	/**
+	 * \brief Checks the reset reason and the snapshot, to be called first in the setup
+	 *
+	 * \return true if the clock can resume the snapshot
+	 */
+	bool begin();
+
+	/**
+	 * \brief Whether #WarmRestart::begin found a snapshot to resume
+	 */
+	bool isWarmBoot();
+
+	/**
+	 * \brief Resumes the TimeManager and the ClockState from the snapshot
+	 *
+	 * \pre #WarmRestart::begin returned true and #ClockState::setup was called
+	 */
+	void resume();
+
+	/**
+	 * \brief Takes a new snapshot, called periodically from the main loop
+	 */
+	void save();
+
+	/**
+	 * \brief Number of snapshots taken since the boot
+	 */
+	uint32_t getSnapshotsTaken();
+
+	/**
+	 * \brief millis() at the end of #WarmRestart::resume, 0 after a cold boot
+	 */
+	unsigned long getResumeTime();
+};
+
+#endif
@@ -0,0 +1,132 @@
+/**
+ * \file WarmRestart.cpp
+ * \author Yves Gaignard
+ * \brief Implementation of the WarmRestart class member functions
+ */
+#define TAG "WarmRestart"
+
+#include "WarmRestart.h"
+#include "LogManager.h"
+#include <esp_system.h>
+#include <esp32/rtc.h>
+#include <rom/crc.h>
+
+/**
+ * \brief Kept by every reset but the power-on, its content is random after a power-on
+ */
+RTC_NOINIT_ATTR static WarmRestart::Snapshot rtcSnapshot;
+
+WarmRestart* WarmRestart::_instance = nullptr;
+
+WarmRestart::WarmRestart()
+{
+	_warmBoot       = false;
+	_attempts       = 0;
+	_elapsedSeconds = 0;
+	_snapshotsTaken = 0;
+	_resumeTime     = 0;
+}
+
+WarmRestart* WarmRestart::getInstance()
+{
+	if(_instance == nullptr)
+	{
+		_instance = new WarmRestart();
+	}
+	return _instance;
+}
+
+uint32_t WarmRestart::computeCrc(const Snapshot& snapshot)
+{
+	return crc32_le(0, (const uint8_t*)&snapshot, offsetof(Snapshot, crc));
+}
+
+void WarmRestart::invalidate()
+{
+	rtcSnapshot.magic = 0;
+}
+
+bool WarmRestart::begin()
+{
+	esp_reset_reason_t reason = esp_reset_reason();
+	_warmBoot = false;
+	if(reason != ESP_RST_SW && reason != ESP_RST_PANIC && reason != ESP_RST_INT_WDT && reason != ESP_RST_TASK_WDT &&
+	   reason != ESP_RST_WDT && reason != ESP_RST_BROWNOUT)
+	{
+		LOG_I(TAG, "Cold boot, reset reason %d", reason);
+		invalidate();
+		return false;
+	}
+	if(rtcSnapshot.magic != Magic || rtcSnapshot.version != Version || rtcSnapshot.size != sizeof(Snapshot) ||
+	   rtcSnapshot.crc != computeCrc(rtcSnapshot))
+	{
+		LOG_W(TAG, "No valid snapshot after reset reason %d, cold boot", reason);
+		invalidate();
+		return false;
+	}
+	uint64_t now = esp_rtc_get_time_us();
+	//the RTC timer may have been restarted by the reset, the snapshot is at most one interval old then
+	_elapsedSeconds = now >= rtcSnapshot.rtcTime ? (now - rtcSnapshot.rtcTime) / 1000000 : 0;
+	if(_elapsedSeconds > WARM_RESTART_MAX_AGE)
+	{
+		LOG_W(TAG, "Snapshot is %u s old, cold boot", _elapsedSeconds);
+		invalidate();
+		return false;
+	}
+	if(rtcSnapshot.attempts >= WARM_RESTART_MAX_ATTEMPTS)
+	{
+		LOG_E(TAG, "%d warm restarts in a row, cold boot", rtcSnapshot.attempts);
+		invalidate();
+		return false;
+	}
+	_attempts = rtcSnapshot.attempts + 1;
+	_warmBoot = true;
+	LOG_I(TAG, "Warm restart %d after reset reason %d, resuming a %u s old snapshot", _attempts, reason, _elapsedSeconds);
+	return true;
+}
+
+bool WarmRestart::isWarmBoot()
+{
+	return _warmBoot;
+}
+
+void WarmRestart::resume()
+{
+	TimeManager::getInstance()->resume(rtcSnapshot.time, _elapsedSeconds);
+	ClockState::getInstance()->resume(rtcSnapshot.clock);
+	//count the attempt right away in case the resumed state makes the clock crash again
+	save();
+	_resumeTime = millis();
+}
+
+void WarmRestart::save()
+{
+	if(_attempts > 0 && millis() > WARM_RESTART_STABLE_TIME)
+	{
+		_attempts = 0;
+	}
+	//the padding is part of the CRC, build the snapshot aside and copy it at once: a reset while copying leaves
+	//a snapshot with a wrong CRC, which is not resumed
+	Snapshot snapshot;
+	memset(&snapshot, 0, sizeof(snapshot));
+	snapshot.magic    = Magic;
+	snapshot.version  = Version;
+	snapshot.size     = sizeof(Snapshot);
+	snapshot.rtcTime  = esp_rtc_get_time_us();
+	snapshot.attempts = _attempts;
+	TimeManager::getInstance()->takeSnapshot(snapshot.time);
+	ClockState::getInstance()->takeSnapshot(snapshot.clock);
+	snapshot.crc = computeCrc(snapshot);
+	memcpy(&rtcSnapshot, &snapshot, sizeof(Snapshot));
+	_snapshotsTaken++;
+}
+
+uint32_t WarmRestart::getSnapshotsTaken()
+{
+	return _snapshotsTaken;
+}
+
+unsigned long WarmRestart::getResumeTime()
+{
+	return _resumeTime;
+}
@@ -25,4 +25,7 @@ void WebSrvManager_notFound(AsyncWebServerRequest *request);
 // handler to treat "root URL"
 void WebSrvManager_root(AsyncWebServerRequest *request);
 
+// handler to download the recorded LED frames
+void WebSrvManager_getFrames(AsyncWebServerRequest *request);
+
 #endif
\ No newline at end of file
@@ -18,6 +18,14 @@
 #include "LogManager.h"
 #include "Utilities.h"
 #include "WebSrvManager.h"
+#include "DisplayManager.h"
+#include "ClockState.h"
+#if WARM_RESTART == true
+  #include "WarmRestart.h"
+#endif
+#if PERSISTENT_SETTINGS == true
+  #include "SettingsStore.h"
+#endif
 #include "WebSerialLite.h"         // Library to reroute Serial on webserver
 
 #define FileSys LittleFS
@@ -30,29 +38,44 @@ void WebSrvManager_recvMsg(uint8_t *data, size_t len);
 //void WebSrvManager_getMeasures(AsyncWebServerRequest *request);
 
 unsigned long ota_progress_millis = 0;
+unsigned long ota_start_millis = 0;
+size_t ota_bytes = 0;
+
+// The OTA callbacks run in the web server task while the flash is written, they only post the progress
+// to the display which draws it from the main loop
 
 void onOTAStart() {
-// Log when OTA has started
-Serial.println("OTA update started!");
-// <Add your own code here>
+  // Log when OTA has started
+  LOG_I(TAG, "OTA update started!");
+  ota_start_millis = millis();
+  ota_bytes = 0;
 }
 
 void onOTAProgress(size_t current, size_t final) {
-// Log every 1 second
-if (millis() - ota_progress_millis > 1000) {
-  ota_progress_millis = millis();
-  Serial.printf("OTA Progress Current: %u bytes, Final: %u bytes\n", current, final);
-}
+  ota_bytes = current;
+  #if OTA_SHOW_PROGRESS == true
+    DisplayManager::getInstance()->postProgress(current, final);
+  #endif
+  // Log every 1 second
+  if (millis() - ota_progress_millis > 1000) {
+    ota_progress_millis = millis();
+    Serial.printf("OTA Progress Current: %u bytes, Final: %u bytes\n", current, final);
+  }
 }
 
 void onOTAEnd(bool success) {
-// Log when OTA has finished
-if (success) {
-  Serial.println("OTA update finished successfully!");
-} else {
-  Serial.println("There was an error during OTA update!");
-}
-// <Add your own code here>
+  unsigned long duration = millis() - ota_start_millis;
+  // Log when OTA has finished
+  if (success) {
+    LOG_I(TAG, "OTA update finished successfully!");
+  } else {
+    LOG_E(TAG, "There was an error during OTA update!");
+    #if OTA_SHOW_PROGRESS == true
+      DisplayManager::getInstance()->postProgressEnd();
+    #endif
+  }
+  LOG_I(TAG, "OTA update took %lu ms for %u bytes (%lu bytes/s), progress display %s", duration, ota_bytes,
+        duration > 0 ? (unsigned long)((uint64_t)ota_bytes * 1000 / duration) : 0UL, OTA_SHOW_PROGRESS == true ? "on" : "off");
 }
 
 
@@ -92,6 +115,10 @@ void WebSrvManager_setup(boolean isWebSerial) {
     request->send(FileSys, "/script.js", "text/javascript");
   });
 
+  #if ENABLE_FRAME_RECORDER == true
+    OTAServer.on("/frames.bin", HTTP_GET, WebSrvManager_getFrames);
+  #endif
+
   OTAServer.serveStatic("/", FileSys, "/");
   
   if (isWebSerial) {
@@ -134,6 +161,21 @@ void WebSrvManager_root(AsyncWebServerRequest *request) {
   request->send(FileSys, "/index.html", "text/html");
 }
 
+#if ENABLE_FRAME_RECORDER == true
+// handler to download the LED frames of the last seconds, decode them with tools/decode_frames.py
+void WebSrvManager_getFrames(AsyncWebServerRequest *request) {
+  FrameRecorder* recorder = DisplayManager::getInstance()->getFrameRecorder();
+  // the chunks are read straight from the ring buffer, the recording is paused until the connection is closed
+  uint32_t size = recorder->beginDownload();
+  request->onDisconnect([recorder]() { recorder->endDownload(); });
+  AsyncWebServerResponse *response = request->beginResponse("application/octet-stream", size,
+    [recorder](uint8_t *buffer, size_t maxLen, size_t index) -> size_t { return recorder->readDownload(buffer, maxLen, index); });
+  response->addHeader("Content-Disposition", "attachment; filename=\"frames.bin\"");
+  request->send(response);
+  LOG_I(TAG, "Sending %u bytes of recorded frames", size);
+}
+#endif
+
 /*
 // handler to treat "GET Temperature"
 void WebSrvManager_getMeasures(AsyncWebServerRequest *request) {
@@ -243,6 +285,36 @@ void WebSrvManager_recvMsg(uint8_t *data, size_t len){
         help =true;
       }
     } 
+    else if (string_iequals(words[0], (std::string)"stats")) {
+      DisplayManager* displays = DisplayManager::getInstance();
+      WebSerial.printf ("Display digit updates: %u issued, %u applied\n", displays->getDisplayUpdatesIssued(), displays->getDisplayUpdatesApplied());
+      WebSerial.printf ("Temperature changes suppressed: %u\n", displays->getSuppressedTemperatureChanges());
+      ClockState* states = ClockState::getInstance();
+      WebSerial.printf ("State machine: %u us CPU time during the last minute, %u events processed, %u dropped\n", states->getBusyMicrosPerMinute(),
+                        states->getProcessedEvents(), states->getDroppedEvents());
+      WebSerial.printf ("Button events: %u detected, %u dropped\n", states->getButtonEvents(), states->getDroppedButtonEvents());
+      WebSerial.printf ("Press to display latency: last %u us, average %u us, max %u us\n", states->getLastButtonLatency(), states->getAverageButtonLatency(), states->getMaxButtonLatency());
+      WebSerial.printf ("Idle mode: %s, %u s idle since boot, about %u mWh saved\n", states->isIdle() ? "idle" : "active", states->getIdleSeconds(), states->getEnergySaved());
+      TimeManager* timeM = TimeManager::getInstance();
+      uint32_t cpuFrequency = getCpuFrequencyMhz();
+      WebSerial.printf ("Second interrupt: last %u cycles, max %u cycles (%u ns at %u MHz), %u seconds handled late\n", timeM->getLastIsrCycles(),
+                        timeM->getMaxIsrCycles(), timeM->getMaxIsrCycles() * 1000 / cpuFrequency, cpuFrequency, timeM->getLateTicks());
+      #if WARM_RESTART == true
+        WarmRestart* warmRestart = WarmRestart::getInstance();
+        WebSerial.printf ("Warm restart: %s boot, resumed %lu ms after the start, %u snapshots taken\n", warmRestart->isWarmBoot() ? "warm" : "cold",
+                          warmRestart->getResumeTime(), warmRestart->getSnapshotsTaken());
+      #endif
+      #if PERSISTENT_SETTINGS == true
+        SettingsStore* settingsStore = SettingsStore::getInstance();
+        WebSerial.printf ("Settings: %u changes, %u flash writes, %u saves without change, %u failed writes\n", states->getSettingsChanges(),
+                          settingsStore->getFlashWrites(), settingsStore->getSkippedWrites(), settingsStore->getFailedWrites());
+      #endif
+      #if ENABLE_FRAME_RECORDER == true
+        FrameRecorder* recorder = displays->getFrameRecorder();
+        WebSerial.printf ("Frame recorder: %u frames recorded, %u skipped, %u bytes used for the last %lu ms\n", recorder->getRecordedFrames(),
+                          recorder->getSkippedFrames(), recorder->getUsedBytes(), recorder->getRecordedDuration());
+      #endif
+    }
     else {
       WebSerial.printf ("Unknown command: %s", d.c_str());
       help =true;
@@ -255,5 +327,6 @@ void WebSrvManager_recvMsg(uint8_t *data, size_t len){
   if (help) {
     WebSerial.println("Command help:");
     WebSerial.println("- log LEVEL TAG     # LEVEL = ERROR, WARNING, INFO, DEBUG or VERBOSE    # TAG = name of the class");
+    WebSerial.println("- stats             # show the runtime statistics");
   }
 }
\ No newline at end of file
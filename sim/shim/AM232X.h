@@ -0,0 +1,15 @@
+/**
+ * \file AM232X.h
+ * \author Yves Gaignard
+ * \brief The AM232X library is not built for the host, Sensor_AM232X is replaced by the double in SimSensors.cpp
+ */
+
+#ifndef __SIM_AM232X_H_
+#define __SIM_AM232X_H_
+
+#include <Arduino.h>
+
+class TwoWire;
+class AM232X;
+
+#endif
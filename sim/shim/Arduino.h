@@ -0,0 +1,151 @@
+/**
+ * \file Arduino.h
+ * \author Yves Gaignard
+ * \brief Arduino API used by the display stack, implemented on the simulated clock of the host simulator
+ */
+
+#ifndef __SIM_ARDUINO_H_
+#define __SIM_ARDUINO_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <algorithm>
+#include <time.h>
+#include "binary.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+
+#define IRAM_ATTR
+#define RTC_NOINIT_ATTR
+#define HIGH			1
+#define LOW				0
+#define INPUT			0x01
+#define OUTPUT			0x03
+#define INPUT_PULLUP	0x05
+#define RISING			0x01
+#define FALLING			0x02
+#define CHANGE			0x03
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+/**
+ * \brief Simulated time, it only moves when the simulator advances it so the simulation runs as fast as the host allows
+ */
+namespace SimClock {
+	extern unsigned long nowMicros;
+	inline void advanceMicros(unsigned long micros) { nowMicros += micros; }
+}
+
+/**
+ * \brief Bus transactions the firmware would run on the device, the host doubles only count them
+ */
+namespace SimBus {
+	extern uint32_t oneWireReads;	/** temperatures read from the 1-Wire sensor */
+	extern uint32_t lcdScreens;		/** screens written to the I2C LCD */
+}
+
+inline unsigned long millis() { return SimClock::nowMicros / 1000; }
+inline unsigned long micros() { return SimClock::nowMicros; }
+inline void delay(uint32_t ms) { SimClock::advanceMicros(ms * 1000UL); }
+inline void delayMicroseconds(uint32_t us) { SimClock::advanceMicros(us); }
+inline void yield() {}
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return LOW; }
+inline uint16_t analogRead(uint8_t) { return 0; }
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+	return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+inline const char* pathToFileName(const char* path)
+{
+	const char* name = strrchr(path, '/');
+	return name ? name + 1 : path;
+}
+
+/**
+ * \brief Interrupts of the GPIOs, simInterrupt() runs the handler of a pin as an edge on it would
+ */
+inline uint8_t digitalPinToInterrupt(uint8_t pin) { return pin; }
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode);
+void attachInterruptArg(uint8_t pin, void (*handler)(void*), void* arg, int mode);
+void detachInterrupt(uint8_t pin);
+void simInterrupt(uint8_t pin);
+
+/**
+ * \brief Hardware timers, they do not count on the host: simTimerAlarm() runs the interrupt of the enabled timer
+ *        with this number
+ */
+typedef struct hw_timer_s hw_timer_t;
+hw_timer_t* timerBegin(uint8_t timer, uint16_t divider, bool countUp);
+void timerEnd(hw_timer_t* timer);
+void timerAttachInterrupt(hw_timer_t* timer, void (*handler)(void), bool edge);
+void timerDetachInterrupt(hw_timer_t* timer);
+void timerAlarmWrite(hw_timer_t* timer, uint64_t alarmValue, bool autoReload);
+void timerAlarmEnable(hw_timer_t* timer);
+void timerAlarmDisable(hw_timer_t* timer);
+void simTimerAlarm(uint8_t timer);
+
+bool setCpuFrequencyMhz(uint32_t cpuFreqMhz);
+uint32_t getCpuFrequencyMhz();
+
+/**
+ * \brief Local time of the simulated clock, which starts on 2024-01-01 00:00:00 UTC
+ */
+void configTzTime(const char* tz, const char* server1, const char* server2 = nullptr, const char* server3 = nullptr);
+bool getLocalTime(struct tm* info, uint32_t ms = 5000);
+
+/**
+ * \brief ESP32 system functions
+ */
+class EspClass
+{
+public:
+	/** \brief Cycles of the host clock scaled to the CPU frequency, so cycle counts convert to the host time */
+	uint32_t getCycleCount();
+	void restart();
+};
+extern EspClass ESP;
+
+class __FlashStringHelper;
+
+/**
+ * \brief Serial writes to stdout
+ */
+class HardwareSerial
+{
+public:
+	void begin(unsigned long) {}
+	int printf(const char* format, ...) __attribute__((format(printf, 2, 3)))
+	{
+		va_list args;
+		va_start(args, format);
+		int written = vprintf(format, args);
+		va_end(args);
+		return written;
+	}
+	void print(const char* text) { fputs(text, stdout); }
+	void println(const char* text = "") { puts(text); }
+};
+typedef HardwareSerial Stream;
+extern HardwareSerial Serial;
+
+class String : public std::string
+{
+public:
+	String(const char* text = "") : std::string(text) {}
+	String(const std::string& text) : std::string(text) {}
+};
+
+#endif
@@ -0,0 +1,26 @@
+/**
+ * \file BlynkSimpleEsp32.h
+ * \author Yves Gaignard
+ * \brief Blynk client of the ESP32, the simulator has no network and drops everything written to the app
+ */
+
+#ifndef __SIM_BLYNK_SIMPLE_ESP32_H_
+#define __SIM_BLYNK_SIMPLE_ESP32_H_
+
+/** virtual pins of the app */
+enum BlynkVirtualPins { V0, V1, V2, V3, V4, V5, V6, V7, V8, V9, V10, V11, V12, V13, V14, V15,
+						 V16, V17, V18, V19, V20, V21, V22, V23, V24, V25, V26, V27, V28, V29, V30, V31 };
+
+class BlynkWifi
+{
+public:
+	void run() {}
+	bool connected() { return false; }
+	template<typename... Args> void virtualWrite(int, Args...) {}
+	template<typename... Args> void syncVirtual(Args...) {}
+	template<typename... Args> void setProperty(int, const char*, Args...) {}
+};
+
+extern BlynkWifi Blynk;
+
+#endif
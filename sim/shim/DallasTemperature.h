@@ -0,0 +1,26 @@
+/**
+ * \file DallasTemperature.h
+ * \author Yves Gaignard
+ * \brief The types of the DallasTemperature library used by Sensor_DS18B20.h, which is replaced by the double in
+ *        SimSensors.cpp
+ */
+
+#ifndef __SIM_DALLAS_TEMPERATURE_H_
+#define __SIM_DALLAS_TEMPERATURE_H_
+
+#include <Arduino.h>
+
+typedef uint8_t DeviceAddress[8];
+
+class DallasTemperature
+{
+public:
+	struct request_t
+	{
+		bool result;
+		unsigned long timestamp;
+		operator bool() { return result; }
+	};
+};
+
+#endif
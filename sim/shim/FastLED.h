@@ -0,0 +1,132 @@
+/**
+ * \file FastLED.h
+ * \author Yves Gaignard
+ * \brief The part of FastLED used by the display stack. Colors are computed like FastLED 3.5 does, FastLED.show()
+ *        hands the frame to the renderer of the host simulator instead of the LED strips.
+ */
+
+#ifndef __SIM_FASTLED_H_
+#define __SIM_FASTLED_H_
+
+#include <stdint.h>
+#include <vector>
+
+typedef uint8_t fract8;
+
+/** \brief Scales i by scale/256, a scale of 255 keeps the value (FASTLED_SCALE8_FIXED) */
+inline uint8_t scale8(uint8_t i, fract8 scale) { return ((uint16_t)i * (1 + (uint16_t)scale)) >> 8; }
+/** \brief Scales i by scale/256 but never to 0 if i and scale are not 0 */
+inline uint8_t scale8_video(uint8_t i, fract8 scale) { return (((uint16_t)i * (uint16_t)scale) >> 8) + ((i && scale) ? 1 : 0); }
+/** \brief Blends from a to b, amountOfB 255 is almost only b */
+inline uint8_t blend8(uint8_t a, uint8_t b, uint8_t amountOfB)
+{
+	uint16_t partial = (a << 8) | b;
+	partial += (b * amountOfB);
+	partial -= (a * amountOfB);
+	return partial >> 8;
+}
+
+struct CRGB
+{
+	uint8_t r;
+	uint8_t g;
+	uint8_t b;
+
+	typedef enum : uint32_t {
+		Azure = 0xF0FFFF,
+		Black = 0x000000,
+		Blue = 0x0000FF,
+		DarkBlue = 0x00008B,
+		Green = 0x008000,
+		Orange = 0xFFA500,
+		PaleVioletRed = 0xDB7093,
+		Red = 0xFF0000,
+		White = 0xFFFFFF,
+		Yellow = 0xFFFF00
+	} HTMLColorCode;
+
+	CRGB() : r(0), g(0), b(0) {}
+	constexpr CRGB(uint8_t red, uint8_t green, uint8_t blue) : r(red), g(green), b(blue) {}
+	constexpr CRGB(uint32_t colorcode) : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b(colorcode & 0xFF) {}
+	constexpr CRGB(HTMLColorCode colorcode) : CRGB((uint32_t)colorcode) {}
+
+	CRGB& nscale8(uint8_t scaledown)
+	{
+		r = scale8(r, scaledown);
+		g = scale8(g, scaledown);
+		b = scale8(b, scaledown);
+		return *this;
+	}
+	CRGB& nscale8_video(uint8_t scaledown)
+	{
+		r = scale8_video(r, scaledown);
+		g = scale8_video(g, scaledown);
+		b = scale8_video(b, scaledown);
+		return *this;
+	}
+	CRGB& fadeToBlackBy(uint8_t fadefactor) { return nscale8(255 - fadefactor); }
+	CRGB& operator%=(uint8_t scaledown) { return nscale8_video(scaledown); }
+	explicit operator bool() const { return r || g || b; }
+	bool operator==(const CRGB& other) const { return r == other.r && g == other.g && b == other.b; }
+	bool operator!=(const CRGB& other) const { return !(*this == other); }
+};
+
+inline CRGB blend(const CRGB& p1, const CRGB& p2, fract8 amountOfP2)
+{
+	return CRGB(blend8(p1.r, p2.r, amountOfP2), blend8(p1.g, p2.g, amountOfP2), blend8(p1.b, p2.b, amountOfP2));
+}
+
+enum EOrder { RGB, GRB };
+class WS2812B {};
+
+/**
+ * \brief LED buffer registered with addLeds
+ */
+struct CLEDController
+{
+	uint8_t pin;
+	CRGB* leds;
+	int numLeds;
+};
+
+class CFastLED
+{
+private:
+	std::vector<CLEDController> controllers;
+	uint8_t brightness = 255;
+	void (*showCallback)(const CFastLED&) = nullptr;
+
+public:
+	template<class CHIPSET, uint8_t DATA_PIN, EOrder RGB_ORDER>
+	CLEDController& addLeds(CRGB* data, int numLeds, int offset = 0)
+	{
+		controllers.push_back({DATA_PIN, data + offset, numLeds});
+		return controllers.back();
+	}
+	void setBrightness(uint8_t scale) { brightness = scale; }
+	uint8_t getBrightness() const { return brightness; }
+	void show() { if(showCallback) showCallback(*this); }
+	void delay(unsigned long ms);
+
+	/** \brief Simulator only: called with every frame FastLED.show() sends */
+	void onShow(void (*callback)(const CFastLED&)) { showCallback = callback; }
+	/** \brief Simulator only: the LED buffers registered with addLeds */
+	const std::vector<CLEDController>& getControllers() const { return controllers; }
+};
+
+extern CFastLED FastLED;
+
+/** \brief Power of the LEDs in mW at full brightness, with the default model of FastLED 3.5 (5 V, 16/11/15 mA per channel, 1 mA dark) */
+inline uint32_t calculate_unscaled_power_mW(const CRGB* ledbuffer, uint16_t numLeds)
+{
+	uint32_t red = 0, green = 0, blue = 0;
+	for (uint16_t i = 0; i < numLeds; i++)
+	{
+		red += ledbuffer[i].r;
+		green += ledbuffer[i].g;
+		blue += ledbuffer[i].b;
+	}
+	return ((red * 80) >> 8) + ((green * 55) >> 8) + ((blue * 75) >> 8) + numLeds * 5;
+}
+
+#endif
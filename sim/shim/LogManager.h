@@ -0,0 +1,67 @@
+/**
+ * \file LogManager.h
+ * \author Yves Gaignard
+ * \brief Log macros of the firmware, printed to stdout by the host simulator
+ */
+
+#ifndef LogManager_h
+#define LogManager_h
+
+#include <Arduino.h>
+
+static int const LOG_NONE    = -1;
+static int const LOG_ERROR   =  0;
+static int const LOG_WARNING =  1;
+static int const LOG_INFO    =  2;
+static int const LOG_DEBUG   =  3;
+static int const LOG_VERBOSE =  4;
+
+#define LOG_LOG_FORMAT(format)  "[%20s:%-4u] %30s(): " format , pathToFileName(__FILE__), __LINE__, __FUNCTION__
+#define LOG_E(tag, format, ...) Log.print(tag, LOG_ERROR  , LOG_LOG_FORMAT(format), ##__VA_ARGS__)
+#define LOG_W(tag, format, ...) Log.print(tag, LOG_WARNING, LOG_LOG_FORMAT(format), ##__VA_ARGS__)
+#define LOG_I(tag, format, ...) Log.print(tag, LOG_INFO   , LOG_LOG_FORMAT(format), ##__VA_ARGS__)
+#define LOG_D(tag, format, ...) Log.print(tag, LOG_DEBUG  , LOG_LOG_FORMAT(format), ##__VA_ARGS__)
+#define LOG_V(tag, format, ...) Log.print(tag, LOG_VERBOSE, LOG_LOG_FORMAT(format), ##__VA_ARGS__)
+
+/**
+ * \brief Prints the log messages up to the log level to stderr, so they do not mix with the rendered frames
+ */
+class LogManager {
+  public:
+    typedef void (*Capture)(const char * tag, const char * message);
+
+    void setLogLevel(int const log_level) { _log_level = log_level; }
+    int  getLogLevel() const { return _log_level; }
+
+    /**
+     * \brief Host tests only: hands the messages to the function instead of printing them, nullptr prints again
+     */
+    void setCapture(Capture capture) { _capture = capture; }
+
+    void print(const char * tag, int const log_level, const char * fmt, ...) __attribute__((format(printf, 4, 5)))
+    {
+      if (log_level > _log_level) { return; }
+      va_list args;
+      va_start(args, fmt);
+      if (_capture != nullptr)
+      {
+        char message[256];
+        vsnprintf(message, sizeof(message), fmt, args);
+        _capture(tag, message);
+      }
+      else
+      {
+        fprintf(stderr, "[%8lu] %s: ", millis(), tag);
+        vfprintf(stderr, fmt, args);
+        fputc('\n', stderr);
+      }
+      va_end(args);
+    }
+  private:
+    int _log_level = LOG_WARNING;
+    Capture _capture = nullptr;
+};
+
+extern LogManager Log;
+
+#endif
@@ -0,0 +1,34 @@
+/**
+ * \file Preferences.h
+ * \author Yves Gaignard
+ * \brief NVS preferences of the ESP32 kept in memory, they last as long as the simulator runs
+ */
+
+#ifndef __SIM_PREFERENCES_H_
+#define __SIM_PREFERENCES_H_
+
+#include <stddef.h>
+#include <string>
+
+class Preferences
+{
+private:
+	std::string _namespace;
+	bool _readOnly = false;
+	bool _started = false;
+
+	std::string path(const char* key) const { return _namespace + "/" + key; }
+
+public:
+	/**
+	 * \brief As in the NVS a namespace which was never written can't be opened read only
+	 */
+	bool begin(const char* name, bool readOnly = false);
+	void end();
+	bool clear();
+	size_t getBytesLength(const char* key);
+	size_t getBytes(const char* key, void* buf, size_t maxLen);
+	size_t putBytes(const char* key, const void* value, size_t len);
+};
+
+#endif
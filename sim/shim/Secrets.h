@@ -0,0 +1,13 @@
+/**
+ * \file Secrets.h
+ * \author Yves Gaignard
+ * \brief Placeholder credentials for the simulator, which never connects to a network
+ */
+
+#ifndef __SIM_SECRETS_H_
+#define __SIM_SECRETS_H_
+
+#define WIFI_SSID		"simulator"
+#define WIFI_PASSWORD	"simulator"
+
+#endif
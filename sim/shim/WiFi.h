@@ -0,0 +1,29 @@
+/**
+ * \file WiFi.h
+ * \author Yves Gaignard
+ * \brief WiFi status of the ESP32, the simulator runs without network and is never connected
+ */
+
+#ifndef __SIM_WIFI_H_
+#define __SIM_WIFI_H_
+
+typedef enum
+{
+	WL_IDLE_STATUS     = 0,
+	WL_NO_SSID_AVAIL   = 1,
+	WL_SCAN_COMPLETED  = 2,
+	WL_CONNECTED       = 3,
+	WL_CONNECT_FAILED  = 4,
+	WL_CONNECTION_LOST = 5,
+	WL_DISCONNECTED    = 6
+} wl_status_t;
+
+class WiFiClass
+{
+public:
+	wl_status_t status() { return WL_DISCONNECTED; }
+};
+
+extern WiFiClass WiFi;
+
+#endif
@@ -0,0 +1,14 @@
+/**
+ * \file rtc.h
+ * \author Yves Gaignard
+ * \brief RTC time of the ESP32, the time of the simulated clock since the start
+ */
+
+#ifndef __SIM_ESP32_RTC_H_
+#define __SIM_ESP32_RTC_H_
+
+#include <Arduino.h>
+
+inline uint64_t esp_rtc_get_time_us() { return micros(); }
+
+#endif
@@ -0,0 +1,15 @@
+/**
+ * \file esp_err.h
+ * \author Yves Gaignard
+ * \brief Error codes of the ESP-IDF
+ */
+
+#ifndef __SIM_ESP_ERR_H_
+#define __SIM_ESP_ERR_H_
+
+typedef int esp_err_t;
+
+#define ESP_OK		0
+#define ESP_FAIL	-1
+
+#endif
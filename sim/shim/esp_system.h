@@ -0,0 +1,27 @@
+/**
+ * \file esp_system.h
+ * \author Yves Gaignard
+ * \brief Reset reason of the ESP-IDF, the simulator always starts from a power on
+ */
+
+#ifndef __SIM_ESP_SYSTEM_H_
+#define __SIM_ESP_SYSTEM_H_
+
+typedef enum
+{
+	ESP_RST_UNKNOWN,
+	ESP_RST_POWERON,
+	ESP_RST_EXT,
+	ESP_RST_SW,
+	ESP_RST_PANIC,
+	ESP_RST_INT_WDT,
+	ESP_RST_TASK_WDT,
+	ESP_RST_WDT,
+	ESP_RST_DEEPSLEEP,
+	ESP_RST_BROWNOUT,
+	ESP_RST_SDIO,
+} esp_reset_reason_t;
+
+inline esp_reset_reason_t esp_reset_reason() { return ESP_RST_POWERON; }
+
+#endif
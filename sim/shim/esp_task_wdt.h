@@ -0,0 +1,19 @@
+/**
+ * \file esp_task_wdt.h
+ * \author Yves Gaignard
+ * \brief Task watchdog of the ESP-IDF, the host has none and never resets
+ */
+
+#ifndef __SIM_ESP_TASK_WDT_H_
+#define __SIM_ESP_TASK_WDT_H_
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/task.h"
+
+inline esp_err_t esp_task_wdt_init(uint32_t, bool) { return ESP_OK; }
+inline esp_err_t esp_task_wdt_add(TaskHandle_t) { return ESP_OK; }
+inline esp_err_t esp_task_wdt_delete(TaskHandle_t) { return ESP_OK; }
+inline esp_err_t esp_task_wdt_reset() { return ESP_OK; }
+
+#endif
@@ -0,0 +1,46 @@
+/**
+ * \file FreeRTOS.h
+ * \author Yves Gaignard
+ * \brief FreeRTOS types of the ESP32 used by the firmware, see SimFreeRTOS.cpp for the host implementation
+ */
+
+#ifndef __SIM_FREERTOS_H_
+#define __SIM_FREERTOS_H_
+
+#include <stdint.h>
+
+typedef int				BaseType_t;
+typedef unsigned int	UBaseType_t;
+typedef uint32_t		TickType_t;
+
+#define pdFALSE					((BaseType_t)0)
+#define pdTRUE					((BaseType_t)1)
+#define pdPASS					pdTRUE
+#define pdFAIL					pdFALSE
+#define portMAX_DELAY			((TickType_t)0xffffffffUL)
+#define portTICK_PERIOD_MS		((TickType_t)1)
+#define pdMS_TO_TICKS(ms)		((TickType_t)(ms))
+#define configMAX_PRIORITIES	25
+#define portYIELD_FROM_ISR()
+
+/**
+ * \brief Whether the calling code runs in an interrupt, see #SimIsrScope
+ */
+BaseType_t xPortInIsrContext();
+
+/**
+ * \brief Simulator only: the calling thread runs an interrupt for the lifetime of the object
+ */
+class SimIsrScope
+{
+public:
+	SimIsrScope();
+	~SimIsrScope();
+};
+
+/**
+ * \brief The host has no cores to pin to, every task reports the core 1 of the Arduino loop
+ */
+inline BaseType_t xPortGetCoreID() { return 1; }
+
+#endif
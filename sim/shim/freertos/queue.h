@@ -0,0 +1,35 @@
+/**
+ * \file queue.h
+ * \author Yves Gaignard
+ * \brief FreeRTOS queue API of the ESP32, implemented on host threads by SimFreeRTOS.cpp
+ */
+
+#ifndef __SIM_FREERTOS_QUEUE_H_
+#define __SIM_FREERTOS_QUEUE_H_
+
+#include "FreeRTOS.h"
+
+typedef struct SimQueue* QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize);
+void vQueueDelete(QueueHandle_t queue);
+
+/**
+ * \brief Copies the item to the back of the queue, waits up to the given milliseconds of the host while it is full
+ */
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticksToWait);
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void* item, BaseType_t* higherPriorityTaskWoken);
+
+/**
+ * \brief Takes the oldest item, waits up to the given milliseconds of the host while the queue is empty
+ */
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticksToWait);
+
+/**
+ * \brief Copies the oldest item without taking it
+ */
+BaseType_t xQueuePeek(QueueHandle_t queue, void* item, TickType_t ticksToWait);
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
+
+#endif
@@ -0,0 +1,43 @@
+/**
+ * \file task.h
+ * \author Yves Gaignard
+ * \brief FreeRTOS task API of the ESP32, the host simulator runs each task on its own thread
+ */
+
+#ifndef __SIM_FREERTOS_TASK_H_
+#define __SIM_FREERTOS_TASK_H_
+
+#include "FreeRTOS.h"
+
+typedef struct SimTask* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+/**
+ * \brief Starts the task on a new thread, the stack size, the priority and the core are ignored
+ */
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t code, const char* name, uint32_t stackDepth, void* parameters,
+								   UBaseType_t priority, TaskHandle_t* createdTask, BaseType_t coreID);
+
+/**
+ * \brief Deletes the calling task at once, any other task leaves its thread at its next blocking call
+ */
+void vTaskDelete(TaskHandle_t task);
+
+/**
+ * \brief Handle of the calling task, the main thread of the host has one as well
+ */
+TaskHandle_t xTaskGetCurrentTaskHandle();
+
+/**
+ * \brief Blocks for the given number of milliseconds of the host, the simulated clock does not move
+ */
+void vTaskDelay(TickType_t ticks);
+
+TickType_t xTaskGetTickCount();
+TickType_t xTaskGetTickCountFromISR();
+
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higherPriorityTaskWoken);
+
+#endif
@@ -0,0 +1,32 @@
+/**
+ * \file timers.h
+ * \author Yves Gaignard
+ * \brief FreeRTOS software timer API of the ESP32. The host has no timer service task: the timers keep their state
+ *        but never expire on their own, simTimerExpire() runs the callback of one.
+ */
+
+#ifndef __SIM_FREERTOS_TIMERS_H_
+#define __SIM_FREERTOS_TIMERS_H_
+
+#include "FreeRTOS.h"
+
+typedef struct SimTimer* TimerHandle_t;
+typedef void (*TimerCallbackFunction_t)(TimerHandle_t);
+
+TimerHandle_t xTimerCreate(const char* name, TickType_t period, UBaseType_t autoReload, void* timerID, TimerCallbackFunction_t callback);
+BaseType_t xTimerDelete(TimerHandle_t timer, TickType_t ticksToWait);
+BaseType_t xTimerStart(TimerHandle_t timer, TickType_t ticksToWait);
+BaseType_t xTimerStop(TimerHandle_t timer, TickType_t ticksToWait);
+BaseType_t xTimerReset(TimerHandle_t timer, TickType_t ticksToWait);
+BaseType_t xTimerResetFromISR(TimerHandle_t timer, BaseType_t* higherPriorityTaskWoken);
+BaseType_t xTimerChangePeriod(TimerHandle_t timer, TickType_t period, TickType_t ticksToWait);
+BaseType_t xTimerIsTimerActive(TimerHandle_t timer);
+TickType_t xTimerGetPeriod(TimerHandle_t timer);
+void* pvTimerGetTimerID(TimerHandle_t timer);
+
+/**
+ * \brief Simulator only: the timer expires now, its callback runs on the calling thread
+ */
+void simTimerExpire(TimerHandle_t timer);
+
+#endif
@@ -0,0 +1,29 @@
+/**
+ * \file crc.h
+ * \author Yves Gaignard
+ * \brief CRC functions of the ESP32 ROM
+ */
+
+#ifndef __SIM_ROM_CRC_H_
+#define __SIM_ROM_CRC_H_
+
+#include <stdint.h>
+
+/**
+ * \brief CRC-32 (IEEE 802.3, reflected) as the ROM computes it, pass 0 to start and the last result to continue
+ */
+inline uint32_t crc32_le(uint32_t crc, const uint8_t* buf, uint32_t len)
+{
+	crc = ~crc;
+	for (uint32_t i = 0; i < len; i++)
+	{
+		crc ^= buf[i];
+		for (int bit = 0; bit < 8; bit++)
+		{
+			crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+		}
+	}
+	return ~crc;
+}
+
+#endif
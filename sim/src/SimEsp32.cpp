@@ -0,0 +1,259 @@
+/**
+ * \file SimEsp32.cpp
+ * \author Yves Gaignard
+ * \brief ESP32 peripherals of the host simulator: GPIO interrupts, hardware timers, CPU frequency, local time and
+ *        the NVS preferences
+ */
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <BlynkSimpleEsp32.h>
+#include <WiFi.h>
+#include <chrono>
+#include <map>
+#include <set>
+#include <vector>
+
+/**
+ * \brief State of a hardware timer
+ */
+struct hw_timer_s
+{
+	void (*handler)(void);
+	uint64_t alarmValue;
+	bool enabled;
+};
+
+EspClass ESP;
+WiFiClass WiFi;
+BlynkWifi Blynk;
+
+namespace
+{
+	const uint8_t PinCount = 40;
+	/** 2024-01-01 00:00:00 UTC, start of the simulated clock */
+	const time_t SimulationEpoch = 1704067200;
+
+	struct PinInterrupt
+	{
+		void (*handler)(void);
+		void (*handlerArg)(void*);
+		void* arg;
+	};
+
+	PinInterrupt pinInterrupts[PinCount];
+	const uint8_t TimerCount = 4;
+	hw_timer_t* timers[TimerCount];
+	uint32_t cpuFrequencyMhz = 240;
+
+	/**
+	 * \brief Content of the NVS, created on first use so it does not depend on the order of the static constructors
+	 */
+	std::map<std::string, std::vector<uint8_t>>& storage()
+	{
+		static std::map<std::string, std::vector<uint8_t>> values;
+		return values;
+	}
+
+	std::set<std::string>& namespaces()
+	{
+		static std::set<std::string> names;
+		return names;
+	}
+}
+
+void attachInterrupt(uint8_t pin, void (*handler)(void), int)
+{
+	if(pin < PinCount)
+	{
+		pinInterrupts[pin] = { handler, nullptr, nullptr };
+	}
+}
+
+void attachInterruptArg(uint8_t pin, void (*handler)(void*), void* arg, int)
+{
+	if(pin < PinCount)
+	{
+		pinInterrupts[pin] = { nullptr, handler, arg };
+	}
+}
+
+void detachInterrupt(uint8_t pin)
+{
+	if(pin < PinCount)
+	{
+		pinInterrupts[pin] = { nullptr, nullptr, nullptr };
+	}
+}
+
+void simInterrupt(uint8_t pin)
+{
+	if(pin >= PinCount)
+	{
+		return;
+	}
+	SimIsrScope isr;
+	if(pinInterrupts[pin].handler != nullptr)
+	{
+		pinInterrupts[pin].handler();
+	}
+	else if(pinInterrupts[pin].handlerArg != nullptr)
+	{
+		pinInterrupts[pin].handlerArg(pinInterrupts[pin].arg);
+	}
+}
+
+hw_timer_t* timerBegin(uint8_t num, uint16_t, bool)
+{
+	if(num >= TimerCount)
+	{
+		return nullptr;
+	}
+	if(timers[num] == nullptr)
+	{
+		timers[num] = new hw_timer_s{ nullptr, 0, false };
+	}
+	return timers[num];
+}
+
+void timerEnd(hw_timer_t* timer)
+{
+	for (uint8_t num = 0; num < TimerCount; num++)
+	{
+		if(timers[num] == timer)
+		{
+			timers[num] = nullptr;
+		}
+	}
+	delete timer;
+}
+
+void timerAttachInterrupt(hw_timer_t* timer, void (*handler)(void), bool)
+{
+	timer->handler = handler;
+}
+
+void timerDetachInterrupt(hw_timer_t* timer)
+{
+	timer->handler = nullptr;
+}
+
+void timerAlarmWrite(hw_timer_t* timer, uint64_t alarmValue, bool)
+{
+	timer->alarmValue = alarmValue;
+}
+
+void timerAlarmEnable(hw_timer_t* timer)
+{
+	timer->enabled = true;
+}
+
+void timerAlarmDisable(hw_timer_t* timer)
+{
+	timer->enabled = false;
+}
+
+void simTimerAlarm(uint8_t num)
+{
+	hw_timer_t* timer = num < TimerCount ? timers[num] : nullptr;
+	if(timer != nullptr && timer->enabled && timer->handler != nullptr)
+	{
+		SimIsrScope isr;
+		timer->handler();
+	}
+}
+
+bool setCpuFrequencyMhz(uint32_t cpuFreqMhz)
+{
+	cpuFrequencyMhz = cpuFreqMhz;
+	return true;
+}
+
+uint32_t getCpuFrequencyMhz()
+{
+	return cpuFrequencyMhz;
+}
+
+void configTzTime(const char* tz, const char*, const char*, const char*)
+{
+	setenv("TZ", tz, 1);
+	tzset();
+}
+
+bool getLocalTime(struct tm* info, uint32_t)
+{
+	time_t now = SimulationEpoch + millis() / 1000;
+	localtime_r(&now, info);
+	return true;
+}
+
+uint32_t EspClass::getCycleCount()
+{
+	uint64_t nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	return (uint32_t)(nanos * cpuFrequencyMhz / 1000);
+}
+
+void EspClass::restart()
+{
+	exit(0);
+}
+
+bool Preferences::begin(const char* name, bool readOnly)
+{
+	if(readOnly && namespaces().count(name) == 0)
+	{
+		return false;
+	}
+	_namespace = name;
+	_readOnly = readOnly;
+	_started = true;
+	return true;
+}
+
+void Preferences::end()
+{
+	_started = false;
+}
+
+bool Preferences::clear()
+{
+	if(!_started || _readOnly)
+	{
+		return false;
+	}
+	auto& values = storage();
+	for (auto it = values.begin(); it != values.end();)
+	{
+		it = it->first.compare(0, _namespace.size() + 1, _namespace + "/") == 0 ? values.erase(it) : std::next(it);
+	}
+	return true;
+}
+
+size_t Preferences::getBytesLength(const char* key)
+{
+	auto value = storage().find(path(key));
+	return _started && value != storage().end() ? value->second.size() : 0;
+}
+
+size_t Preferences::getBytes(const char* key, void* buf, size_t maxLen)
+{
+	auto value = storage().find(path(key));
+	if(!_started || value == storage().end() || value->second.size() > maxLen)
+	{
+		return 0;
+	}
+	memcpy(buf, value->second.data(), value->second.size());
+	return value->second.size();
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t len)
+{
+	if(!_started || _readOnly)
+	{
+		return 0;
+	}
+	const uint8_t* bytes = (const uint8_t*)value;
+	storage()[path(key)] = std::vector<uint8_t>(bytes, bytes + len);
+	namespaces().insert(_namespace);
+	return len;
+}
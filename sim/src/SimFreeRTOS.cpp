@@ -0,0 +1,346 @@
+/**
+ * \file SimFreeRTOS.cpp
+ * \author Yves Gaignard
+ * \brief FreeRTOS API of the ESP32 implemented with host threads for the simulator and the host tests
+ */
+
+#include <Arduino.h>
+#include "freertos/queue.h"
+#include "freertos/timers.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * \brief State of a task, never freed as other tasks may still hold its handle
+ */
+struct SimTask
+{
+	std::string name;
+	std::mutex lock;
+	std::condition_variable notified;
+	uint32_t notifications = 0;
+	bool deleted = false;
+};
+
+/**
+ * \brief Items of a queue, copied in and out as on the target
+ */
+struct SimQueue
+{
+	std::mutex lock;
+	std::condition_variable changed;
+	std::deque<std::vector<uint8_t>> items;
+	UBaseType_t length;
+	UBaseType_t itemSize;
+};
+
+/**
+ * \brief State of a software timer, it only expires through simTimerExpire()
+ */
+struct SimTimer
+{
+	std::string name;
+	TickType_t period;
+	bool autoReload;
+	bool active;
+	void* id;
+	TimerCallbackFunction_t callback;
+};
+
+namespace
+{
+	/**
+	 * \brief Thrown to unwind the thread of a deleted task back to its entry
+	 */
+	struct TaskDeleted {};
+
+	thread_local SimTask* currentTask = nullptr;
+	thread_local int isrDepth = 0;
+
+	/**
+	 * \brief Waits on the condition of the queue for the given milliseconds of the host
+	 */
+	template<class Predicate>
+	bool waitFor(SimQueue* queue, std::unique_lock<std::mutex>& lock, TickType_t ticksToWait, Predicate ready)
+	{
+		if(ticksToWait == portMAX_DELAY)
+		{
+			queue->changed.wait(lock, ready);
+			return true;
+		}
+		if(ticksToWait == 0)
+		{
+			//a poll must not go through the timed wait, which always ends in a system call
+			return ready();
+		}
+		return queue->changed.wait_for(lock, std::chrono::milliseconds(ticksToWait), ready);
+	}
+
+	void leaveIfDeleted(SimTask* task)
+	{
+		if(task->deleted)
+		{
+			throw TaskDeleted();
+		}
+	}
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t code, const char* name, uint32_t, void* parameters,
+								   UBaseType_t, TaskHandle_t* createdTask, BaseType_t)
+{
+	SimTask* task = new SimTask();
+	task->name = name;
+	if(createdTask != nullptr)
+	{
+		*createdTask = task;
+	}
+	std::thread([task, code, parameters]()
+	{
+		currentTask = task;
+		try
+		{
+			code(parameters);
+		}
+		catch(const TaskDeleted&)
+		{
+		}
+	}).detach();
+	return pdPASS;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle()
+{
+	if(currentTask == nullptr)
+	{
+		currentTask = new SimTask();
+		currentTask->name = "main";
+	}
+	return currentTask;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+	if(task == nullptr || task == currentTask)
+	{
+		throw TaskDeleted();
+	}
+	std::lock_guard<std::mutex> lock(task->lock);
+	task->deleted = true;
+	task->notified.notify_all();
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+	SimTask* task = xTaskGetCurrentTaskHandle();
+	std::unique_lock<std::mutex> lock(task->lock);
+	task->notified.wait_for(lock, std::chrono::milliseconds(ticks), [task]() { return task->deleted; });
+	leaveIfDeleted(task);
+}
+
+TickType_t xTaskGetTickCount()
+{
+	return millis();
+}
+
+TickType_t xTaskGetTickCountFromISR()
+{
+	return millis();
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait)
+{
+	SimTask* task = xTaskGetCurrentTaskHandle();
+	std::unique_lock<std::mutex> lock(task->lock);
+	auto ready = [task]() { return task->notifications > 0 || task->deleted; };
+	if(ticksToWait == portMAX_DELAY)
+	{
+		task->notified.wait(lock, ready);
+	}
+	else
+	{
+		task->notified.wait_for(lock, std::chrono::milliseconds(ticksToWait), ready);
+	}
+	leaveIfDeleted(task);
+	uint32_t count = task->notifications;
+	if(count > 0)
+	{
+		task->notifications = clearCountOnExit == pdTRUE ? 0 : count - 1;
+	}
+	return count;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+	std::lock_guard<std::mutex> lock(task->lock);
+	task->notifications++;
+	task->notified.notify_one();
+	return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higherPriorityTaskWoken)
+{
+	xTaskNotifyGive(task);
+	if(higherPriorityTaskWoken != nullptr)
+	{
+		*higherPriorityTaskWoken = pdTRUE;
+	}
+}
+
+BaseType_t xPortInIsrContext()
+{
+	return isrDepth > 0 ? pdTRUE : pdFALSE;
+}
+
+SimIsrScope::SimIsrScope()
+{
+	isrDepth++;
+}
+
+SimIsrScope::~SimIsrScope()
+{
+	isrDepth--;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize)
+{
+	SimQueue* queue = new SimQueue();
+	queue->length = length;
+	queue->itemSize = itemSize;
+	return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+	delete queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticksToWait)
+{
+	std::unique_lock<std::mutex> lock(queue->lock);
+	if(!waitFor(queue, lock, ticksToWait, [queue]() { return queue->items.size() < queue->length; }))
+	{
+		return pdFAIL;
+	}
+	const uint8_t* bytes = (const uint8_t*)item;
+	queue->items.emplace_back(bytes, bytes + queue->itemSize);
+	queue->changed.notify_all();
+	return pdPASS;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void* item, BaseType_t* higherPriorityTaskWoken)
+{
+	if(higherPriorityTaskWoken != nullptr)
+	{
+		*higherPriorityTaskWoken = pdFALSE;
+	}
+	return xQueueSend(queue, item, 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticksToWait)
+{
+	std::unique_lock<std::mutex> lock(queue->lock);
+	if(!waitFor(queue, lock, ticksToWait, [queue]() { return !queue->items.empty(); }))
+	{
+		return pdFAIL;
+	}
+	memcpy(item, queue->items.front().data(), queue->itemSize);
+	queue->items.pop_front();
+	queue->changed.notify_all();
+	return pdPASS;
+}
+
+BaseType_t xQueuePeek(QueueHandle_t queue, void* item, TickType_t ticksToWait)
+{
+	std::unique_lock<std::mutex> lock(queue->lock);
+	if(!waitFor(queue, lock, ticksToWait, [queue]() { return !queue->items.empty(); }))
+	{
+		return pdFAIL;
+	}
+	memcpy(item, queue->items.front().data(), queue->itemSize);
+	return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+	std::lock_guard<std::mutex> lock(queue->lock);
+	return queue->items.size();
+}
+
+TimerHandle_t xTimerCreate(const char* name, TickType_t period, UBaseType_t autoReload, void* timerID, TimerCallbackFunction_t callback)
+{
+	SimTimer* timer = new SimTimer();
+	timer->name = name;
+	timer->period = period;
+	timer->autoReload = autoReload == pdTRUE;
+	timer->active = false;
+	timer->id = timerID;
+	timer->callback = callback;
+	return timer;
+}
+
+BaseType_t xTimerDelete(TimerHandle_t timer, TickType_t)
+{
+	delete timer;
+	return pdPASS;
+}
+
+BaseType_t xTimerStart(TimerHandle_t timer, TickType_t)
+{
+	timer->active = true;
+	return pdPASS;
+}
+
+BaseType_t xTimerStop(TimerHandle_t timer, TickType_t)
+{
+	timer->active = false;
+	return pdPASS;
+}
+
+BaseType_t xTimerReset(TimerHandle_t timer, TickType_t)
+{
+	timer->active = true;
+	return pdPASS;
+}
+
+BaseType_t xTimerResetFromISR(TimerHandle_t timer, BaseType_t* higherPriorityTaskWoken)
+{
+	if(higherPriorityTaskWoken != nullptr)
+	{
+		*higherPriorityTaskWoken = pdFALSE;
+	}
+	return xTimerReset(timer, 0);
+}
+
+BaseType_t xTimerChangePeriod(TimerHandle_t timer, TickType_t period, TickType_t)
+{
+	//as on the target, changing the period starts a dormant timer
+	timer->period = period;
+	timer->active = true;
+	return pdPASS;
+}
+
+BaseType_t xTimerIsTimerActive(TimerHandle_t timer)
+{
+	return timer->active ? pdTRUE : pdFALSE;
+}
+
+TickType_t xTimerGetPeriod(TimerHandle_t timer)
+{
+	return timer->period;
+}
+
+void* pvTimerGetTimerID(TimerHandle_t timer)
+{
+	return timer->id;
+}
+
+void simTimerExpire(TimerHandle_t timer)
+{
+	timer->active = timer->autoReload;
+	timer->callback(timer);
+}
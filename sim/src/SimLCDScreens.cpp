@@ -0,0 +1,15 @@
+/**
+ * \file SimLCDScreens.cpp
+ * \author Yves Gaignard
+ * \brief LCD screens drawn by the ClockState, the firmware defines them in src/main.cpp. The simulator has no LCD,
+ *        it only counts the screens written.
+ */
+
+#include "ClockState.h"
+
+LCDScreen_BlinkingDigit _lcd_blinking_digit = LowMinute;
+
+void LCDScreen_Clock_Mode(TimeManager*, float, float, float, float) { SimBus::lcdScreens++; }
+void LCDScreen_Timer_Mode(TimeManager*, Timer_State_enum) { SimBus::lcdScreens++; }
+void LCDScreen_Set_Timer(TimeManager*, LCDScreen_BlinkingDigit) { SimBus::lcdScreens++; }
+void LCDScreen_Backlight(bool) {}
@@ -0,0 +1,26 @@
+/**
+ * \file SimPlatform.cpp
+ * \author Yves Gaignard
+ * \brief Global objects of the Arduino, FastLED and log shims of the host simulator
+ */
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include "LogManager.h"
+
+unsigned long SimClock::nowMicros = 0;
+uint32_t SimBus::oneWireReads = 0;
+uint32_t SimBus::lcdScreens = 0;
+HardwareSerial Serial;
+CFastLED FastLED;
+LogManager Log;
+
+void CFastLED::delay(unsigned long ms)
+{
+	unsigned long end = millis() + ms;
+	do
+	{
+		show();
+		SimClock::advanceMicros(1000);
+	} while (millis() < end);
+}
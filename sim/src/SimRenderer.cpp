@@ -0,0 +1,174 @@
+/**
+ * \file SimRenderer.cpp
+ * \author Yves Gaignard
+ * \brief Implementation of the SimRenderer class member functions
+ */
+
+#include "SimRenderer.h"
+#include "DisplayLayout.h"
+
+/** color of the pixels which are not an LED */
+static const CRGB Background(0, 0, 0);
+/** color of an LED which is off, makes the segments visible */
+static const CRGB LedOff(24, 24, 24);
+
+SimRenderer::SimRenderer()
+{
+	uint16_t displayX[NUM_DISPLAYS];
+	uint16_t displayY[NUM_DISPLAYS];
+	width = 0;
+	height = 0;
+	for (uint8_t d = 0; d < NUM_DISPLAYS; d++)
+	{
+		uint8_t length = DisplayLayout::ledsPerSegment(DisplayLayout::Displays[d].size);
+		displayX[d] = width;
+		width += length + 2 + 1;
+		height = std::max<uint16_t>(height, 2 * length + 3);
+	}
+	width--;
+	for (uint8_t d = 0; d < NUM_DISPLAYS; d++)
+	{
+		//displays with shorter segments are centered vertically
+		uint8_t length = DisplayLayout::ledsPerSegment(DisplayLayout::Displays[d].size);
+		displayY[d] = (height - (2 * length + 3)) / 2;
+	}
+
+	ledPositions.resize(DisplayLayout::NumSegmentLeds);
+	for (uint16_t s = 0; s < NUM_SEGMENTS; s++)
+	{
+		const DisplayLayout::SegmentDescription& segment = DisplayLayout::Segments[s];
+		uint8_t length = DisplayLayout::ledsPerSegment(DisplayLayout::Displays[segment.display].size);
+		for (uint8_t i = 0; i < length; i++)
+		{
+			uint8_t along = segment.direction ? length - 1 - i : i;
+			Pixel pixel;
+			switch (segment.position)
+			{
+				case SevenSegment::LeftTopSegment:      pixel = {0, (uint16_t)(1 + along)}; break;
+				case SevenSegment::MiddleTopSegment:    pixel = {(uint16_t)(1 + along), 0}; break;
+				case SevenSegment::RightTopSegment:     pixel = {(uint16_t)(length + 1), (uint16_t)(1 + along)}; break;
+				case SevenSegment::CenterSegment:       pixel = {(uint16_t)(1 + along), (uint16_t)(length + 1)}; break;
+				case SevenSegment::LeftBottomSegment:   pixel = {0, (uint16_t)(length + 2 + along)}; break;
+				case SevenSegment::MiddleBottomSegment: pixel = {(uint16_t)(1 + along), (uint16_t)(2 * length + 2)}; break;
+				default:                                pixel = {(uint16_t)(length + 1), (uint16_t)(length + 2 + along)}; break;
+			}
+			pixel.x += displayX[segment.display];
+			pixel.y += displayY[segment.display];
+			ledPositions[DisplayLayout::LedOffsets[s] + i] = pixel;
+		}
+	}
+}
+
+void SimRenderer::fillCanvas(std::vector<CRGB>& canvas, const CRGB* leds, uint8_t brightness) const
+{
+	canvas.assign(width * height, Background);
+	for (uint16_t i = 0; i < ledPositions.size(); i++)
+	{
+		//the LEDs are scaled with the global brightness when they are sent
+		CRGB color = leds[i];
+		color.nscale8(brightness);
+		canvas[ledPositions[i].y * width + ledPositions[i].x] = color ? color : LedOff;
+	}
+}
+
+void SimRenderer::drawTerminal(const CRGB* leds, uint8_t brightness, FILE* out) const
+{
+	std::vector<CRGB> canvas;
+	fillCanvas(canvas, leds, brightness);
+
+	fputs("\x1b[H", out);
+	for (uint16_t y = 0; y < height; y += 2)
+	{
+		for (uint16_t x = 0; x < width; x++)
+		{
+			const CRGB& top = canvas[y * width + x];
+			const CRGB& bottom = y + 1 < height ? canvas[(y + 1) * width + x] : Background;
+			fprintf(out, "\x1b[38;2;%d;%d;%dm\x1b[48;2;%d;%d;%dm▀", top.r, top.g, top.b, bottom.r, bottom.g, bottom.b);
+		}
+		fputs("\x1b[0m\n", out);
+	}
+	fflush(out);
+}
+
+static uint32_t crc32(const uint8_t* data, size_t length, uint32_t crc = 0)
+{
+	crc = ~crc;
+	for (size_t i = 0; i < length; i++)
+	{
+		crc ^= data[i];
+		for (uint8_t bit = 0; bit < 8; bit++)
+		{
+			crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+		}
+	}
+	return ~crc;
+}
+
+static void appendUint32(std::vector<uint8_t>& out, uint32_t value)
+{
+	out.insert(out.end(), {(uint8_t)(value >> 24), (uint8_t)(value >> 16), (uint8_t)(value >> 8), (uint8_t)value});
+}
+
+static void appendChunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& data)
+{
+	appendUint32(out, data.size());
+	size_t start = out.size();
+	out.insert(out.end(), type, type + 4);
+	out.insert(out.end(), data.begin(), data.end());
+	appendUint32(out, crc32(&out[start], out.size() - start));
+}
+
+bool SimRenderer::writePng(const char* path, const CRGB* leds, uint8_t brightness, uint8_t scale) const
+{
+	std::vector<CRGB> canvas;
+	fillCanvas(canvas, leds, brightness);
+
+	uint32_t imageWidth = width * scale;
+	uint32_t imageHeight = height * scale;
+	std::vector<uint8_t> raw;
+	raw.reserve((imageWidth * 3 + 1) * imageHeight);
+	for (uint32_t y = 0; y < imageHeight; y++)
+	{
+		raw.push_back(0);	//no filter
+		for (uint32_t x = 0; x < imageWidth; x++)
+		{
+			const CRGB& color = canvas[(y / scale) * width + x / scale];
+			raw.insert(raw.end(), {color.r, color.g, color.b});
+		}
+	}
+
+	//zlib stream made of stored deflate blocks, the images are small and this needs no compression library
+	std::vector<uint8_t> compressed = {0x78, 0x01};
+	uint32_t a = 1, b = 0;
+	for (size_t offset = 0; offset < raw.size(); offset += 65535)
+	{
+		uint16_t length = std::min<size_t>(65535, raw.size() - offset);
+		compressed.insert(compressed.end(), {(uint8_t)(offset + length == raw.size()), (uint8_t)length, (uint8_t)(length >> 8), (uint8_t)~length, (uint8_t)(~length >> 8)});
+		compressed.insert(compressed.end(), raw.begin() + offset, raw.begin() + offset + length);
+	}
+	for (uint8_t value : raw)
+	{
+		a = (a + value) % 65521;
+		b = (b + a) % 65521;
+	}
+	appendUint32(compressed, (b << 16) | a);
+
+	std::vector<uint8_t> header;
+	appendUint32(header, imageWidth);
+	appendUint32(header, imageHeight);
+	header.insert(header.end(), {8, 2, 0, 0, 0});	//8 bit RGB
+
+	std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+	appendChunk(png, "IHDR", header);
+	appendChunk(png, "IDAT", compressed);
+	appendChunk(png, "IEND", {});
+
+	FILE* file = fopen(path, "wb");
+	if(file == nullptr)
+	{
+		return false;
+	}
+	bool written = fwrite(png.data(), 1, png.size(), file) == png.size();
+	fclose(file);
+	return written;
+}
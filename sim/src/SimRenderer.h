@@ -0,0 +1,48 @@
+/**
+ * \file SimRenderer.h
+ * \author Yves Gaignard
+ * \brief Draws the LED buffer of the DisplayManager with the segment geometry from the display layout
+ */
+
+#ifndef __SIM_RENDERER_H_
+#define __SIM_RENDERER_H_
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include <vector>
+
+/**
+ * \brief Places every LED of the layout on a pixel grid. Every display is a seven segment glyph whose segments are
+ *        as long as its LEDs per segment, the displays are drawn next to each other in the order of #DisplayIDs.
+ */
+class SimRenderer
+{
+private:
+	struct Pixel {
+		uint16_t x;
+		uint16_t y;
+	};
+
+	std::vector<Pixel> ledPositions;	/** position of every segment LED, in wiring order */
+	uint16_t width;
+	uint16_t height;
+
+	void fillCanvas(std::vector<CRGB>& canvas, const CRGB* leds, uint8_t brightness) const;
+
+public:
+	SimRenderer();
+
+	/**
+	 * \brief Draws the frame in the terminal with ANSI truecolor escape codes, two pixel rows per text line
+	 */
+	void drawTerminal(const CRGB* leds, uint8_t brightness, FILE* out) const;
+
+	/**
+	 * \brief Writes the frame as PNG image
+	 * \param scale size of one LED in pixels
+	 * \return false if the file could not be written
+	 */
+	bool writePng(const char* path, const CRGB* leds, uint8_t brightness, uint8_t scale) const;
+};
+
+#endif
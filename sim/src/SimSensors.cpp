@@ -0,0 +1,84 @@
+/**
+ * \file SimSensors.cpp
+ * \author Yves Gaignard
+ * \brief Host doubles of the I2C and 1-Wire temperature sensors, they report a constant room and water temperature
+ */
+
+#include "Sensor_AM232X.h"
+#include "Sensor_DS18B20.h"
+
+Sensor_AM232X* Sensor_AM232X::_instance = nullptr;
+Sensor_DS18B20* Sensor_DS18B20::_instance = nullptr;
+
+Sensor_AM232X::Sensor_AM232X()
+{
+	_I2CDHT = nullptr;
+	_AM232X = nullptr;
+	_sda_pin = 0;
+	_scl_pin = 0;
+	_frequency = 0;
+	_temperature = 21.5;
+	_humidity = 45.0;
+	_read_status = 0;
+	_last_read = 0;
+	_read_frequency = 0;
+}
+
+Sensor_AM232X* Sensor_AM232X::getInstance()
+{
+	if(_instance == nullptr)
+	{
+		_instance = new Sensor_AM232X();
+	}
+	return _instance;
+}
+
+bool Sensor_AM232X::init(int sda_pin, int scl_pin, uint32_t frequency)
+{
+	_sda_pin = sda_pin;
+	_scl_pin = scl_pin;
+	_read_frequency = frequency;
+	_is_init = true;
+	return true;
+}
+
+bool Sensor_AM232X::handle()
+{
+	return _is_init;
+}
+
+float Sensor_AM232X::getTemperature()
+{
+	return _temperature;
+}
+
+float Sensor_AM232X::getHumidity()
+{
+	return _humidity;
+}
+
+Sensor_DS18B20::Sensor_DS18B20()
+{
+	_lastRead = 0;
+	_readFrequency = 0;
+}
+
+Sensor_DS18B20* Sensor_DS18B20::getInstance()
+{
+	if(_instance == nullptr)
+	{
+		_instance = new Sensor_DS18B20();
+	}
+	return _instance;
+}
+
+bool Sensor_DS18B20::requestTemperatures()
+{
+	return false;
+}
+
+float Sensor_DS18B20::getPreciseTempCByAddress(std::string)
+{
+	SimBus::oneWireReads++;
+	return 26.0;
+}
@@ -0,0 +1,164 @@
+/**
+ * \file main.cpp
+ * \author Yves Gaignard
+ * \brief Host simulator of the PoolClock display: runs the real DisplayManager, SevenSegment, Animator, transitions
+ *        and effects on a simulated clock and renders the frames in the terminal or as PNG images.
+ *
+ * Usage: pio run -e native && .pio/build/native/program [options]
+ *   --seconds N    simulated time in s (default: 60)
+ *   --minute N     simulated time in ms between two minute changes of the shown time (default: 2000)
+ *   --terminal     draw every frame in the terminal (ANSI truecolor)
+ *   --realtime     slow the simulation down to real time, for watching it in the terminal
+ *   --png DIR      write every frame as DIR/frame_NNNNN.png
+ *   --scale N      size of an LED in the PNG images in pixels (default: 8)
+ *   --log LEVEL    log level of the firmware modules, 0 (errors) to 4 (verbose) (default: 1)
+ */
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include <chrono>
+#include <thread>
+#include <string>
+#include "Configuration.h"
+#include "LogManager.h"
+#include "DisplayManager.h"
+#include "SimRenderer.h"
+
+//the host tests bring their own main, the simulator is left out of their build
+#ifndef PIO_UNIT_TESTING
+
+struct SimOptions {
+	unsigned long seconds = 60;
+	unsigned long minuteInterval = 2000;
+	bool terminal = false;
+	bool realtime = false;
+	const char* pngDirectory = nullptr;
+	uint8_t scale = 8;
+};
+
+static SimOptions options;
+static SimRenderer* renderer = nullptr;
+static uint32_t framesShown = 0;
+
+/**
+ * \brief Called for every FastLED.show(): renders the frame and advances the clock by the time the strips need to
+ *        receive it, like the real show() blocks the loop on the clock
+ */
+static void onShow(const CFastLED& fastLED)
+{
+	const CRGB* leds = fastLED.getControllers().front().leds;
+	if(options.terminal)
+	{
+		renderer->drawTerminal(leds, fastLED.getBrightness(), stdout);
+	}
+	if(options.pngDirectory != nullptr)
+	{
+		std::string path = std::string(options.pngDirectory) + "/frame_" + std::to_string(100000 + framesShown).substr(1) + ".png";
+		if(!renderer->writePng(path.c_str(), leds, fastLED.getBrightness(), options.scale))
+		{
+			fprintf(stderr, "Cannot write %s\n", path.c_str());
+			exit(1);
+		}
+	}
+	framesShown++;
+	SimClock::advanceMicros(DisplayLayout::estimatedShowTimeMicros());
+}
+
+static bool parseOptions(int argc, char** argv)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		std::string option = argv[i];
+		bool hasValue = i + 1 < argc;
+		if(option == "--seconds" && hasValue)			{ options.seconds = strtoul(argv[++i], nullptr, 10); }
+		else if(option == "--minute" && hasValue)		{ options.minuteInterval = std::max(1UL, strtoul(argv[++i], nullptr, 10)); }
+		else if(option == "--terminal")					{ options.terminal = true; }
+		else if(option == "--realtime")					{ options.realtime = true; }
+		else if(option == "--png" && hasValue)			{ options.pngDirectory = argv[++i]; }
+		else if(option == "--scale" && hasValue)		{ options.scale = std::max(1, atoi(argv[++i])); }
+		else if(option == "--log" && hasValue)			{ Log.setLogLevel(atoi(argv[++i])); }
+		else
+		{
+			fprintf(stderr, "Unknown option %s, see sim/src/main.cpp for the usage\n", argv[i]);
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	if(!parseOptions(argc, argv))
+	{
+		return 1;
+	}
+
+	DisplayManager* displays = DisplayManager::getInstance();
+	renderer = new SimRenderer();
+	FastLED.onShow(onShow);
+	if(options.terminal)
+	{
+		fputs("\x1b[2J", stdout);
+	}
+
+	//same start up as the firmware
+	displays->InitSegments(WIFI_CONNECTING_COLOR, 50);
+	displays->setColorScheme(ColorScheme::fromConfiguration());
+	displays->setGlobalBrightness(255);
+
+	//the shown time starts just before an hour change, the temperatures drift slowly
+	unsigned long minutes = 12 * 60 + 57;
+	unsigned long nextMinute = 0;
+	unsigned long nextDotFlash = 0;
+	unsigned long nextTemperature = 0;
+	unsigned long end = options.seconds * 1000;
+	bool schemeChanged = false;
+
+	auto wallStart = std::chrono::steady_clock::now();
+	while (millis() < end)
+	{
+		unsigned long now = millis();
+		if(now >= nextMinute)
+		{
+			displays->displayTime(minutes / 60 % 24, minutes % 60);
+			minutes++;
+			nextMinute = now + options.minuteInterval;
+		}
+		if(now >= nextDotFlash)
+		{
+			displays->flashSeparationDot(NUM_SEPARATION_DOTS);
+			nextDotFlash = now + DOT_FLASH_INTERVAL;
+		}
+		if(now >= nextTemperature)
+		{
+			float temperature1 = 24 + 4 * sin(now / 20000.0);
+			float temperature2 = 27 + 2 * cos(now / 30000.0);
+			displays->displayTemperature(temperature1, 50, temperature2, 0);
+			nextTemperature = now + 1000;
+		}
+
+		if(!schemeChanged && now >= end / 2)
+		{
+			//halfway the hour and minute colors are swapped with a crossfade
+			ColorScheme scheme = displays->getColorScheme();
+			std::swap(scheme.hour, scheme.minute);
+			displays->setColorScheme(scheme, COLOR_CHANGE_CROSSFADE);
+			schemeChanged = true;
+		}
+
+		displays->handle();
+		SimClock::advanceMicros(1000);
+
+		if(options.realtime)
+		{
+			std::this_thread::sleep_until(wallStart + std::chrono::milliseconds(millis()));
+		}
+	}
+	double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+	fprintf(stderr, "Simulated %lu s in %.3f s (%.0fx real time), %u frames (%.1f fps simulated, %.0f fps on the host), %u of %u digit updates applied\n",
+		options.seconds, wallSeconds, options.seconds / std::max(wallSeconds, 1e-9), framesShown, framesShown / (double)std::max(options.seconds, 1UL),
+		framesShown / std::max(wallSeconds, 1e-9), displays->getDisplayUpdatesApplied(), displays->getDisplayUpdatesIssued());
+	return 0;
+}
+#endif
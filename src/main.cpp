@@ -22,6 +22,9 @@ const ProjectStructure Project {"Pool Clock", "1.0.0", "Yves Gaignard"};
 #include "LogManager.h"
 #include "DisplayManager.h"
 #include "ClockState.h"
+#if WARM_RESTART == true
+	#include "WarmRestart.h"
+#endif
 
 #if RUN_WITHOUT_WIFI == false
 	#include "WiFi.h"
@@ -57,8 +60,6 @@ const ProjectStructure Project {"Pool Clock", "1.0.0", "Yves Gaignard"};
 #if PIR_SENSOR == true
 	#include "Sensor_HCSR501.h"
 	Sensor_HCSR501* PIRSensor = Sensor_HCSR501::getInstance();
-	bool isDetected = false;
-	bool previousIsDetected = false;
 #endif
 
 #if LCD_SCREEN == true
@@ -86,15 +87,11 @@ ClockState* states = ClockState::getInstance();
 	BlynkConfig* BlynkConfiguration = BlynkConfig::getInstance();
 #endif
 
-#if PUSH_BUTTONS == true
-	Transitions_enum _last_treated_transition;
-#endif
-
 #if ENABLE_OTA_UPLOAD == true
 	//void setupOTA();
 #endif
 #if RUN_WITHOUT_WIFI == false
-	void wifiSetup();
+	void wifiSetup(bool resumed);
 #endif
 
 // Tasks Prototypes
@@ -105,6 +102,7 @@ void TaskLCD(void *pvParameters);
 void TaskClock(void *pvParameters);
 void TaskStateMachine(void *pvParameters);
 
+void SecondTick();
 void TimerTick();
 void TimerDone();
 void AlarmTriggered();
@@ -153,59 +151,15 @@ void startupAnimation()
 	}
 }
 
-void setup()
+/**
+ * \brief Connects the WIFI and starts the services depending on it
+ * \param resumed true after a warm restart, the clock is already running
+ */
+void networkSetup(bool resumed)
 {
-	Serial.begin(115200);
-	delay(100);
-
-	// Set appropriate log level. The defaul DEFAULT_LOG_LEVEL is defined in Configuration.h file
-	Log.setTag("*"                   , DEFAULT_LOG_LEVEL);
-	Log.setTag("BuzzerManager"       , DEFAULT_LOG_LEVEL);
-	Log.setTag("ClockState"          , DEFAULT_LOG_LEVEL);
-	Log.setTag("DisplayManager"      , DEFAULT_LOG_LEVEL);
-	Log.setTag("LCDManager"          , DEFAULT_LOG_LEVEL);
-	Log.setTag("LCDScreens"          , DEFAULT_LOG_LEVEL);
-	Log.setTag("LogManager"          , DEFAULT_LOG_LEVEL);
-	Log.setTag("PoolClock_main"      , DEFAULT_LOG_LEVEL);
-	Log.setTag("Sensor_AM232X"       , DEFAULT_LOG_LEVEL);
-	Log.setTag("Sensor_DS18B20"      , DEFAULT_LOG_LEVEL);
-	Log.setTag("Sensor_HCSR501"      , LOG_DEBUG);
-	Log.setTag("SevenSegment"        , DEFAULT_LOG_LEVEL);
-	Log.setTag("TimeManager"         , DEFAULT_LOG_LEVEL);
-	Log.setTag("WebSrvManager"       , LOG_DEBUG);
-
-    //LOG_(TAG, "send %d %s \nResponse: %s", http_rc, Response_type, Response);
-
-	#if LCD_SCREEN == true
-		LOG_I(TAG, "LCDScreen initialization...");
-		lcd.initLCDManager();
-		// Create PoolClock custom character
-  		lcd.createChar(CHAR_PLAY,  LCDPlayChar);
-  		lcd.createChar(CHAR_PAUSE, LCDPauseChar);
-  		lcd.createChar(CHAR_STOP,  LCDStopChar);
-		// Print first screen
-	    LCDScreen_Init(Project);
-	#endif
-
-    LOG_I(TAG, "Init Segment...");
-	PoolClockDisplays->InitSegments(0, WIFI_CONNECTING_COLOR, 50);
-
-    LOG_I(TAG, "setHourSegmentColors...");
-	PoolClockDisplays->setHourSegmentColors(HOUR_COLOR);
-    LOG_I(TAG, "setMinuteSegmentColors...");
-	PoolClockDisplays->setMinuteSegmentColors(MINUTE_COLOR);
-    LOG_I(TAG, "T...");
-	PoolClockDisplays->setTemp1SegmentColors(TEMP1_COLOR);
-    LOG_I(TAG, "setTemp2SegmentColors...");
-	PoolClockDisplays->setTemp2SegmentColors(TEMP2_COLOR);
-    LOG_I(TAG, "setInternalLEDColor...");
-	PoolClockDisplays->setInternalLEDColor(INTERNAL_COLOR);
-    LOG_I(TAG, "setDotLEDColor...");
-	PoolClockDisplays->setDotLEDColor(SEPARATION_DOT_COLOR);
-
 	#if RUN_WITHOUT_WIFI == false
     	LOG_I(TAG, "wifi setup...");
-		wifiSetup();
+		wifiSetup(resumed);
 		LOG_I(TAG, "wifi local IP : %s",WiFi.localIP().toString());
 	#endif
 	#if ENABLE_OTA_UPLOAD == true
@@ -218,18 +172,13 @@ void setup()
     	LOG_I(TAG, "Blynk configuration setup...");
 		BlynkConfiguration->setup();
 	#endif
+}
 
-    LOG_I(TAG, "Fetching time from NTP server...");
-	if(timeM->init() == false)
-	{
-	    LOG_E(TAG, "TimeManager failed to synchronize for the first time with the NTP server. Retrying in %d seconds", TIME_SYNC_INTERVAL);
-	}
-	String sCurrentTime = timeM->getCurrentTimeString(TimeManager::HourMinSecFormat);
-    LOG_I(TAG, "Current time : %s", sCurrentTime);
-	timeM->setTimerTickCallback(TimerTick);
-	timeM->setTimerDoneCallback(TimerDone);
-	timeM->setAlarmCallback(AlarmTriggered);
-
+/**
+ * \brief Discovers and initializes the temperature sensors
+ */
+void sensorsSetup()
+{
 	#if AIR_TEMP_SENSOR == true
 	    LOG_I(TAG, "initialize air temperature sensor...");
 		if (! am232x->init(I2C_SDA_PIN, I2C_SCL_PIN, AIR_TEMP_READ_FREQUENCY) ) 
@@ -254,7 +203,10 @@ void setup()
 			}
 		} 
 	#endif
+}
 
+void motionSensorSetup()
+{
 	#if PIR_SENSOR == true
 		LOG_I(TAG, "PIR Motion Sensor Initialization ...");
   		if (PIRSensor->init(PIR_SENSOR_PIN, PIR_SENSOR_DELAY))   // consider a delay of 5 minutes when the PIR sensor detects a motion
@@ -266,13 +218,10 @@ void setup()
 		    LOG_E(TAG, "PIR Motion Sensor Initialization FAILED");
 		}
 	#endif
+}
 
-	#if PUSH_BUTTONS == true
-		LOG_I(TAG, "Push button initialization...");
-		states->setup();
-		_last_treated_transition = NONE;
-	#endif
-
+void buzzerSetup()
+{
 	#if USE_BUZZER == true
 	  	LOG_I(TAG, "Buzzer Initialization ...");
  		buzzer.Init(BUZZER_PIN);
@@ -287,6 +236,124 @@ void setup()
 			buzzer.addMelody(BuzzerSongs[i]);
 		}
 	#endif
+}
+
+#if WARM_RESTART == true
+	/**
+	 * \brief Slow part of the setup after a warm restart. The clock already shows the resumed state, the WIFI, the
+	 *        sensors and the NTP synchronization are brought up on core 0 while the main loop keeps running.
+	 */
+	void BackgroundSetup(void* pvParameters)
+	{
+		sensorsSetup();
+		networkSetup(true);
+		states->startLoopTask();
+		LOG_I(TAG, "Fetching time from NTP server in the background...");
+		if(timeM->startSynchronization() == false)
+		{
+			LOG_E(TAG, "TimeManager failed to synchronize with the NTP server. Retrying in %d seconds", TIME_SYNC_INTERVAL);
+		}
+		LOG_I(TAG, "Background setup done...");
+		vTaskDelete(NULL);
+	}
+#endif
+
+void setup()
+{
+	Serial.begin(115200);
+
+	// Set appropriate log level. The defaul DEFAULT_LOG_LEVEL is defined in Configuration.h file
+	Log.setTag("*"                   , DEFAULT_LOG_LEVEL);
+	Log.setTag("BuzzerManager"       , DEFAULT_LOG_LEVEL);
+	Log.setTag("ClockState"          , DEFAULT_LOG_LEVEL);
+	Log.setTag("DisplayManager"      , DEFAULT_LOG_LEVEL);
+	Log.setTag("LCDManager"          , DEFAULT_LOG_LEVEL);
+	Log.setTag("LCDScreens"          , DEFAULT_LOG_LEVEL);
+	Log.setTag("LogManager"          , DEFAULT_LOG_LEVEL);
+	Log.setTag("PoolClock_main"      , DEFAULT_LOG_LEVEL);
+	Log.setTag("Sensor_AM232X"       , DEFAULT_LOG_LEVEL);
+	Log.setTag("Sensor_DS18B20"      , DEFAULT_LOG_LEVEL);
+	Log.setTag("Sensor_HCSR501"      , LOG_DEBUG);
+	Log.setTag("SevenSegment"        , DEFAULT_LOG_LEVEL);
+	Log.setTag("SettingsStore"       , DEFAULT_LOG_LEVEL);
+	Log.setTag("TimeManager"         , DEFAULT_LOG_LEVEL);
+	Log.setTag("WarmRestart"         , DEFAULT_LOG_LEVEL);
+	Log.setTag("WebSrvManager"       , LOG_DEBUG);
+
+    //LOG_(TAG, "send %d %s \nResponse: %s", http_rc, Response_type, Response);
+
+	#if WARM_RESTART == true
+		bool warmBoot = WarmRestart::getInstance()->begin();
+	#else
+		bool warmBoot = false;
+	#endif
+	if(warmBoot == false)
+	{
+		delay(100);
+	}
+
+	#if LCD_SCREEN == true
+		LOG_I(TAG, "LCDScreen initialization...");
+		lcd.initLCDManager();
+		// Create PoolClock custom character
+  		lcd.createChar(CHAR_PLAY,  LCDPlayChar);
+  		lcd.createChar(CHAR_PAUSE, LCDPauseChar);
+  		lcd.createChar(CHAR_STOP,  LCDStopChar);
+		// Print first screen
+		if(warmBoot == false)
+		{
+	    	LCDScreen_Init(Project);
+		}
+	#endif
+
+    LOG_I(TAG, "Init Segment...");
+	PoolClockDisplays->InitSegments(WIFI_CONNECTING_COLOR, 50);
+
+	#if WARM_RESTART == true
+		if(warmBoot == true)
+		{
+			//the state comes from the RTC memory, the rest of the setup is done in the background
+			PoolClockDisplays->setColorScheme(ColorScheme::fromConfiguration());
+			timeM->setSecondTickCallback(SecondTick);
+			timeM->setTimerTickCallback(TimerTick);
+			timeM->setTimerDoneCallback(TimerDone);
+			timeM->setAlarmCallback(AlarmTriggered);
+			motionSensorSetup();
+			states->setup();
+			WarmRestart::getInstance()->resume();
+			buzzerSetup();
+			xTaskCreatePinnedToCore(BackgroundSetup, "BackgroundSetup", 8192, NULL, 1, NULL, 0);
+			LOG_I(TAG, "Resumed in %lu ms...", millis());
+			return;
+		}
+	#endif
+
+	networkSetup(false);
+
+	//requested after the WIFI status colors, which cancel any scheme still pending
+    LOG_I(TAG, "setColorScheme...");
+	PoolClockDisplays->setColorScheme(ColorScheme::fromConfiguration());
+
+    LOG_I(TAG, "Fetching time from NTP server...");
+	if(timeM->init() == false)
+	{
+	    LOG_E(TAG, "TimeManager failed to synchronize for the first time with the NTP server. Retrying in %d seconds", TIME_SYNC_INTERVAL);
+	}
+	String sCurrentTime = timeM->getCurrentTimeString(TimeManager::HourMinSecFormat);
+    LOG_I(TAG, "Current time : %s", sCurrentTime);
+	timeM->setSecondTickCallback(SecondTick);
+	timeM->setTimerTickCallback(TimerTick);
+	timeM->setTimerDoneCallback(TimerDone);
+	timeM->setAlarmCallback(AlarmTriggered);
+
+	sensorsSetup();
+	motionSensorSetup();
+
+	LOG_I(TAG, "Clock state and push button initialization...");
+	states->setup();
+	states->startLoopTask();
+
+	buzzerSetup();
 
 	LOG_I(TAG, "Displaying startup animation...");
 	startupAnimation();
@@ -311,7 +378,10 @@ void loop()
 		//ArduinoOTA.handle();
 	#endif
 	LOG_V(TAG, "states->handleStates()...");
-	states->handleStates(); //updates display states, switches between modes etc.
+	if(PoolClockDisplays->isShowingProgress() == false) //the OTA progress bar owns the display until the update is done
+	{
+		states->handleStates(); //processes the pending events: updates display states, switches between modes etc.
+	}
 
 	if (states->_current_state == TIMER_NOTIFICATION) {
 		int duration = 1;
@@ -319,34 +389,6 @@ void loop()
     	buzzer.playMelody(0, duration);
 	}
 
-	if (states->_last_transition != NONE) {
-			LOG_D(TAG, "Main loop - Treat new transition: %d", states->_last_transition);
-			states->state_machine_run(states->_last_transition);
-			_last_treated_transition = states->_last_transition;
-			states->_last_transition = NONE;
-	} 
-
-	#if PIR_SENSOR == true
-	    isDetected = PIRSensor->isMotionDetected();
-	
-		if (isDetected)
-		{
-			if (previousIsDetected != isDetected)
-			{
-				LOG_I(TAG, "Motion is detected");
-				previousIsDetected = isDetected;
-			}
-		}
-		else
-		{
-			if (previousIsDetected != isDetected)
-			{
-				LOG_I(TAG, "No Motion detected");
-				previousIsDetected = isDetected;
-			}
-		}
-	#endif
-
 	LOG_V(TAG, "PoolClockDisplays->handle()...");
     PoolClockDisplays->handle();
 	LOG_V(TAG, "timeM->handle()...");
@@ -521,12 +563,20 @@ void AlarmTriggered()
 	// !!! ATTENTION !!! DON'T ADD ANY LOG IN THIS FUNCTION AS IT CAN BE CALLED IN A CALLBACK 
 	// ========================================================================================
 	LOG_I(TAG, "Alarm Triggered ....");
-    states->switchMode(ALARM_NOTIFICATION);
+	states->postEvent(EVENT_ALARM_TRIGGERED);
 	#if IS_BLYNK_ACTIVE == true
 		BlynkConfiguration->updateUI();
 	#endif
 }
 
+void SecondTick()
+{
+	// ========================================================================================
+	// !!! ATTENTION !!! DON'T ADD ANY LOG IN THIS FUNCTION AS IT CAN BE CALLED IN A CALLBACK 
+	// ========================================================================================
+	states->postEvent(EVENT_SECOND_TICK);
+}
+
 void TimerTick()
 {
 	// ========================================================================================
@@ -542,7 +592,7 @@ void TimerDone()
 	// ========================================================================================
 	// !!! ATTENTION !!! DON'T ADD ANY LOG IN THIS FUNCTION AS IT CAN BE CALLED IN A CALLBACK 
 	// ========================================================================================
-    states->switchMode(TIMER_NOTIFICATION);
+	states->postEvent(EVENT_TIMER_DONE);
 	#if IS_BLYNK_ACTIVE == true
 		BlynkConfiguration->updateUI();
 	#endif
@@ -557,7 +607,12 @@ void TimerDone()
 		WiFi.reconnect();
 	}
 
-	void wifiSetup()
+	/**
+	 * \brief Connects the WIFI
+	 * \param resumed true after a warm restart: the clock is already running, so the connection is not shown on
+	 *                the digits and the clock keeps running offline if it fails
+	 */
+	void wifiSetup(bool resumed)
 	{
 		#if USE_ESPTOUCH_SMART_CONFIG == true
 			WiFi.reconnect(); //try to reconnect
@@ -595,6 +650,21 @@ void TimerDone()
 		  LOG_E(TAG, "WIFI Connection failed");
 		
 
+		if(resumed == true)
+		{
+			//called from the background setup task, the main loop owns the display
+			for (int i = 0; i < NUM_RETRIES && WiFi.status() != WL_CONNECTED; i++)
+			{
+				vTaskDelay(500 / portTICK_PERIOD_MS);
+			}
+			if(WiFi.status() != WL_CONNECTED)
+			{
+				LOG_E(TAG, "WIFI connection failed, the clock keeps running offline");
+			}
+			WiFi.onEvent(WiFiStationDisconnected, ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+			return;
+		}
+
 		LOG_I(TAG, "setAllSegmentColors ...");
 		PoolClockDisplays->setAllSegmentColors(WIFI_CONNECTING_COLOR);
 		LOG_I(TAG, "showLoadingAnimation ...");
@@ -801,6 +871,21 @@ void TimerDone()
 		lcd.printScreen(screen);
 	}
 
+	/**
+	 * \brief Switches the LCD backlight, turned off by the idle mode of the ClockState while nobody is around
+	 */
+	void LCDScreen_Backlight(bool on)
+	{
+		if(on)
+		{
+			lcd.backlight();
+		}
+		else
+		{
+			lcd.noBacklight();
+		}
+	}
+
 	void LCDScreen_Clock_Mode(TimeManager* currentTime, float temperature1, float humidity1, float temperature2, float humidity2)
 	{
 		std::vector<std::string> screen;
@@ -0,0 +1,160 @@
+/**
+ * \file test_main.cpp
+ * \author Yves Gaignard
+ * \brief Host tests of the AnimatableObject: animations of different lengths can share one easing
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include <vector>
+#include "AnimatableObject.h"
+
+static const uint16_t FramePeriod = 20;
+static const uint16_t Fps = 50;
+static const uint16_t ShortDuration = 500;
+static const uint16_t LongDuration = 2000;
+//the long animation starts while the short one runs, then the short one starts again while the long one runs
+static const uint16_t LongStart = 100;
+static const uint16_t ShortRestart = 1000;
+
+static_assert(LongStart < ShortDuration, "the long animation has to start during the short one");
+static_assert(ShortRestart > LongStart && ShortRestart + ShortDuration < LongStart + LongDuration,
+			  "the short animation has to run again during the long one");
+
+/**
+ * \brief Records the state of every frame of its animation
+ */
+class RecordingObject : public AnimatableObject
+{
+public:
+	std::vector<int32_t> states;	/** getState() after each frame handled while the animation runs */
+	int32_t lastTick;				/** last state the animation was set to */
+
+	RecordingObject(uint16_t duration, EasingBase* easing) : AnimatableObject(duration, 0)
+	{
+		setAnimationFps(Fps);
+		setAnimationEasing(easing);
+		lastTick = INT32_MIN;
+		startTime = 0;
+	}
+
+	void begin()
+	{
+		states.clear();
+		lastTick = INT32_MIN;
+		startTime = millis();
+		start();
+	}
+
+	void frame()
+	{
+		handle();
+		if(millis() - startTime < getAnimationDuration())
+		{
+			states.push_back(getState());
+		}
+	}
+
+private:
+	unsigned long startTime;
+
+	void tick(int32_t currentState) override
+	{
+		lastTick = currentState;
+	}
+};
+
+static void nextFrame()
+{
+	SimClock::advanceMicros(FramePeriod * 1000UL);
+}
+
+/**
+ * \brief Runs one animation alone on the easing until it is done
+ */
+static void runAlone(RecordingObject& object, uint16_t duration)
+{
+	object.begin();
+	for (unsigned long time = 0; time <= duration; time += FramePeriod)
+	{
+		object.frame();
+		nextFrame();
+	}
+}
+
+void setUp() {}
+void tearDown() {}
+
+/**
+ * \brief Two animations of different lengths run interleaved on one easing object. Each one goes through exactly
+ *        the states it goes through when it runs alone, whichever of them was started last.
+ */
+void test_shared_easing_no_cross_talk()
+{
+	CubicEase easing(EASE_IN_OUT);
+	RecordingObject shortAlone(ShortDuration, &easing);
+	RecordingObject longAlone(LongDuration, &easing);
+	runAlone(shortAlone, ShortDuration);
+	runAlone(longAlone, LongDuration);
+	TEST_ASSERT_EQUAL(ShortDuration / FramePeriod, shortAlone.states.size());
+	TEST_ASSERT_EQUAL(LongDuration / FramePeriod, longAlone.states.size());
+
+	RecordingObject shortObject(ShortDuration, &easing);
+	RecordingObject longObject(LongDuration, &easing);
+	std::vector<int32_t> shortFirstRun;
+	int32_t shortFirstTick = INT32_MIN;
+	shortObject.begin();
+	for (unsigned long time = 0; time <= LongStart + LongDuration; time += FramePeriod)
+	{
+		if(time == LongStart)
+		{
+			longObject.begin();
+		}
+		if(time == ShortRestart)
+		{
+			shortFirstRun = shortObject.states;
+			shortFirstTick = shortObject.lastTick;
+			shortObject.begin();
+		}
+		shortObject.frame();
+		if(time >= LongStart)
+		{
+			longObject.frame();
+		}
+		nextFrame();
+	}
+
+	//the short animation while the long one was started after it
+	TEST_ASSERT_TRUE(shortAlone.states == shortFirstRun);
+	TEST_ASSERT_EQUAL(25, shortFirstTick);
+	//the long animation while the short one was started again after it
+	TEST_ASSERT_TRUE(longAlone.states == longObject.states);
+	TEST_ASSERT_EQUAL(100, longObject.lastTick);
+	TEST_ASSERT_TRUE(shortAlone.states == shortObject.states);
+	TEST_ASSERT_EQUAL(25, shortObject.lastTick);
+}
+
+/**
+ * \brief Each animation follows the easing on its own normalized time, starting at 0 and ending on its last state
+ */
+void test_states_follow_the_easing()
+{
+	CubicEase easing(EASE_IN_OUT);
+	RecordingObject object(ShortDuration, &easing);
+	runAlone(object, ShortDuration);
+	TEST_ASSERT_EQUAL(0, object.states.front());
+	TEST_ASSERT_EQUAL(25, object.lastTick);
+	for (size_t i = 1; i < object.states.size(); i++)
+	{
+		TEST_ASSERT_TRUE(object.states[i] >= object.states[i - 1]);
+		TEST_ASSERT_EQUAL((int32_t)easing.ease((NUMBER)(i * FramePeriod) / ShortDuration, 25), object.states[i]);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_shared_easing_no_cross_talk);
+	RUN_TEST(test_states_follow_the_easing);
+	return UNITY_END();
+}
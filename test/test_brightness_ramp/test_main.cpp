@@ -0,0 +1,104 @@
+/**
+ * \file test_main.cpp
+ * \author Yves Gaignard
+ * \brief Host tests of the BrightnessRamp: a new target continues the ramp from the shown brightness
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include "BrightnessRamp.h"
+
+static const uint16_t RampDuration = 1000;
+static const unsigned long FramePeriod = 20;
+
+void setUp() {}
+void tearDown() {}
+
+/**
+ * \brief Advances frame by frame until the target is reached, the brightness has to move towards the target without
+ *        ever jumping by more than a sixth of the full scale in one frame
+ * \return the time the target was reached
+ */
+static unsigned long rampFrames(BrightnessRamp& ramp, unsigned long frame, unsigned long end, uint8_t target)
+{
+	uint8_t previous = ramp.getBrightness();
+	while (ramp.isRamping() && frame < end)
+	{
+		frame += FramePeriod;
+		ramp.advance(frame);
+		uint8_t brightness = ramp.getBrightness();
+		int step = previous > brightness ? previous - brightness : brightness - previous;
+		TEST_ASSERT_LESS_OR_EQUAL_MESSAGE(42, step, "the brightness jumped");
+		if(target < previous)
+		{
+			TEST_ASSERT_TRUE_MESSAGE(brightness <= previous && brightness >= target, "the brightness moved away from the target");
+		}
+		else
+		{
+			TEST_ASSERT_TRUE_MESSAGE(brightness >= previous && brightness <= target, "the brightness moved away from the target");
+		}
+		previous = brightness;
+	}
+	return frame;
+}
+
+/**
+ * \brief DisplayManager sets the target with millis() after FastLED.show() and advances with the older time of the
+ *        frame, this used to underflow and snap the ramp to its target
+ */
+void test_target_set_after_the_frame_time()
+{
+	BrightnessRamp ramp(RampDuration);
+	ramp.jumpTo(200, 1000);
+	ramp.advance(1000);
+	ramp.setTarget(50, 1005);
+	ramp.advance(1000);
+	TEST_ASSERT_EQUAL_UINT8(200, ramp.getBrightness());
+	TEST_ASSERT_TRUE(ramp.isRamping());
+
+	unsigned long reached = rampFrames(ramp, 1000, 1000 + 2 * RampDuration, 50);
+	TEST_ASSERT_FALSE_MESSAGE(ramp.isRamping(), "the target was not reached");
+	TEST_ASSERT_EQUAL_UINT8(50, ramp.getBrightness());
+	TEST_ASSERT_GREATER_OR_EQUAL(1005 + RampDuration - FramePeriod, reached);
+	TEST_ASSERT_LESS_OR_EQUAL(1005 + RampDuration + FramePeriod, reached);
+}
+
+/**
+ * \brief A target changed in the middle of a ramp continues from the shown brightness
+ */
+void test_retarget_in_the_middle_of_a_ramp()
+{
+	BrightnessRamp ramp(RampDuration);
+	ramp.jumpTo(20, 0);
+	ramp.setTarget(255, 0);
+	unsigned long frame = rampFrames(ramp, 0, RampDuration / 2, 255);
+	uint8_t middle = ramp.getBrightness();
+	TEST_ASSERT_TRUE(middle > 20 && middle < 255);
+
+	ramp.setTarget(10, frame);
+	TEST_ASSERT_EQUAL_UINT8(middle, ramp.getBrightness());
+	rampFrames(ramp, frame, frame + 2 * RampDuration, 10);
+	TEST_ASSERT_EQUAL_UINT8(10, ramp.getBrightness());
+}
+
+/**
+ * \brief The first frame after a long pause ends the ramp instead of overflowing its step
+ */
+void test_long_pause()
+{
+	BrightnessRamp ramp(RampDuration);
+	ramp.jumpTo(0, 0);
+	ramp.setTarget(128, 0);
+	ramp.advance(10UL * 24 * 3600 * 1000);
+	TEST_ASSERT_FALSE(ramp.isRamping());
+	TEST_ASSERT_EQUAL_UINT8(128, ramp.getBrightness());
+}
+
+int main()
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_target_set_after_the_frame_time);
+	RUN_TEST(test_retarget_in_the_middle_of_a_ramp);
+	RUN_TEST(test_long_pause);
+	return UNITY_END();
+}
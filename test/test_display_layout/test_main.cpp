@@ -0,0 +1,141 @@
+/**
+ * \file test_main.cpp
+ * \author Yves Gaignard
+ * \brief Host tests of the LED offsets of the segments and the strips computed from DisplayLayoutConfiguration.h
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include "DisplayLayout.h"
+#include "DisplayManager.h"
+
+void setUp() {}
+void tearDown() {}
+
+/**
+ * \brief Number of LEDs of a segment of a display, written again from DisplayConfiguration.h
+ */
+static uint16_t expectedSegmentLength(DisplayIDs display)
+{
+	switch (DisplayLayout::Displays[display].size)
+	{
+	case SevenSegment::LONG_SEGMENT:
+		return NUM_LEDS_PER_LONG_SEGMENT;
+	case SevenSegment::SHORT_SEGMENT:
+		return NUM_LEDS_PER_SHORT_SEGMENT;
+	default:
+		return NUM_LEDS_PER_DOT_SEGMENT;
+	}
+}
+
+/**
+ * \brief Every segment starts where the one wired before it ends
+ */
+void test_segment_offsets_follow_the_wiring()
+{
+	uint16_t led = 0;
+	for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
+	{
+		TEST_ASSERT_EQUAL_UINT16(led, DisplayLayout::firstLedOfSegment(i));
+		TEST_ASSERT_EQUAL_UINT16(expectedSegmentLength(DisplayLayout::Segments[i].display), DisplayLayout::segmentLength(i));
+		led += expectedSegmentLength(DisplayLayout::Segments[i].display);
+	}
+	TEST_ASSERT_EQUAL_UINT16(led, DisplayLayout::NumSegmentLeds);
+	#if APPEND_DOWN_LIGHTERS == true
+		TEST_ASSERT_EQUAL_UINT16(led + ADDITIONAL_LEDS, NUM_LEDS);
+	#else
+		TEST_ASSERT_EQUAL_UINT16(led, NUM_LEDS);
+	#endif
+}
+
+/**
+ * \brief The first LED of every display of the pool clock: 2 temperature digits of 3 LEDs per segment, 4 time
+ *        digits of 7 LEDs per segment and 2 dots of 1 LED
+ */
+void test_display_offsets_of_the_pool_clock()
+{
+	static const uint16_t FirstLeds[NUM_DISPLAYS] = {0, 21, 42, 91, 140, 142, 191, 240, 261};
+	for (uint8_t display = 0; display < NUM_DISPLAYS; display++)
+	{
+		int16_t first = NUM_SEGMENTS;
+		for (uint8_t position = 0; position < 7; position++)
+		{
+			int16_t segment = DisplayLayout::segmentIndex((SegmentPositions_t)position, (DisplayIDs)display);
+			if(segment != NO_SEGMENTS && segment < first)
+			{
+				first = segment;
+			}
+		}
+		TEST_ASSERT_EQUAL_UINT16(FirstLeds[display], DisplayLayout::firstLedOfSegment(first));
+	}
+	TEST_ASSERT_EQUAL_UINT16(282, DisplayLayout::NumSegmentLeds);
+}
+
+/**
+ * \brief The index table finds every segment at the display and the position it is wired to, and nothing elsewhere
+ */
+void test_segment_index_table()
+{
+	uint16_t found = 0;
+	for (uint8_t display = 0; display < NUM_DISPLAYS; display++)
+	{
+		for (uint8_t position = 0; position < 7; position++)
+		{
+			int16_t segment = DisplayLayout::segmentIndex((SegmentPositions_t)position, (DisplayIDs)display);
+			if(segment == NO_SEGMENTS)
+			{
+				continue;
+			}
+			TEST_ASSERT_EQUAL(display, DisplayLayout::Segments[segment].display);
+			TEST_ASSERT_EQUAL(1 << position, DisplayLayout::Segments[segment].position);
+			found++;
+		}
+	}
+	TEST_ASSERT_EQUAL_UINT16(NUM_SEGMENTS, found);
+	TEST_ASSERT_EQUAL(NO_SEGMENTS, DisplayLayout::segmentIndex((SegmentPositions_t)0, (DisplayIDs)NUM_DISPLAYS));
+}
+
+/**
+ * \brief The strips cover the LED buffer without gap or overlap, each one starts at the first segment of its display
+ *        and the FastLED controllers added by the DisplayManager are the ones of the layout
+ */
+void test_strips_match_the_controllers()
+{
+	uint16_t led = 0;
+	for (uint8_t strip = 0; strip < NUM_LED_STRIPS; strip++)
+	{
+		uint16_t first = DisplayLayout::firstSegmentOfStrip(strip);
+		TEST_ASSERT_EQUAL(DisplayLayout::Strips[strip].firstDisplay, DisplayLayout::Segments[first].display);
+		TEST_ASSERT_EQUAL_UINT16(led, DisplayLayout::firstLedOfStrip(strip));
+		led += DisplayLayout::stripLength(strip);
+	}
+	TEST_ASSERT_EQUAL_UINT16(NUM_LEDS, led);
+	for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
+	{
+		uint8_t strip = DisplayLayout::stripOfSegment(i);
+		TEST_ASSERT_TRUE(DisplayLayout::firstLedOfSegment(i) >= DisplayLayout::firstLedOfStrip(strip));
+		TEST_ASSERT_TRUE(DisplayLayout::firstLedOfSegment(i) + DisplayLayout::segmentLength(i) <= DisplayLayout::firstLedOfStrip(strip) + DisplayLayout::stripLength(strip));
+	}
+	TEST_ASSERT_EQUAL_UINT32(DisplayLayout::stripLength(0) * 30 + 50, DisplayLayout::estimatedShowTimeMicros());
+
+	DisplayManager::getInstance()->InitSegments(CRGB::White, 50);
+	const std::vector<CLEDController>& controllers = FastLED.getControllers();
+	TEST_ASSERT_TRUE(controllers.size() >= NUM_LED_STRIPS);
+	CRGB* buffer = controllers[0].leds;
+	for (uint8_t strip = 0; strip < NUM_LED_STRIPS; strip++)
+	{
+		TEST_ASSERT_EQUAL(DisplayLayout::Strips[strip].pin, controllers[strip].pin);
+		TEST_ASSERT_EQUAL(DisplayLayout::firstLedOfStrip(strip), controllers[strip].leds - buffer);
+		TEST_ASSERT_EQUAL(DisplayLayout::stripLength(strip), controllers[strip].numLeds);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_segment_offsets_follow_the_wiring);
+	RUN_TEST(test_display_offsets_of_the_pool_clock);
+	RUN_TEST(test_segment_index_table);
+	RUN_TEST(test_strips_match_the_controllers);
+	return UNITY_END();
+}
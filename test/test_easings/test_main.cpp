@@ -0,0 +1,270 @@
+/**
+ * \file test_main.cpp
+ * \author Yves Gaignard
+ * \brief Accuracy checks and benchmark of the easings, prints the tables of lib/Easings/README.md
+ *
+ * Usage: pio test -e native -f test_easings -v
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include <chrono>
+#include <easing.h>
+
+/** samples per curve of the accuracy and characteristics checks, the time steps by 1e-5 */
+static const int Samples = 100001;
+/** states of a 900 ms digit transition at 60 fps */
+static const int TransitionStates = 54;
+/** largest error of a LUTEase in states of a digit transition */
+static const double LUTEaseMaxStates = 0.1;
+/** calls per measurement of the benchmark, the best of BenchmarkRuns measurements is reported */
+static const int BenchmarkCalls = 1000000;
+static const int BenchmarkRuns = 5;
+
+static const easingType_t Types[3] = { EASE_IN, EASE_OUT, EASE_IN_OUT };
+
+typedef NUMBER (*CurveFunction)(NUMBER);
+typedef double (*InlineBenchmark)();
+
+/**
+ * \brief One curve in all the implementations of the library
+ */
+struct Curve
+{
+	const char* name;
+	EasingBase* analytic;			/** class of easetypes/, its type is set before each use */
+	EasingBase* statics[3];			/** STATIC_EASING() of each type */
+	EasingBase* lut;				/** LUTEase, its type is set before each use, nullptr if the curve has none */
+	CurveFunction reference[3];		/** constexpr curve of each type */
+	CurveFunction table[3];			/** lookup table of each type, built for all curves to measure their error */
+	InlineBenchmark inlined[3];		/** Easing<> template of each type, inlined into the benchmark loop */
+	bool monotonic;
+};
+
+template<class curve_, easingType_t type_>
+__attribute__((noinline)) double benchmarkInlined()
+{
+	double best = 1e9;
+	double sum = 0;
+	for (int run = 0; run < BenchmarkRuns; run++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < BenchmarkCalls; i++)
+		{
+			sum += Easing<curve_, type_>::ease(i * (1.0 / BenchmarkCalls), TransitionStates);
+		}
+		std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+		best = std::min(best, elapsed.count() / BenchmarkCalls);
+	}
+	volatile double sink = sum;
+	(void)sink;
+	return best;
+}
+
+template<class curve_>
+EasingBase* makeLUTEase()
+{
+	if constexpr (LUTEaseSupported<curve_>::value)
+	{
+		return new LUTEase<curve_>();
+	}
+	return nullptr;
+}
+
+template<class curve_, easingType_t type_>
+NUMBER lookupTable(NUMBER time_)
+{
+	return EasingTables<curve_>::lookup(type_ == EASE_IN ? EasingTables<curve_>::in :
+										type_ == EASE_OUT ? EasingTables<curve_>::out : EasingTables<curve_>::inOut, time_);
+}
+
+#define CURVE(NAME, MONOTONIC) { #NAME, new NAME##Ease(), \
+	{ STATIC_EASING(NAME, EASE_IN), STATIC_EASING(NAME, EASE_OUT), STATIC_EASING(NAME, EASE_IN_OUT) }, makeLUTEase<EasingCurves::NAME>(), \
+	{ &EasingCurves::NAME::in, &EasingCurves::NAME::out, &EasingCurves::NAME::inOut }, \
+	{ &lookupTable<EasingCurves::NAME, EASE_IN>, &lookupTable<EasingCurves::NAME, EASE_OUT>, &lookupTable<EasingCurves::NAME, EASE_IN_OUT> }, \
+	{ &benchmarkInlined<EasingCurves::NAME, EASE_IN>, &benchmarkInlined<EasingCurves::NAME, EASE_OUT>, &benchmarkInlined<EasingCurves::NAME, EASE_IN_OUT> }, \
+	MONOTONIC }
+
+static Curve Curves[] = {
+	CURVE(Back, false),
+	CURVE(Bounce, false),
+	CURVE(Circular, true),
+	CURVE(Cubic, true),
+	CURVE(Elastic, false),
+	CURVE(Exponential, true),
+	CURVE(Linear, true),
+	CURVE(Quadratic, true),
+	CURVE(Quartic, true),
+	CURVE(Quintic, true),
+	CURVE(Sine, true),
+};
+
+static NUMBER sampleTime(int sample)
+{
+	return (NUMBER)sample / (Samples - 1);
+}
+
+/**
+ * \brief Best time per call through the virtual EasingBase::ease(), the easing is only known at run time
+ */
+__attribute__((noinline)) static double benchmark(EasingBase* easing)
+{
+	double best = 1e9;
+	double sum = 0;
+	for (int run = 0; run < BenchmarkRuns; run++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < BenchmarkCalls; i++)
+		{
+			sum += easing->ease(i * (1.0 / BenchmarkCalls), TransitionStates);
+		}
+		std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+		best = std::min(best, elapsed.count() / BenchmarkCalls);
+	}
+	volatile double sink = sum;
+	(void)sink;
+	return best;
+}
+
+void setUp() {}
+void tearDown() {}
+
+/**
+ * \brief The analytic classes, STATIC_EASING() and the constexpr curves are the same functions
+ */
+void test_implementations_agree()
+{
+	for (Curve& curve : Curves)
+	{
+		for (int type = 0; type < 3; type++)
+		{
+			curve.analytic->setType(Types[type]);
+			for (int sample = 0; sample < Samples; sample += 7)
+			{
+				NUMBER time = sampleTime(sample);
+				NUMBER expected = curve.reference[type](time) * TransitionStates;
+				TEST_ASSERT_TRUE_MESSAGE(fabs(curve.analytic->ease(time, TransitionStates) - expected) < 1e-9, curve.name);
+				TEST_ASSERT_TRUE_MESSAGE(fabs(curve.statics[type]->ease(time, TransitionStates) - expected) < 1e-9, curve.name);
+			}
+		}
+	}
+}
+
+/**
+ * \brief Prints the range of every curve and checks its start, end and monotony. The start and end are only checked
+ *        to 1e-12 of the change: Back out starts a few ulp above 0, Back in and Sine in end a few ulp below 1
+ */
+void test_curve_characteristics()
+{
+	printf("\n| Curve       | in range      | out range     | inOut range   | monotonic |\n");
+	printf("|-------------|---------------|---------------|---------------|-----------|\n");
+	for (Curve& curve : Curves)
+	{
+		char ranges[3][32];
+		bool monotonic = true;
+		for (int type = 0; type < 3; type++)
+		{
+			curve.analytic->setType(Types[type]);
+			TEST_ASSERT_TRUE_MESSAGE(fabs(curve.analytic->ease(0, TransitionStates)) < 1e-12, curve.name);
+			TEST_ASSERT_TRUE_MESSAGE(fabs(curve.analytic->ease(1, TransitionStates) - TransitionStates) < 1e-12, curve.name);
+			NUMBER low = 0;
+			NUMBER high = 0;
+			NUMBER previous = 0;
+			for (int sample = 0; sample < Samples; sample++)
+			{
+				NUMBER value = curve.analytic->ease(sampleTime(sample), 1);
+				low = std::min(low, value);
+				high = std::max(high, value);
+				monotonic = monotonic && value >= previous;
+				previous = value;
+			}
+			snprintf(ranges[type], sizeof(ranges[type]), low < -5e-4 ? "%.3f.." : "%.0f..", low);
+			snprintf(ranges[type] + strlen(ranges[type]), sizeof(ranges[type]) - strlen(ranges[type]), high > 1 + 5e-4 ? "%.3f" : "%.0f", high);
+		}
+		printf("| %-11s | %-13s | %-13s | %-13s | %-9s |\n", curve.name, ranges[0], ranges[1], ranges[2], monotonic ? "yes" : "no");
+		TEST_ASSERT_TRUE_MESSAGE(monotonic == curve.monotonic, curve.name);
+	}
+}
+
+/**
+ * \brief Prints the error of the lookup tables of all curves against the analytic curves, the ones LUTEase is
+ *        available for have to stay within #LUTEaseMaxStates
+ */
+void test_lut_accuracy()
+{
+	printf("\n| Curve       | in      | out     | inOut   | states of %d | LUTEase |\n", TransitionStates);
+	printf("|-------------|---------|---------|---------|--------------|---------|\n");
+	for (Curve& curve : Curves)
+	{
+		NUMBER errors[3];
+		NUMBER worst = 0;
+		for (int type = 0; type < 3; type++)
+		{
+			TEST_ASSERT_TRUE_MESSAGE(curve.table[type](0) == 0, curve.name);
+			TEST_ASSERT_TRUE_MESSAGE(curve.table[type](1) == 1, curve.name);
+			errors[type] = 0;
+			for (int sample = 0; sample < Samples; sample++)
+			{
+				NUMBER time = sampleTime(sample);
+				errors[type] = std::max(errors[type], fabs(curve.table[type](time) - curve.reference[type](time)));
+			}
+			worst = std::max(worst, errors[type]);
+			if(curve.lut != nullptr)
+			{
+				curve.lut->setType(Types[type]);
+				TEST_ASSERT_TRUE_MESSAGE(curve.lut->ease(sampleTime(Samples / 3), 1) == curve.table[type](sampleTime(Samples / 3)), curve.name);
+			}
+		}
+		printf("| %-11s | %.1e | %.1e | %.1e | %12.2f | %-7s |\n", curve.name, errors[0], errors[1], errors[2], worst * TransitionStates,
+			   curve.lut != nullptr ? "yes" : "no");
+		if(curve.lut != nullptr)
+		{
+			TEST_ASSERT_TRUE_MESSAGE(worst * TransitionStates <= LUTEaseMaxStates, curve.name);
+		}
+	}
+}
+
+/**
+ * \brief Prints the cost per call of each implementation, the average of the three types
+ */
+void test_cost_per_call()
+{
+	printf("\n| Curve       | ease()  | STATIC_EASING | Easing<> | LUTEase |\n");
+	printf("|-------------|---------|---------------|----------|---------|\n");
+	for (Curve& curve : Curves)
+	{
+		double analytic = 0;
+		double statics = 0;
+		double inlined = 0;
+		double lut = 0;
+		for (int type = 0; type < 3; type++)
+		{
+			curve.analytic->setType(Types[type]);
+			analytic += benchmark(curve.analytic) / 3;
+			statics += benchmark(curve.statics[type]) / 3;
+			inlined += curve.inlined[type]() / 3;
+			if(curve.lut != nullptr)
+			{
+				curve.lut->setType(Types[type]);
+				lut += benchmark(curve.lut) / 3;
+			}
+		}
+		char lutCost[16] = "-";
+		if(curve.lut != nullptr)
+		{
+			snprintf(lutCost, sizeof(lutCost), "%.1f", lut);
+		}
+		printf("| %-11s | %7.1f | %13.1f | %8.1f | %7s |\n", curve.name, analytic, statics, inlined, lutCost);
+	}
+	printf("ns per call, best of %d runs of %d calls\n", BenchmarkRuns, BenchmarkCalls);
+}
+
+int main()
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_implementations_agree);
+	RUN_TEST(test_curve_characteristics);
+	RUN_TEST(test_lut_accuracy);
+	RUN_TEST(test_cost_per_call);
+	return UNITY_END();
+}
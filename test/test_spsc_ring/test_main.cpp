@@ -0,0 +1,137 @@
+/**
+ * \file test_main.cpp
+ * \author Yves Gaignard
+ * \brief Host stress test of the SpscRing with a producer and a consumer thread
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include <thread>
+#include "SpscRing.h"
+
+static const uint32_t Events = 2000000;
+static const uint16_t RingSize = 16;	/** small, so the ring is full and empty all the time */
+
+/**
+ * \brief Event spread over several words, a torn copy does not pass #isIntact
+ */
+typedef struct
+{
+	uint32_t sequence;
+	uint32_t inverted;
+	uint64_t square;
+} Event;
+
+static Event makeEvent(uint32_t sequence)
+{
+	return { sequence, ~sequence, (uint64_t)sequence * sequence };
+}
+
+static bool isIntact(const Event& event)
+{
+	return event.inverted == ~event.sequence && event.square == (uint64_t)event.sequence * event.sequence;
+}
+
+void setUp() {}
+void tearDown() {}
+
+/**
+ * \brief The producer retries until every event is taken, the consumer has to receive all of them once and in order
+ */
+void test_no_event_lost_or_duplicated()
+{
+	static SpscRing<Event, RingSize> ring;
+	std::thread producer([]()
+	{
+		for (uint32_t sequence = 0; sequence < Events; sequence++)
+		{
+			while (!ring.push(makeEvent(sequence)))
+			{
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	uint32_t expected = 0;
+	uint32_t torn = 0;
+	uint32_t outOfOrder = 0;
+	while (expected < Events)
+	{
+		Event event;
+		if(!ring.pop(event))
+		{
+			std::this_thread::yield();
+			continue;
+		}
+		torn += isIntact(event) ? 0 : 1;
+		outOfOrder += event.sequence == expected ? 0 : 1;
+		expected = event.sequence + 1;
+	}
+	producer.join();
+
+	Event extra;
+	TEST_ASSERT_EQUAL_UINT32(0, torn);
+	TEST_ASSERT_EQUAL_UINT32(0, outOfOrder);
+	TEST_ASSERT_FALSE_MESSAGE(ring.pop(extra), "an event was delivered twice");
+	TEST_ASSERT_EQUAL_UINT32(Events, ring.getPushed());
+	printf("%u events, %u pushes rejected while the ring was full\n", Events, ring.getDropped());
+}
+
+/**
+ * \brief The producer does not wait for the consumer: every event is either delivered once or counted as dropped
+ */
+void test_dropped_events_are_counted()
+{
+	static SpscRing<Event, RingSize> ring;
+	static std::atomic<bool> done(false);
+	std::thread producer([]()
+	{
+		for (uint32_t sequence = 0; sequence < Events; sequence++)
+		{
+			ring.push(makeEvent(sequence));
+			//give the consumer a chance on a host with a single core
+			if(sequence % (2 * RingSize) == 0)
+			{
+				std::this_thread::yield();
+			}
+		}
+		done.store(true);
+	});
+
+	uint32_t received = 0;
+	uint32_t torn = 0;
+	uint32_t notIncreasing = 0;
+	int64_t last = -1;
+	Event event;
+	while (true)
+	{
+		bool finished = done.load();
+		while (ring.pop(event))
+		{
+			received++;
+			torn += isIntact(event) ? 0 : 1;
+			notIncreasing += (int64_t)event.sequence > last ? 0 : 1;
+			last = event.sequence;
+		}
+		if(finished)
+		{
+			break;
+		}
+		std::this_thread::yield();
+	}
+	producer.join();
+
+	TEST_ASSERT_EQUAL_UINT32(0, torn);
+	TEST_ASSERT_EQUAL_UINT32(0, notIncreasing);
+	TEST_ASSERT_EQUAL_UINT32(Events, received + ring.getDropped());
+	TEST_ASSERT_EQUAL_UINT32(Events - ring.getDropped(), ring.getPushed());
+	printf("%u events, %u delivered, %u dropped\n", Events, received, ring.getDropped());
+}
+
+int main()
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_no_event_lost_or_duplicated);
+	RUN_TEST(test_dropped_events_are_counted);
+	return UNITY_END();
+}
@@ -0,0 +1,550 @@
+/**
+ * \file test_main.cpp
+ * \author Yves Gaignard
+ * \brief Host tests of the ClockState dispatcher: every state and transition runs the action and reaches the next
+ *        state of Doc/StateMachine.csv, and the cost of one dispatch
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <string.h>
+#include "LogManager.h"
+#include "DisplayManager.h"
+#include "ClockState.h"
+#include "TimeManager.h"
+#include "Sensor_AM232X.h"
+#include "Sensor_DS18B20.h"
+
+#if LCD_SCREEN == true
+	extern void LCDScreen_Clock_Mode(TimeManager* currentTime, float temperature1, float humidity1, float temperature2, float humidity2);
+#endif
+
+/**
+ * \brief One cell of the state machine as written in Doc/StateMachine.csv. The action is the start of the text
+ *        the action logs after "Action: ".
+ */
+struct Expected
+{
+	const char* action;
+	ClockStates next;
+};
+
+static const uint8_t StateCount      = ALARM_NOTIFICATION + 1;
+static const uint8_t TransitionCount = LONG_MINUS + 1;
+
+static const char* const StateNames[StateCount] = {"CLOCK_MODE", "TIMER_MODE", "SET_TIMER", "TIMER_NOTIFICATION", "ALARM_NOTIFICATION"};
+static const char* const TransitionNames[TransitionCount] = {"NONE", "MODE", "LONG_MODE", "PLAY", "LONG_PLAY", "PLUS", "LONG_PLUS", "MINUS", "LONG_MINUS"};
+
+//written from the table by hand and not from StateMachineTable.h, so that a wrong regeneration fails here
+static const Expected Table[StateCount][TransitionCount] =
+{
+	//CLOCK_MODE
+	{
+		{"NOPE", CLOCK_MODE},
+		{"Change Mode To Timer", TIMER_MODE},
+		{"Change Mode To Set Timer", SET_TIMER},
+		{"NOPE", CLOCK_MODE},
+		{"NOPE", CLOCK_MODE},
+		{"NOPE", CLOCK_MODE},
+		{"NOPE", CLOCK_MODE},
+		{"NOPE", CLOCK_MODE},
+		{"NOPE", CLOCK_MODE},
+	},
+	//TIMER_MODE
+	{
+		{"NOPE", TIMER_MODE},
+		{"Change Mode To Clock", CLOCK_MODE},
+		{"Change Mode To Set Timer", SET_TIMER},
+		{"Start Pause Resume Timer", TIMER_MODE},
+		{"Cancel Timer", TIMER_MODE},
+		{"NOPE", TIMER_MODE},
+		{"NOPE", TIMER_MODE},
+		{"NOPE", TIMER_MODE},
+		{"NOPE", TIMER_MODE},
+	},
+	//SET_TIMER
+	{
+		{"NOPE", SET_TIMER},
+		{"Validate Set Timer", TIMER_MODE},
+		{"Cancel Set Timer", CLOCK_MODE},
+		{"Move Digit to", SET_TIMER},
+		{"Validate Set Timer", TIMER_MODE},
+		{"Increment Digit", SET_TIMER},
+		{"Increment Quickly Digit", SET_TIMER},
+		{"Decrement Digit", SET_TIMER},
+		{"Decrement Quickly Digit", SET_TIMER},
+	},
+	//TIMER_NOTIFICATION
+	{
+		{"NOPE", TIMER_NOTIFICATION},
+		{"Dismiss Notification", CLOCK_MODE},
+		{"Dismiss Notification", CLOCK_MODE},
+		{"Dismiss Notification", CLOCK_MODE},
+		{"Dismiss Notification", CLOCK_MODE},
+		{"Dismiss Notification", CLOCK_MODE},
+		{"Dismiss Notification", CLOCK_MODE},
+		{"Dismiss Notification", CLOCK_MODE},
+		{"Dismiss Notification", CLOCK_MODE},
+	},
+	//ALARM_NOTIFICATION
+	{
+		{"NOPE", ALARM_NOTIFICATION},
+		{"Dismiss Notification", CLOCK_MODE},
+		{"Dismiss Notification", CLOCK_MODE},
+		{"Dismiss Notification", CLOCK_MODE},
+		{"Dismiss Notification", CLOCK_MODE},
+		{"Dismiss Notification", CLOCK_MODE},
+		{"Dismiss Notification", CLOCK_MODE},
+		{"Dismiss Notification", CLOCK_MODE},
+		{"Dismiss Notification", CLOCK_MODE},
+	},
+};
+
+static const int BenchmarkRuns  = 5;
+static const int BenchmarkCalls = 1000000;
+//the main loop is run once per ms of the simulated minute
+static const unsigned long MinuteMillis = 60000;
+//interval of the poll replaced by the event queue
+static const unsigned long PollInterval = 250;
+
+static ClockState* clockState = nullptr;
+static int actionCount = 0;
+static char action[128];
+
+/**
+ * \brief Keeps the actions the dispatcher ran, the other messages are dropped
+ */
+static void captureAction(const char* tag, const char* message)
+{
+	const char* start = strstr(message, "Action: ");
+	if(start == nullptr)
+	{
+		return;
+	}
+	actionCount++;
+	strncpy(action, start + strlen("Action: "), sizeof(action) - 1);
+	action[sizeof(action) - 1] = '\0';
+}
+
+/**
+ * \brief Puts the clock in the state and handles the mode change, as the main loop would before the next press
+ */
+static void enterState(ClockStates state)
+{
+	clockState->switchMode(state);
+	clockState->handleStates();
+	TEST_ASSERT_EQUAL(state, clockState->getMode());
+}
+
+void setUp()
+{
+	if(clockState == nullptr)
+	{
+		//same start up as the firmware
+		DisplayManager::getInstance()->InitSegments(WIFI_CONNECTING_COLOR, 50);
+		clockState = ClockState::getInstance();
+		clockState->setup();
+	}
+	enterState(CLOCK_MODE);
+}
+
+void tearDown()
+{
+	Log.setCapture(nullptr);
+	Log.setLogLevel(LOG_WARNING);
+}
+
+/**
+ * \brief Every transition in every state runs exactly the action of the table and ends in the next state of the table
+ */
+void test_every_state_and_transition()
+{
+	char message[160];
+	for (uint8_t state = 0; state < StateCount; state++)
+	{
+		for (uint8_t transition = 0; transition < TransitionCount; transition++)
+		{
+			const Expected& expected = Table[state][transition];
+			snprintf(message, sizeof(message), "%s x %s", StateNames[state], TransitionNames[transition]);
+			enterState((ClockStates)state);
+
+			Log.setLogLevel(LOG_VERBOSE);
+			Log.setCapture(captureAction);
+			actionCount = 0;
+			action[0] = '\0';
+			clockState->state_machine_run((Transitions_enum)transition);
+			Log.setCapture(nullptr);
+			Log.setLogLevel(LOG_WARNING);
+
+			TEST_ASSERT_EQUAL_MESSAGE(1, actionCount, message);
+			TEST_ASSERT_EQUAL_MESSAGE(0, strncmp(action, expected.action, strlen(expected.action)), message);
+			TEST_ASSERT_EQUAL_MESSAGE(expected.next, clockState->getMode(), message);
+
+			//the mode change event of the action has to be handled in the next state as well
+			clockState->handleStates();
+			TEST_ASSERT_EQUAL_MESSAGE(expected.next, clockState->getMode(), message);
+		}
+	}
+}
+
+/**
+ * \brief A transition outside of the table is refused without running any action
+ */
+void test_invalid_transition()
+{
+	enterState(TIMER_MODE);
+	Log.setLogLevel(LOG_VERBOSE);
+	Log.setCapture(captureAction);
+	actionCount = 0;
+	clockState->state_machine_run((Transitions_enum)TransitionCount);
+	Log.setCapture(nullptr);
+	TEST_ASSERT_EQUAL(0, actionCount);
+	TEST_ASSERT_EQUAL(TIMER_MODE, clockState->getMode());
+}
+
+/**
+ * \brief Cancelling the setting of the timer keeps the duration validated before, the next timer mode does not start
+ *        from 00:00:00
+ */
+void test_cancel_set_timer_keeps_the_timer()
+{
+	TimeManager* timeM = TimeManager::getInstance();
+	enterState(SET_TIMER);
+	clockState->state_machine_run(PLUS);
+	clockState->state_machine_run(PLUS);
+	clockState->state_machine_run(MODE);
+	TEST_ASSERT_EQUAL(TIMER_MODE, clockState->getMode());
+	TimeManager::TimeInfo validated = timeM->getRemainingTimerTime();
+	TEST_ASSERT_TRUE(validated.hours != 0 || validated.minutes != 0 || validated.seconds != 0);
+
+	clockState->state_machine_run(LONG_MODE);
+	clockState->handleStates();
+	TEST_ASSERT_EQUAL(SET_TIMER, clockState->getMode());
+	clockState->state_machine_run(PLUS);
+	clockState->state_machine_run(LONG_MODE);
+	clockState->handleStates();
+	TEST_ASSERT_EQUAL(CLOCK_MODE, clockState->getMode());
+
+	clockState->state_machine_run(MODE);
+	clockState->handleStates();
+	TEST_ASSERT_EQUAL(TIMER_MODE, clockState->getMode());
+	TimeManager::TimeInfo timer = timeM->getRemainingTimerTime();
+	TEST_ASSERT_EQUAL(validated.hours, timer.hours);
+	TEST_ASSERT_EQUAL(validated.minutes, timer.minutes);
+	TEST_ASSERT_EQUAL(validated.seconds, timer.seconds);
+}
+
+/**
+ * \brief A timer elapsing while a press is handled does not lose the notification: the time task only posts the
+ *        event and the mode is switched by the main loop after the press
+ */
+void test_timer_done_during_a_press()
+{
+	enterState(TIMER_MODE);
+	clockState->postEvent(EVENT_TIMER_DONE);
+	TEST_ASSERT_EQUAL(TIMER_MODE, clockState->getMode());
+	clockState->state_machine_run(PLAY);
+	TEST_ASSERT_EQUAL(TIMER_MODE, clockState->getMode());
+	clockState->handleStates();
+	TEST_ASSERT_EQUAL(TIMER_NOTIFICATION, clockState->getMode());
+
+	clockState->postEvent(EVENT_ALARM_TRIGGERED);
+	clockState->handleStates();
+	TEST_ASSERT_EQUAL(ALARM_NOTIFICATION, clockState->getMode());
+}
+
+/**
+ * \brief Events posted from several tasks at once to a full queue are all either queued or counted as dropped
+ */
+void test_dropped_events_from_several_tasks()
+{
+	const int Tasks = 4;
+	const int EventsPerTask = 20000;
+	uint32_t dropped = clockState->getDroppedEvents();
+	uint32_t processed = clockState->getProcessedEvents();
+	std::vector<std::thread> tasks;
+	for (int task = 0; task < Tasks; task++)
+	{
+		tasks.emplace_back([]()
+		{
+			for (int i = 0; i < EventsPerTask; i++)
+			{
+				//no flash outside of the notifications, the event costs nothing to process
+				clockState->postEvent(EVENT_NOTIFICATION_FLASH);
+			}
+		});
+	}
+	for (std::thread& task : tasks)
+	{
+		task.join();
+	}
+	clockState->handleStates();
+	uint32_t queued = clockState->getProcessedEvents() - processed;
+	TEST_ASSERT_TRUE(queued > 0);
+	TEST_ASSERT_EQUAL_UINT32(Tasks * EventsPerTask, queued + clockState->getDroppedEvents() - dropped);
+}
+
+/**
+ * \brief In the clock mode the time and both temperatures are sent as one frame on every second tick
+ */
+void test_clock_mode_renders_one_frame()
+{
+	DisplayManager* displays = DisplayManager::getInstance();
+	uint32_t issued = displays->getDisplayUpdatesIssued();
+	clockState->postEvent(EVENT_SECOND_TICK);
+	clockState->handleStates();
+	TEST_ASSERT_EQUAL_UINT32(issued + 8, displays->getDisplayUpdatesIssued());
+
+	//nothing changed since the last frame
+	uint32_t applied = displays->getDisplayUpdatesApplied();
+	clockState->postEvent(EVENT_SENSOR_UPDATE);
+	clockState->handleStates();
+	TEST_ASSERT_EQUAL_UINT32(issued + 16, displays->getDisplayUpdatesIssued());
+	TEST_ASSERT_EQUAL_UINT32(applied, displays->getDisplayUpdatesApplied());
+}
+
+/**
+ * \brief The clock only enters the idle mode after PIR_IDLE_DELAY minutes without motion, a motion resets the wait
+ *        and wakes the clock up
+ */
+void test_idle_after_the_idle_delay()
+{
+	const unsigned long delay = PIR_IDLE_DELAY * 60000ul;
+	clockState->postEvent(EVENT_MOTION);
+	clockState->handleStates();
+	SimClock::advanceMicros((delay - 1000) * 1000ull);
+	clockState->postEvent(EVENT_SECOND_TICK);
+	clockState->handleStates();
+	TEST_ASSERT_FALSE(clockState->isIdle());
+
+	clockState->postEvent(EVENT_MOTION);
+	clockState->handleStates();
+	SimClock::advanceMicros((delay - 1000) * 1000ull);
+	clockState->postEvent(EVENT_SECOND_TICK);
+	clockState->handleStates();
+	TEST_ASSERT_FALSE(clockState->isIdle());
+
+	SimClock::advanceMicros(1000 * 1000ull);
+	clockState->postEvent(EVENT_SECOND_TICK);
+	clockState->handleStates();
+	TEST_ASSERT_TRUE(clockState->isIdle());
+
+	clockState->postEvent(EVENT_MOTION);
+	clockState->handleStates();
+	TEST_ASSERT_FALSE(clockState->isIdle());
+}
+
+/**
+ * \brief Best time of a run of dispatches in ns per call
+ */
+static double dispatchCost(ClockStates state, Transitions_enum transition)
+{
+	double best = 1e9;
+	for (int run = 0; run < BenchmarkRuns; run++)
+	{
+		enterState(state);
+		auto start = std::chrono::steady_clock::now();
+		for (int call = 0; call < BenchmarkCalls; call++)
+		{
+			clockState->state_machine_run(transition);
+		}
+		auto end = std::chrono::steady_clock::now();
+		double cost = std::chrono::duration<double, std::nano>(end - start).count() / BenchmarkCalls;
+		if(cost < best)
+		{
+			best = cost;
+		}
+	}
+	return best;
+}
+
+/**
+ * \brief The clock mode as the 250 ms poll of handleStates did it before the event queue: both sensors are read and
+ *        the temperature, the time, the night mode and the LCD are updated on every poll, changed or not
+ */
+class PollingClock
+{
+public:
+	PollingClock()
+	{
+		_lastUpdate = millis();
+		_lastDotFlash = millis();
+		_isInNightMode = false;
+	}
+
+	void handle()
+	{
+		if(_lastUpdate + PollInterval > millis())
+		{
+			return;
+		}
+		_lastUpdate = millis();
+		DisplayManager* displays = DisplayManager::getInstance();
+		TimeManager* timeM = TimeManager::getInstance();
+		float temperature1 = 0.0;
+		float humidity1 = 0.0;
+		float temperature2 = 0.0;
+		#if AIR_TEMP_SENSOR == true
+			Sensor_AM232X::getInstance()->handle();
+			temperature1 = Sensor_AM232X::getInstance()->getTemperature();
+			humidity1 = Sensor_AM232X::getInstance()->getHumidity();
+		#endif
+		#if WATER_TEMP_SENSOR == true
+			temperature2 = Sensor_DS18B20::getInstance()->getPreciseTempCByAddress(waterThermometerAddress);
+		#endif
+		displays->displayTemperature(temperature1, humidity1, temperature2, 0.0);
+		TimeManager::TimeInfo currentTime = timeM->getCurrentTime();
+		#if USE_NIGHT_MODE == true
+			bool isNight = timeM->isInBetween(TimeManager::TimeInfo {DEFAULT_NIGHT_MODE_START_HOUR, DEFAULT_NIGHT_MODE_START_MINUTE, 0},
+											  TimeManager::TimeInfo {DEFAULT_NIGHT_MODE_END_HOUR, DEFAULT_NIGHT_MODE_END_MINUTE, 0});
+			if(isNight != _isInNightMode)
+			{
+				_isInNightMode = isNight;
+				displays->setGlobalBrightness(isNight ? DEFAULT_NIGHT_MODE_BRIGHTNESS : DEFAULT_CLOCK_BRIGHTNESS);
+			}
+		#endif
+		displays->displayTime(currentTime.hours, currentTime.minutes);
+		#if DISPLAY_FOR_SEPARATION_DOT > -1
+			if(_lastDotFlash + DOT_FLASH_INTERVAL <= millis())
+			{
+				_lastDotFlash = millis();
+				displays->flashSeparationDot(NUM_SEPARATION_DOTS);
+			}
+		#endif
+		#if LCD_SCREEN == true
+			LCDScreen_Clock_Mode(timeM, temperature1, humidity1, temperature2, 0.0);
+		#endif
+	}
+
+private:
+	unsigned long _lastUpdate;
+	unsigned long _lastDotFlash;
+	bool _isInNightMode;
+};
+
+/**
+ * \brief Work of the main loop during one simulated minute in the clock mode
+ */
+struct MinuteCost
+{
+	double   hostMicros;		/** best of the runs, the loop which only advances the clock is subtracted */
+	uint32_t oneWireReads;
+	uint32_t lcdScreens;
+	uint32_t updatesIssued;
+	uint32_t updatesApplied;
+};
+
+/**
+ * \brief Runs the main loop once per ms during one simulated minute in the clock mode. The second ticks are posted
+ *        as the TimeManager does.
+ */
+static MinuteCost minuteCost(bool polling)
+{
+	MinuteCost cost = {1e12, 0, 0, 0, 0};
+	DisplayManager* displays = DisplayManager::getInstance();
+	for (int run = 0; run < BenchmarkRuns; run++)
+	{
+		enterState(CLOCK_MODE);
+		clockState->postEvent(EVENT_MOTION);
+		clockState->handleStates();
+		PollingClock poll;
+		uint32_t oneWireReads = SimBus::oneWireReads;
+		uint32_t lcdScreens = SimBus::lcdScreens;
+		uint32_t issued = displays->getDisplayUpdatesIssued();
+		uint32_t applied = displays->getDisplayUpdatesApplied();
+		auto start = std::chrono::steady_clock::now();
+		for (unsigned long ms = 1; ms <= MinuteMillis; ms++)
+		{
+			SimClock::advanceMicros(1000);
+			if(polling)
+			{
+				poll.handle();
+			}
+			else
+			{
+				if(ms % 1000 == 0)
+				{
+					clockState->postEvent(EVENT_SECOND_TICK);
+				}
+				clockState->handleStates();
+			}
+		}
+		auto end = std::chrono::steady_clock::now();
+		cost.oneWireReads = SimBus::oneWireReads - oneWireReads;
+		cost.lcdScreens = SimBus::lcdScreens - lcdScreens;
+		cost.updatesIssued = displays->getDisplayUpdatesIssued() - issued;
+		cost.updatesApplied = displays->getDisplayUpdatesApplied() - applied;
+
+		auto baseStart = std::chrono::steady_clock::now();
+		for (unsigned long ms = 1; ms <= MinuteMillis; ms++)
+		{
+			SimClock::advanceMicros(1000);
+		}
+		auto baseEnd = std::chrono::steady_clock::now();
+		double micros = std::chrono::duration<double, std::micro>((end - start) - (baseEnd - baseStart)).count();
+		if(micros < cost.hostMicros)
+		{
+			cost.hostMicros = micros;
+		}
+	}
+	return cost;
+}
+
+/**
+ * \brief Work of the clock mode during one minute with the 250 ms poll and with the event queue. The host time
+ *        does not contain the bus transactions, they are counted.
+ */
+void test_cpu_time_per_minute()
+{
+	MinuteCost polling = minuteCost(true);
+	MinuteCost events = minuteCost(false);
+	printf("\n| Clock mode, one minute | host us | 1-Wire reads | LCD screens | display updates issued / applied |\n");
+	printf("|------------------------|---------|--------------|-------------|----------------------------------|\n");
+	printf("| 250 ms poll            | %7.0f | %12u | %11u | %15u / %-15u |\n", polling.hostMicros, polling.oneWireReads,
+		   polling.lcdScreens, polling.updatesIssued, polling.updatesApplied);
+	printf("| event queue            | %7.0f | %12u | %11u | %15u / %-15u |\n", events.hostMicros, events.oneWireReads,
+		   events.lcdScreens, events.updatesIssued, events.updatesApplied);
+	printf("best of %d runs, main loop once per ms\n", BenchmarkRuns);
+	TEST_ASSERT_TRUE(events.oneWireReads < polling.oneWireReads);
+	TEST_ASSERT_TRUE(events.lcdScreens < polling.lcdScreens);
+	TEST_ASSERT_FALSE(clockState->isIdle());
+	TEST_ASSERT_EQUAL(CLOCK_MODE, clockState->getMode());
+}
+
+/**
+ * \brief Cost of the dispatch alone, measured on transitions which stay in their state with the logs below the
+ *        level of the actions, as in the firmware
+ */
+void test_dispatch_cost()
+{
+	double nope = dispatchCost(CLOCK_MODE, PLAY);
+	double increment = dispatchCost(SET_TIMER, PLUS);
+	double startPause = dispatchCost(TIMER_MODE, PLAY);
+	printf("\n| Transition            | Action                   | ns per dispatch |\n");
+	printf("|-----------------------|--------------------------|-----------------|\n");
+	printf("| CLOCK_MODE x PLAY     | NOPE                     | %15.1f |\n", nope);
+	printf("| SET_TIMER x PLUS      | IncrementDigit           | %15.1f |\n", increment);
+	printf("| TIMER_MODE x PLAY     | StartPauseResumeTimer    | %15.1f |\n", startPause);
+	printf("best of %d runs of %d calls\n", BenchmarkRuns, BenchmarkCalls);
+	enterState(TIMER_MODE);
+	clockState->state_machine_run(LONG_PLAY);
+	TEST_ASSERT_EQUAL(TIMER_MODE, clockState->getMode());
+}
+
+int main(int argc, char** argv)
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_every_state_and_transition);
+	RUN_TEST(test_invalid_transition);
+	RUN_TEST(test_cancel_set_timer_keeps_the_timer);
+	RUN_TEST(test_timer_done_during_a_press);
+	RUN_TEST(test_dropped_events_from_several_tasks);
+	RUN_TEST(test_clock_mode_renders_one_frame);
+	RUN_TEST(test_idle_after_the_idle_delay);
+	RUN_TEST(test_dispatch_cost);
+	RUN_TEST(test_cpu_time_per_minute);
+	return UNITY_END();
+}
@@ -0,0 +1,116 @@
+/**
+ * \file test_main.cpp
+ * \author Yves Gaignard
+ * \brief Host tests of the second interrupt of the TimeManager: every counted second is handled by the time task and
+ *        the duration of the interrupt itself
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "TimeManager.h"
+
+//number of the hardware timer used by the TimeManager
+static const uint8_t SecondTimer = 0;
+static const int MeasuredSeconds = 2000;
+static const int BurstSeconds = 5;
+
+static TimeManager* timeM = nullptr;
+
+static uint32_t secondsOfDay(TimeManager::TimeInfo time)
+{
+	return time.hours * 3600UL + time.minutes * 60UL + time.seconds;
+}
+
+/**
+ * \brief Waits until the time task has handled the seconds counted so far
+ */
+static bool waitForTime(uint32_t expected)
+{
+	for (int retry = 0; retry < 100000; retry++)
+	{
+		if(secondsOfDay(timeM->getCurrentTime()) == expected)
+		{
+			return true;
+		}
+		std::this_thread::sleep_for(std::chrono::microseconds(10));
+	}
+	return false;
+}
+
+static double cyclesToNanos(uint32_t cycles)
+{
+	return cycles * 1000.0 / getCpuFrequencyMhz();
+}
+
+void setUp()
+{
+	if(timeM == nullptr)
+	{
+		//started as after a warm restart, the WIFI of the host is never connected so the time advances offline
+		TimeManager::Snapshot snapshot = {};
+		snapshot.currentTime.hours = 10;
+		timeM = TimeManager::getInstance();
+		timeM->resume(snapshot, 0);
+	}
+}
+
+void tearDown() {}
+
+/**
+ * \brief Each interrupt advances the time by one second once the time task ran, its duration is reported in ns
+ */
+void test_every_second_is_handled()
+{
+	std::vector<uint32_t> isrCycles;
+	std::vector<double> callNanos;
+	uint32_t expected = secondsOfDay(timeM->getCurrentTime());
+	for (int second = 0; second < MeasuredSeconds; second++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		simTimerAlarm(SecondTimer);
+		auto end = std::chrono::steady_clock::now();
+		callNanos.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+		isrCycles.push_back(timeM->getLastIsrCycles());
+		expected++;
+		TEST_ASSERT_TRUE(waitForTime(expected));
+	}
+	TEST_ASSERT_EQUAL_UINT32(0, timeM->getLateTicks());
+	TEST_ASSERT_TRUE(timeM->getMaxIsrCycles() >= *std::max_element(isrCycles.begin(), isrCycles.end()));
+
+	std::sort(isrCycles.begin(), isrCycles.end());
+	std::sort(callNanos.begin(), callNanos.end());
+	printf("\n| Second interrupt       | median ns | p99 ns | max ns |\n");
+	printf("|------------------------|-----------|--------|--------|\n");
+	printf("| measured by onTimer    | %9.0f | %6.0f | %6.0f |\n", cyclesToNanos(isrCycles[MeasuredSeconds / 2]),
+		   cyclesToNanos(isrCycles[MeasuredSeconds * 99 / 100]), cyclesToNanos(timeM->getMaxIsrCycles()));
+	printf("| call of the interrupt  | %9.0f | %6.0f | %6.0f |\n", callNanos[MeasuredSeconds / 2],
+		   callNanos[MeasuredSeconds * 99 / 100], callNanos.back());
+	printf("%d seconds at %u MHz\n", MeasuredSeconds, getCpuFrequencyMhz());
+}
+
+/**
+ * \brief Seconds counted while the time task could not run are all handled when it runs again
+ */
+void test_burst_of_seconds_is_not_lost()
+{
+	uint32_t expected = secondsOfDay(timeM->getCurrentTime()) + BurstSeconds;
+	uint32_t late = timeM->getLateTicks();
+	for (int second = 0; second < BurstSeconds; second++)
+	{
+		simTimerAlarm(SecondTimer);
+	}
+	TEST_ASSERT_TRUE(waitForTime(expected));
+	TEST_ASSERT_LESS_OR_EQUAL_UINT32(late + BurstSeconds - 1, timeM->getLateTicks());
+}
+
+int main(int argc, char** argv)
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_every_second_is_handled);
+	RUN_TEST(test_burst_of_seconds_is_not_lost);
+	return UNITY_END();
+}
@@ -0,0 +1,324 @@
+/**
+ * \file test_main.cpp
+ * \author Yves Gaignard
+ * \brief Host tests of the TimerWheel on a virtual clock: the jobs run on their tick, across the levels and across
+ *        the wrap of millis()
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include <stdlib.h>
+#include "TimerWheel.h"
+
+static const uint32_t TickLength = 10;
+//the runs start shortly before millis() wraps
+static const uint32_t StartTime = UINT32_MAX - 100000;
+
+/**
+ * \brief A job and the tick it has to run on, kept next to the wheel as the reference
+ */
+struct TestJob
+{
+	TimerWheel::Job job;
+	uint32_t expected;		/** tick the job is due, only if scheduled */
+	uint32_t period;		/** in ticks */
+	bool     scheduled;
+	uint32_t runs;
+};
+
+static TimerWheel* wheel = nullptr;
+static uint32_t now = 0;
+static uint32_t currentTick = 0;
+static uint32_t lastRunTick = 0;
+static bool     runOutOfOrder = false;
+static bool     runOffTick = false;
+
+static void onJob(void* context)
+{
+	TestJob& test = *static_cast<TestJob*>(context);
+	if(!test.scheduled || test.expected != currentTick)
+	{
+		runOffTick = true;
+	}
+	if((int32_t)(currentTick - lastRunTick) < 0)
+	{
+		runOutOfOrder = true;
+	}
+	lastRunTick = currentTick;
+	test.runs++;
+	if(test.period > 0)
+	{
+		test.expected += test.period;
+	}
+	else
+	{
+		test.scheduled = false;
+	}
+}
+
+static void initJob(TestJob& test)
+{
+	test.job = TimerWheel::Job(onJob, &test);
+	test.scheduled = false;
+	test.runs = 0;
+}
+
+static void scheduleJob(TestJob& test, uint32_t delay, uint32_t period = 0)
+{
+	wheel->schedule(test.job, delay, period);
+	uint32_t ticks = (delay + TickLength - 1) / TickLength;
+	test.expected = currentTick + (ticks > 0 ? ticks : 1);
+	test.period = (period + TickLength - 1) / TickLength;
+	test.scheduled = true;
+}
+
+static void cancelJob(TestJob& test)
+{
+	wheel->cancel(test.job);
+	test.scheduled = false;
+}
+
+/**
+ * \brief Advances the virtual clock one tick at a time, so that the callbacks know the tick they run on
+ */
+static void advanceTicks(uint32_t ticks)
+{
+	for (uint32_t i = 0; i < ticks; i++)
+	{
+		currentTick++;
+		now += TickLength;
+		wheel->advance(now);
+	}
+}
+
+void setUp()
+{
+	now = StartTime;
+	currentTick = 0;
+	lastRunTick = 0;
+	runOutOfOrder = false;
+	runOffTick = false;
+	wheel = new TimerWheel(TickLength, now);
+}
+
+void tearDown()
+{
+	delete wheel;
+	wheel = nullptr;
+}
+
+/**
+ * \brief A delay is rounded up to the next tick, a delay of 0 runs on the next tick
+ */
+void test_one_shot_on_its_tick()
+{
+	TestJob jobs[4];
+	const uint32_t delays[4] = {0, 1, 10, 25};
+	for (int i = 0; i < 4; i++)
+	{
+		initJob(jobs[i]);
+		scheduleJob(jobs[i], delays[i]);
+	}
+	TEST_ASSERT_EQUAL_UINT32(1, jobs[0].expected);
+	TEST_ASSERT_EQUAL_UINT32(1, jobs[1].expected);
+	TEST_ASSERT_EQUAL_UINT32(1, jobs[2].expected);
+	TEST_ASSERT_EQUAL_UINT32(3, jobs[3].expected);
+
+	//a part of a tick does not run anything
+	wheel->advance(now + TickLength - 1);
+	TEST_ASSERT_EQUAL_UINT32(0, jobs[0].runs);
+
+	advanceTicks(10);
+	for (int i = 0; i < 4; i++)
+	{
+		TEST_ASSERT_EQUAL_UINT32(1, jobs[i].runs);
+		TEST_ASSERT_FALSE(jobs[i].job.isScheduled());
+	}
+	TEST_ASSERT_FALSE(runOffTick);
+}
+
+/**
+ * \brief Jobs on every level are cascaded down and run on their tick, the longest delay is 2^24 - 1 ticks
+ */
+void test_levels_and_longest_delay()
+{
+	const uint32_t delays[] = {63 * TickLength, 64 * TickLength, 4095 * TickLength, 4096 * TickLength,
+							   262143 * TickLength, 262144 * TickLength, 16777215 * TickLength};
+	const int count = sizeof(delays) / sizeof(delays[0]);
+	TestJob jobs[count];
+	for (int i = 0; i < count; i++)
+	{
+		initJob(jobs[i]);
+		scheduleJob(jobs[i], delays[i]);
+	}
+	advanceTicks(16777215);
+	for (int i = 0; i < count; i++)
+	{
+		TEST_ASSERT_EQUAL_UINT32(1, jobs[i].runs);
+	}
+	TEST_ASSERT_FALSE(runOffTick);
+	TEST_ASSERT_FALSE(runOutOfOrder);
+}
+
+/**
+ * \brief A periodic job keeps its rhythm from the due tick, also if the wheel is advanced late by many ticks
+ */
+void test_periodic_does_not_drift()
+{
+	TestJob periodic;
+	initJob(periodic);
+	scheduleJob(periodic, 500, 500);
+	advanceTicks(50 * 100);
+	TEST_ASSERT_EQUAL_UINT32(100, periodic.runs);
+
+	//one late call catches up with all the missed runs
+	now += 10 * 500;
+	wheel->advance(now);
+	TEST_ASSERT_EQUAL_UINT32(110, periodic.runs);
+	currentTick += 10 * 50;
+	TEST_ASSERT_EQUAL_UINT32(currentTick + 50, periodic.expected);
+	TEST_ASSERT_EQUAL_UINT32(500, wheel->getNextDeadline(now));
+}
+
+static TestJob* chained = nullptr;
+static TestJob* victim = nullptr;
+
+/**
+ * \brief Reschedules itself with a growing delay and cancels the victim due on the same tick
+ */
+static void onChained(void* context)
+{
+	onJob(context);
+	if(victim != nullptr && victim->scheduled)
+	{
+		cancelJob(*victim);
+	}
+	if(chained->runs < 5)
+	{
+		scheduleJob(*chained, chained->runs * 1000);
+	}
+}
+
+/**
+ * \brief A callback can reschedule its own job and cancel a job due on the same tick
+ */
+void test_callback_reschedules_and_cancels()
+{
+	TestJob self;
+	TestJob other;
+	initJob(self);
+	initJob(other);
+	self.job.callback = onChained;
+	chained = &self;
+	victim = &other;
+	//the job scheduled last is run first in its slot
+	scheduleJob(other, 100);
+	scheduleJob(self, 100);
+	advanceTicks(2000);
+	TEST_ASSERT_EQUAL_UINT32(5, self.runs);
+	TEST_ASSERT_EQUAL_UINT32(0, other.runs);
+	TEST_ASSERT_FALSE(other.job.isScheduled());
+	TEST_ASSERT_FALSE(runOffTick);
+	chained = nullptr;
+	victim = nullptr;
+}
+
+/**
+ * \brief Random schedules, reschedules and cancels of one-shot and periodic jobs against the reference, the next
+ *        deadline is never after the earliest due job
+ */
+void test_random_against_reference()
+{
+	static const int JobCount = 48;
+	static TestJob jobs[JobCount];
+	srand(46);
+	for (int i = 0; i < JobCount; i++)
+	{
+		initJob(jobs[i]);
+	}
+	TEST_ASSERT_EQUAL_UINT32(TimerWheel::NoDeadline, wheel->getNextDeadline(now));
+
+	for (int step = 0; step < 20000; step++)
+	{
+		TestJob& test = jobs[rand() % JobCount];
+		int operation = rand() % 8;
+		if(operation == 0)
+		{
+			cancelJob(test);
+		}
+		else
+		{
+			//mostly short delays, some for each of the higher levels
+			static const uint32_t Ranges[] = {1000, 1000, 60000, 3600000, 8 * 3600000};
+			uint32_t delay = rand() % Ranges[rand() % 5];
+			uint32_t period = operation == 1 ? 10 + rand() % 60000 : 0;
+			scheduleJob(test, delay, period);
+		}
+
+		uint32_t earliest = UINT32_MAX;
+		for (int i = 0; i < JobCount; i++)
+		{
+			TEST_ASSERT_EQUAL(jobs[i].scheduled, jobs[i].job.isScheduled());
+			if(jobs[i].scheduled && jobs[i].expected - currentTick < earliest)
+			{
+				earliest = jobs[i].expected - currentTick;
+			}
+		}
+		uint32_t deadline = wheel->getNextDeadline(now);
+		if(earliest == UINT32_MAX)
+		{
+			TEST_ASSERT_EQUAL_UINT32(TimerWheel::NoDeadline, deadline);
+		}
+		else
+		{
+			TEST_ASSERT_LESS_OR_EQUAL_UINT32(earliest * TickLength, deadline);
+		}
+
+		advanceTicks(rand() % 200);
+		TEST_ASSERT_FALSE(runOffTick);
+		TEST_ASSERT_FALSE(runOutOfOrder);
+		for (int i = 0; i < JobCount; i++)
+		{
+			//a job due on a past tick was missed
+			TEST_ASSERT_TRUE(!jobs[i].scheduled || jobs[i].expected - currentTick - 1 < UINT32_MAX / 2);
+		}
+	}
+	TEST_ASSERT_TRUE((int32_t)(now - StartTime) > 100000);
+}
+
+/**
+ * \brief Sleeping until the next deadline and advancing then, as the idle main loop does, runs the job on time
+ */
+void test_sleep_until_deadline()
+{
+	TestJob test;
+	initJob(test);
+	scheduleJob(test, 3 * 3600000UL);
+	uint32_t wakeUps = 0;
+	while (test.runs == 0)
+	{
+		uint32_t deadline = wheel->getNextDeadline(now);
+		TEST_ASSERT_NOT_EQUAL(TimerWheel::NoDeadline, deadline);
+		TEST_ASSERT_TRUE(deadline > 0);
+		//the wake up is rounded to whole ticks here, the wheel does not need it
+		uint32_t ticks = (deadline + TickLength - 1) / TickLength;
+		advanceTicks(ticks);
+		wakeUps++;
+	}
+	TEST_ASSERT_EQUAL_UINT32(3 * 360000UL, currentTick);
+	//one wake up per cascade and the last one on the due tick
+	TEST_ASSERT_LESS_OR_EQUAL_UINT32(4 * 64, wakeUps);
+	TEST_ASSERT_FALSE(runOffTick);
+}
+
+int main(int argc, char** argv)
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_one_shot_on_its_tick);
+	RUN_TEST(test_levels_and_longest_delay);
+	RUN_TEST(test_periodic_does_not_drift);
+	RUN_TEST(test_callback_reschedules_and_cancels);
+	RUN_TEST(test_random_against_reference);
+	RUN_TEST(test_sleep_until_deadline);
+	return UNITY_END();
+}
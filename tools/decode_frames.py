@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+"""
+Decodes the LED frames recorded by the PoolClock frame recorder.
+
+Download the recording from http://<clock ip>:<OTA_UPDATE_PORT>/frames.bin, then
+    decode_frames.py frames.bin                   # one line per frame: time, brightness, changed LEDs
+    decode_frames.py frames.bin --dump            # every frame as hex RGB values, one LED after the other
+    decode_frames.py frames.bin --gif frames.gif  # animated image, needs Pillow (pip install pillow)
+
+The file format is described in lib/PoolClock/Modules/DisplayManager/inc/FrameRecorder.h
+"""
+
+import argparse
+import struct
+import sys
+
+FILE_VERSION = 1
+
+
+def decode(data):
+    """Returns the list of frames as (time in ms, brightness, [(r, g, b), ...], changed LEDs)"""
+    if data[0:4] != b"PCFR":
+        raise ValueError("not a frame recording")
+    version, _, num_leds = struct.unpack_from("<BBH", data, 4)
+    if version != FILE_VERSION:
+        raise ValueError("unsupported file version %d" % version)
+    time, brightness = struct.unpack_from("<IB", data, 8)
+    offset = 13
+    frame = [tuple(data[offset + 3 * i:offset + 3 * i + 3]) for i in range(num_leds)]
+    offset += 3 * num_leds
+    frames = [(time, brightness, list(frame), num_leds)]
+
+    while offset < len(data):
+        elapsed, brightness, length = struct.unpack_from("<HBH", data, offset)
+        offset += 5
+        end = offset + length
+        led = 0
+        changed = 0
+        while offset < end:
+            token = data[offset]
+            offset += 1
+            run = (token & 0x7F) + 1
+            if token & 0x80:
+                for i in range(run):
+                    frame[led + i] = tuple(data[offset:offset + 3])
+                    offset += 3
+                changed += run
+            led += run
+        time += elapsed
+        frames.append((time, brightness, list(frame), changed))
+    return frames
+
+
+def write_gif(frames, path, width, scale):
+    from PIL import Image
+
+    num_leds = len(frames[0][2])
+    rows = (num_leds + width - 1) // width
+    images = []
+    durations = []
+    for index, (time, brightness, leds, _) in enumerate(frames):
+        image = Image.new("RGB", (width, rows))
+        # FastLED scales every color with the brightness when the frame is sent
+        image.putdata([tuple(c * brightness // 255 for c in led) for led in leds] + [(0, 0, 0)] * (width * rows - num_leds))
+        images.append(image.resize((width * scale, rows * scale), Image.NEAREST))
+        next_time = frames[index + 1][0] if index + 1 < len(frames) else time + 1000
+        durations.append(max(next_time - time, 20))
+    images[0].save(path, save_all=True, append_images=images[1:], duration=durations, loop=0)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decodes the LED frames recorded by the PoolClock frame recorder")
+    parser.add_argument("file", help="recording downloaded from /frames.bin")
+    parser.add_argument("--dump", action="store_true", help="print every frame as hex RGB values")
+    parser.add_argument("--gif", metavar="OUTPUT", help="write the frames as an animated GIF")
+    parser.add_argument("--width", type=int, default=28, help="LEDs per row in the GIF (default: 28)")
+    parser.add_argument("--scale", type=int, default=8, help="pixels per LED in the GIF (default: 8)")
+    args = parser.parse_args()
+
+    with open(args.file, "rb") as f:
+        frames = decode(f.read())
+
+    if args.gif:
+        write_gif(frames, args.gif, args.width, args.scale)
+        print("%d frames written to %s" % (len(frames), args.gif))
+        return
+
+    start = frames[0][0]
+    for time, brightness, leds, changed in frames:
+        if args.dump:
+            print("%10d %3d %s" % (time, brightness, " ".join("%02x%02x%02x" % led for led in leds)))
+        else:
+            print("%10d ms (+%7d ms) brightness %3d, %3d LEDs changed" % (time, time - start, brightness, changed))
+
+
+if __name__ == "__main__":
+    sys.exit(main())
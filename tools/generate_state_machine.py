@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+"""
+Generates the transition table of the ClockState state machine from the design in Doc/StateMachine.xlsx.
+
+Export the sheet as CSV (Doc/StateMachine.csv, comma separated), then
+    generate_state_machine.py                         # writes lib/PoolClock/Modules/ClockState/inc/StateMachineTable.h
+    generate_state_machine.py --check                 # fails if the generated header is not up to date
+
+Every cell of the sheet reads "<next state> / <action>". The script refuses to generate a table with a missing
+cell, an unknown action or next state, so every state/transition pair of the firmware is covered by the design.
+"""
+
+import argparse
+import csv
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+CSV_FILE = os.path.join(ROOT, "Doc", "StateMachine.csv")
+HEADER_FILE = os.path.join(ROOT, "lib", "PoolClock", "Modules", "ClockState", "inc", "StateMachineTable.h")
+
+# states of the sheet in the order of the ClockStates enum in ClockState.h
+STATES = ["CLOCK_MODE", "TIMER_MODE", "SET_TIMER", "TIMER_NOTIFICATION", "ALARM_NOTIFICATION"]
+
+# columns of the sheet mapped on the Transitions_enum in ClockState.h, NONE is not a button and never changes anything
+TRANSITIONS = ["NONE", "MODE", "LONG_MODE", "PLAY", "LONG_PLAY", "PLUS", "LONG_PLUS", "MINUS", "LONG_MINUS"]
+COLUMNS = {"Mode": "MODE", "Long Mode": "LONG_MODE", "Play": "PLAY", "Long Play": "LONG_PLAY",
+           "Plus": "PLUS", "Long Plus": "LONG_PLUS", "Minus": "MINUS", "Long Minus": "LONG_MINUS"}
+
+# abbreviations of the "Outputs" legend mapped on the action routines of ClockState
+ACTIONS = {"NOP": "NOPE", "CMTR": "ChgModeToTimer", "CMSTR": "ChgModeToSetTimer", "CMTI": "ChgModeToClock",
+           "SPR": "StartPauseResumeTimer", "CTR": "CancelTimer", "CSTR": "CancelSetTimer",
+           "VSTR": "ValidateSetTimer", "MNDG": "MoveNextDigit", "INCDG": "IncrementDigit",
+           "INCQDG": "IncrementQuicklyDigit", "DECDG": "DecrementDigit", "DECQDG": "DecrementQuicklyDigit",
+           "DNTF": "DismissNotification"}
+
+
+def parse(path):
+    """Returns the table as {state index: {transition: (action, next state index)}} and the legend"""
+    with open(path, newline="", encoding="utf-8-sig") as f:
+        rows = list(csv.reader(f))
+
+    header = next((row for row in rows if len(row) > 1 and row[1].strip() == "Mode"), None)
+    if header is None:
+        raise ValueError("no header row with the button names found")
+    columns = {}
+    for index, name in enumerate(header):
+        if name.strip() in COLUMNS:
+            columns[index] = COLUMNS[name.strip()]
+    if sorted(columns.values()) != sorted(COLUMNS.values()):
+        raise ValueError("the header does not list all the buttons: %s" % header)
+
+    table = {}
+    legend = {}
+    for line, row in enumerate(rows, 1):
+        outputs = row[-1].strip() if len(row) > 9 else ""
+        match = re.match(r"^(\w+)\s*:\s*(.+)$", outputs)
+        if match:
+            legend[match.group(1)] = match.group(2).strip()
+        match = re.match(r"^(\d+)\s*:", row[0].strip()) if row else None
+        if not match:
+            continue
+        state = int(match.group(1))
+        if state >= len(STATES) or state in table:
+            raise ValueError("line %d: unknown or duplicated state %s" % (line, row[0]))
+        table[state] = {}
+        for index, transition in columns.items():
+            cell = row[index].strip() if index < len(row) else ""
+            match = re.match(r"^(\d+)\s*/\s*(\w+)$", cell)
+            if not match:
+                raise ValueError("line %d: cell '%s' of %s is not '<next state> / <action>'" % (line, cell, transition))
+            table[state][transition] = (match.group(2), int(match.group(1)))
+    return table, legend
+
+
+def check(table, legend):
+    """Exhaustive check of all state/transition pairs against the firmware enums and actions"""
+    for state in range(len(STATES)):
+        if state not in table:
+            raise ValueError("state %d (%s) is missing in the sheet" % (state, STATES[state]))
+        for transition in TRANSITIONS[1:]:
+            action, next_state = table[state][transition]
+            if action not in ACTIONS:
+                raise ValueError("%s/%s: unknown action %s" % (STATES[state], transition, action))
+            if action not in legend:
+                raise ValueError("%s/%s: action %s is not described in the outputs" % (STATES[state], transition, action))
+            if next_state >= len(STATES):
+                raise ValueError("%s/%s: unknown next state %d" % (STATES[state], transition, next_state))
+
+
+def generate(table, legend):
+    lines = ["/**",
+             " * \\file StateMachineTable.h",
+             " * \\author Yves Gaignard",
+             " * \\brief Transition table of the ClockState state machine",
+             " *",
+             " * GENERATED by tools/generate_state_machine.py from Doc/StateMachine.csv, do not edit.",
+             " * Only included by ClockState.cpp.",
+             " */",
+             "",
+             "#ifndef __STATE_MACHINE_TABLE_H_",
+             "#define __STATE_MACHINE_TABLE_H_",
+             "",
+             "static_assert(ClockState::STATE_COUNT == %d, \"StateMachineTable.h: regenerate the table, ClockStates changed\");" % len(STATES),
+             "static_assert(ClockState::TRANSITION_COUNT == %d, \"StateMachineTable.h: regenerate the table, Transitions_enum changed\");" % len(TRANSITIONS),
+             "",
+             "constexpr ClockState::StateMachineEntry ClockState::_stateMachine[ClockState::STATE_COUNT][ClockState::TRANSITION_COUNT] =",
+             "{"]
+    for state in range(len(STATES)):
+        lines.append("\t// %s" % STATES[state])
+        lines.append("\t{")
+        entries = [("NONE", "NOPE", STATES[state], "")]
+        for transition in TRANSITIONS[1:]:
+            action, next_state = table[state][transition]
+            entries.append((transition, ACTIONS[action], STATES[next_state], legend[action]))
+        for transition, action, next_state, description in entries:
+            comment = "%-10s %s" % (transition, description) if description else transition
+            lines.append("\t\t{%-36s %-18s}, // %s" % ("&ClockState::%s," % action, next_state, comment.rstrip()))
+        lines.append("\t},")
+    lines += ["};", "", "#endif", ""]
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("csv", nargs="?", default=CSV_FILE, help="CSV export of Doc/StateMachine.xlsx")
+    parser.add_argument("--output", default=HEADER_FILE, help="generated header")
+    parser.add_argument("--check", action="store_true", help="only check that the header is up to date")
+    args = parser.parse_args()
+
+    try:
+        table, legend = parse(args.csv)
+        check(table, legend)
+    except ValueError as error:
+        sys.exit("%s: %s" % (args.csv, error))
+    header = generate(table, legend)
+
+    if args.check:
+        with open(args.output, encoding="utf-8") as f:
+            if f.read() != header:
+                sys.exit("%s is out of date, run %s" % (args.output, os.path.basename(__file__)))
+        return
+    with open(args.output, "w", encoding="utf-8") as f:
+        f.write(header)
+
+
+if __name__ == "__main__":
+    main()